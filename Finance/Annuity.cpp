@@ -27,29 +27,54 @@ namespace Finance
     sEnd_(sEnd), 
     eBasis_(eBasis), 
     eFrequency_(eFrequency),
-    sYieldCurve_(sYieldCurve)
+    sYieldCurve_(sYieldCurve),
+    pDiscountCurve_(0)
+    
+    {}
+    
+    Annuity::Annuity(const Utilities::Date::MyDate &    sStart,
+                     const Utilities::Date::MyDate &    sEnd,
+                     MyBasis                            eBasis,
+                     MyFrequency                        eFrequency,
+                     const DiscountCurve           &    sDiscountCurve): 
+    
+    sStart_(sStart), 
+    sEnd_(sEnd), 
+    eBasis_(eBasis), 
+    eFrequency_(eFrequency),
+    pDiscountCurve_(&sDiscountCurve)
     
     {}
     
     double Annuity::ComputeAnnuity() const
     {
+        if (pDiscountCurve_ != 0)
+        {
+            return ComputeLevel(*pDiscountCurve_);
+        }
         DF sDF(sYieldCurve_);
+        return ComputeLevel(sDF);
+    }
+    
+    template<class Curve>
+    double Annuity::ComputeLevel(const Curve & sCurve) const
+    {
         //  Get the schedule
-        Schedule sSchedule(sStart_, sEnd_, sYieldCurve_, eBasis_, eFrequency_);
+        Schedule sSchedule(sStart_, sEnd_, sCurve, eBasis_, eFrequency_);
         
         //  Definition of annuity : 
         //  Level = \sum_{i} (\tau(T_i, T_{i+1}) * DF(t,T_{i+1}))
         //  where \tau(T_i, T_{i+1}) is the coverage (year fraction) between T_i, T_{i+1} and DF is the discount factor function.
         
         double dLevel = 0;
-        std::vector<EventOfSchedule> sVectEventOfSchedule = sSchedule.GetSchedule();
+        const std::vector<EventOfSchedule> & sVectEventOfSchedule = sSchedule.GetSchedule();
         for (std::size_t iDate = 0 ; iDate < sVectEventOfSchedule.size() ; ++iDate)
         {
             dLevel += sVectEventOfSchedule[iDate].GetCoverage() * sVectEventOfSchedule[iDate].GetPayingDateDF();
         }
         //  add last date
         Coverage sCoverage(eBasis_, sVectEventOfSchedule.back().GetEndDate(), sEnd_);
-        dLevel += sCoverage.ComputeCoverage() * sDF.DiscountFactor(sEnd_);
+        dLevel += sCoverage.ComputeCoverage() * sCurve.DiscountFactor(sEnd_);
         
         return dLevel;
     }
@@ -12,6 +12,7 @@
 #include "Date.h"
 #include "Basis.h"
 #include "YieldCurve.h"
+#include "DiscountCurve.h"
 #include "Frequency.h"
 
 namespace Finance {
@@ -24,6 +25,12 @@ namespace Finance {
                 MyBasis                             eBasis,
                 MyFrequency                         eFrequency,
                 const YieldCurve &                  sYieldCurve);
+        //  Annuity discounted on a shared precompiled curve (which has to outlive the annuity)
+        Annuity(const Utilities::Date::MyDate &     sStart,
+                const Utilities::Date::MyDate &     sEnd,
+                MyBasis                             eBasis,
+                MyFrequency                         eFrequency,
+                const DiscountCurve &               sDiscountCurve);
         virtual ~Annuity();
         
         virtual double ComputeAnnuity() const;
@@ -33,6 +40,12 @@ namespace Finance {
         MyBasis eBasis_;
         MyFrequency eFrequency_;
         YieldCurve sYieldCurve_;
+        //  Shared discount curve (0 : the annuity is discounted on sYieldCurve_)
+        const DiscountCurve * pDiscountCurve_;
+        
+        //  Level of the annuity discounted on sCurve (DF or DiscountCurve)
+        template<class Curve>
+        double ComputeLevel(const Curve & sCurve) const;
         
     };
 }
@@ -0,0 +1,106 @@
+//
+//  DiscountCurve.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include "DiscountCurve.h"
+#include "Require.h"
+
+namespace Finance {
+
+    DiscountCurve::DiscountCurve(const YieldCurve & sYieldCurve, const Utilities::Date::MyDate & sValuationDate, double dHorizon, double dStep) : sYieldCurve_(sYieldCurve), sValuationDate_(sValuationDate), dStep_(dStep)
+    {
+        Initialize(sYieldCurve, dHorizon);
+    }
+
+    DiscountCurve::DiscountCurve(const YieldCurve & sYieldCurve, double dHorizon, double dStep) : sYieldCurve_(sYieldCurve), dStep_(dStep)
+    {
+        Initialize(sYieldCurve, dHorizon);
+    }
+
+    DiscountCurve::~DiscountCurve()
+    {}
+
+    void DiscountCurve::Initialize(const YieldCurve & sYieldCurve, double dHorizon)
+    {
+        Utilities::require(dStep_ > 0.0, "DiscountCurve : the step of the table has to be positive");
+        Utilities::require(!sYieldCurve.GetVariables().empty(), "DiscountCurve : empty yield curve");
+        dInverseStep_ = 1.0 / dStep_;
+        dShortRate_ = sYieldCurve.YC(0.0);
+
+        dPillars_ = sYieldCurve.GetVariables();
+        dPillarLogDiscountFactors_.resize(dPillars_.size());
+        for (std::size_t iPillar = 0 ; iPillar < dPillars_.size() ; ++iPillar)
+        {
+            dPillarLogDiscountFactors_[iPillar] = -dPillars_[iPillar] * sYieldCurve.YC(dPillars_[iPillar]);
+        }
+
+        //  Nodes 0, dStep, ..., iNIntervals * dStep covering the horizon, with one batched interpolation of the yield curve
+        dHorizon = std::max(dHorizon, dPillars_.back());
+        std::size_t iNIntervals = static_cast<std::size_t>(std::max(std::ceil(dHorizon * dInverseStep_ - 1e-9), 1.0));
+        std::vector<double> dTimes(iNIntervals + 1);
+        dLogDiscountFactors_.resize(iNIntervals + 1);
+        for (std::size_t i = 0 ; i <= iNIntervals ; ++i)
+        {
+            dTimes[i] = i * dStep_;
+        }
+        sYieldCurve.YC(Utilities::ArrayView<const double>(&dTimes[0], dTimes.size()), Utilities::ArrayView<double>(&dLogDiscountFactors_[0], dLogDiscountFactors_.size()));
+        dLogDiscountFactorSteps_.resize(iNIntervals);
+        for (std::size_t i = 0 ; i <= iNIntervals ; ++i)
+        {
+            dLogDiscountFactors_[i] *= -dTimes[i];
+        }
+        for (std::size_t i = 0 ; i < iNIntervals ; ++i)
+        {
+            dLogDiscountFactorSteps_[i] = dLogDiscountFactors_[i + 1] - dLogDiscountFactors_[i];
+        }
+        dLastInterval_ = static_cast<double>(iNIntervals - 1);
+    }
+
+    double DiscountCurve::DiscountFactor(double dT) const
+    {
+        return exp(LogDiscountFactor(dT));
+    }
+
+    double DiscountCurve::DiscountFactor(const Utilities::Date::MyDate & sDate) const
+    {
+        double dT = GetTime(sDate);
+        Utilities::require(dT >= 0.0, "DiscountCurve : date before the valuation date");
+        return DiscountFactor(dT);
+    }
+
+    void DiscountCurve::DiscountFactor(Utilities::ArrayView<const double> dT, Utilities::ArrayView<double> dResults) const
+    {
+        Utilities::require(dT.size() == dResults.size(), "DiscountCurve : input and output sizes are not the same");
+        for (std::size_t i = 0 ; i < dT.size() ; ++i)
+        {
+            dResults[i] = exp(LogDiscountFactor(dT[i]));
+        }
+    }
+
+    double DiscountCurve::ZeroRate(double dT) const
+    {
+        return dT < 1e-03 ? dShortRate_ : -LogDiscountFactor(dT) / dT;
+    }
+
+    double DiscountCurve::ForwardRate(double dStart, double dEnd) const
+    {
+        Utilities::require(dStart < dEnd, "Start is after End in DiscountCurve::ForwardRate");
+        return (exp(LogDiscountFactor(dStart) - LogDiscountFactor(dEnd)) - 1.0) / (dEnd - dStart);
+    }
+
+    double DiscountCurve::InstantaneousForwardRate(double dT) const
+    {
+        std::size_t i = static_cast<std::size_t>(std::min(std::max(dT * dInverseStep_, 0.0), dLastInterval_));
+        return -dLogDiscountFactorSteps_[i] * dInverseStep_;
+    }
+
+    double DiscountCurve::GetTime(const Utilities::Date::MyDate & sDate) const
+    {
+        return sDate.Diff(sValuationDate_);
+    }
+}
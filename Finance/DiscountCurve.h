@@ -0,0 +1,104 @@
+//
+//  DiscountCurve.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_DiscountCurve_h
+#define Seminaire_DiscountCurve_h
+
+#include <vector>
+#include <algorithm>
+#include "YieldCurve.h"
+#include "Date.h"
+#include "ArrayView.h"
+
+//  Default step of the table of the discount curves : one day in the 30/360 convention of MyDate::Diff, so that the discount factors of
+//  dates are read on the nodes of the table
+#define DISCOUNTCURVESTEP (1.0 / 360.0)
+
+namespace Finance {
+
+    //  Immutable discount curve precompiled from a yield curve at a fixed valuation date
+    //  The log-discount factors - t * YC(t) are cached on the pillars of the yield curve and on a uniform grid of step dStep : a query reads
+    //  the two nodes around t (log-linear interpolation, flat forward rate between two nodes) with no search and no branch, and dates are
+    //  converted to times with the valuation date (no call to the system clock)
+    //  One curve is meant to be shared by all the products discounted on it (Annuity, SwapMonoCurve, Weights, Schedule)
+    class DiscountCurve
+    {
+    public:
+        //  The table covers [0, dHorizon] (at least up to the last pillar) : the last forward rate is extrapolated after it
+        DiscountCurve(const YieldCurve & sYieldCurve, const Utilities::Date::MyDate & sValuationDate, double dHorizon = 0.0, double dStep = DISCOUNTCURVESTEP);
+        //  Valuation date : today
+        explicit DiscountCurve(const YieldCurve & sYieldCurve, double dHorizon = 0.0, double dStep = DISCOUNTCURVESTEP);
+        virtual ~DiscountCurve();
+
+        double LogDiscountFactor(double dT) const
+        {
+            //  Node below dT, clamped to the table (minsd / maxsd, no branch)
+            double dPosition = std::min(std::max(dT * dInverseStep_, 0.0), dLastInterval_);
+            std::size_t i = static_cast<std::size_t>(dPosition);
+            return dLogDiscountFactors_[i] + dLogDiscountFactorSteps_[i] * (dT * dInverseStep_ - i);
+        }
+
+        double DiscountFactor(double dT) const;
+        double DiscountFactor(const Utilities::Date::MyDate & sDate) const;
+        //  dResults[i] = DiscountFactor(dT[i]) (dResults may be dT)
+        void DiscountFactor(Utilities::ArrayView<const double> dT, Utilities::ArrayView<double> dResults) const;
+
+        //  Continuously compounded zero-coupon rate : YieldCurve::YC
+        double ZeroRate(double dT) const;
+        //  Forward rate of the period [dStart, dEnd] : ForwardRate::FwdRate
+        double ForwardRate(double dStart, double dEnd) const;
+        //  Instantaneous forward rate - d log DF(t) / dt (constant between two nodes)
+        double InstantaneousForwardRate(double dT) const;
+
+        //  Year fraction between the valuation date and sDate (MyDate::Diff)
+        double GetTime(const Utilities::Date::MyDate & sDate) const;
+
+        const Utilities::Date::MyDate & GetValuationDate() const
+        {
+            return sValuationDate_;
+        }
+
+        double GetHorizon() const
+        {
+            return (dLastInterval_ + 1.0) * dStep_;
+        }
+
+        //  Yield curve the table was built from
+        const YieldCurve & GetYieldCurve() const
+        {
+            return sYieldCurve_;
+        }
+
+        const std::vector<double> & GetPillars() const
+        {
+            return dPillars_;
+        }
+
+        const std::vector<double> & GetPillarLogDiscountFactors() const
+        {
+            return dPillarLogDiscountFactors_;
+        }
+
+    private:
+        YieldCurve sYieldCurve_;
+        Utilities::Date::MyDate sValuationDate_;
+        double dStep_, dInverseStep_;
+        //  Index of the last interval of the table (as a double for the clamp)
+        double dLastInterval_;
+        //  Rate of the yield curve at 0 (YieldCurve::YC below 1e-3)
+        double dShortRate_;
+
+        std::vector<double> dPillars_, dPillarLogDiscountFactors_;
+        //  dLogDiscountFactors_[i] = - t_i * YC(t_i) with t_i = i * dStep_, and dLogDiscountFactorSteps_[i] = dLogDiscountFactors_[i + 1] - dLogDiscountFactors_[i]
+        std::vector<double> dLogDiscountFactors_, dLogDiscountFactorSteps_;
+
+        void Initialize(const YieldCurve & sYieldCurve, double dHorizon);
+    };
+}
+
+#endif
@@ -25,6 +25,15 @@ namespace Finance {
 		return exp(-dT * YC(dT));
 	}
     
+    void DF::DiscountFactor(Utilities::ArrayView<const double> dDates, Utilities::ArrayView<double> dResults) const
+    {
+        YC(dDates, dResults);
+        for (std::size_t i = 0 ; i < dDates.size() ; ++i)
+        {
+            dResults[i] = exp(-dDates[i] * dResults[i]);
+        }
+    }
+    
     double DF::DiscountFactor(const Utilities::Date::MyDate &sDate) const
     {
         Utilities::Date::MyDate sToday;
@@ -21,6 +21,8 @@ namespace Finance {
 		DF(const YieldCurve & sInitialYieldCurve);
 		virtual ~DF();
 		virtual double DiscountFactor(double dDate) const;
+        //  Discount factors of a whole schedule or simulation grid : dResults[i] = DiscountFactor(dDates[i]) (dResults must not be dDates)
+        virtual void DiscountFactor(Utilities::ArrayView<const double> dDates, Utilities::ArrayView<double> dResults) const;
         virtual double DiscountFactor(const Utilities::Date::MyDate & sDate) const;
 	private:	
 	};
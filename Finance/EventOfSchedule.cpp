@@ -28,13 +28,23 @@ namespace Finance {
         dPayingDateDF_ = sDiscountFactor.DiscountFactor(sEnd);
     }
     
-    EventOfSchedule::~EventOfSchedule()
+    EventOfSchedule::EventOfSchedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const DiscountCurve & sDiscountCurve, MyBasis eBasis) : 
+    
+    sStart_(sStart),
+    sEnd_(sEnd),
+    eBasis_(eBasis)
+    
     {
-        sYieldCurve_.~YieldCurve();
-        sStart_.~MyDate();
-        sEnd_.~MyDate();
+        Coverage sCoverage(eBasis_,  sStart_, sEnd);
+        dCoverage_ = sCoverage.ComputeCoverage();
+        
+        //  Assuming that the end date is the pay date
+        dPayingDateDF_ = sDiscountCurve.DiscountFactor(sEnd);
     }
     
+    EventOfSchedule::~EventOfSchedule()
+    {}
+    
     double EventOfSchedule::GetCoverage() const
     {
         return dCoverage_;
@@ -12,6 +12,7 @@
 #include "Date.h"
 #include "Basis.h"
 #include "YieldCurve.h"
+#include "DiscountCurve.h"
 
 namespace Finance
 {
@@ -26,11 +27,11 @@ namespace Finance
         
         MyBasis eBasis_;
         
-        YieldCurve sYieldCurve_;
-        
     public:
         
         EventOfSchedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const YieldCurve & sYieldCurve, MyBasis eBasis);
+        //  The paying date discount factor is read on a precompiled discount curve
+        EventOfSchedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const DiscountCurve & sDiscountCurve, MyBasis eBasis);
         virtual ~EventOfSchedule();
         
         virtual double GetCoverage() const;
@@ -0,0 +1,175 @@
+//
+//  PiecewiseConstantTermStructure.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <algorithm>
+#include "PiecewiseConstantTermStructure.h"
+#include "Require.h"
+
+namespace Finance {
+
+    PiecewiseConstantTermStructure::PiecewiseConstantTermStructure()
+    {
+        Initialize(std::vector<double>(1, 0.0), std::vector<double>(1, 0.0));
+    }
+
+    PiecewiseConstantTermStructure::PiecewiseConstantTermStructure(const std::vector<double> & dVariables, const std::vector<double> & dValues)
+    {
+        Initialize(dVariables, dValues);
+    }
+
+    PiecewiseConstantTermStructure::PiecewiseConstantTermStructure(const TermStructure<double, double> & sTermStructure)
+    {
+        Initialize(sTermStructure.GetVariables(), sTermStructure.GetValues());
+    }
+
+    PiecewiseConstantTermStructure::~PiecewiseConstantTermStructure()
+    {}
+
+    void PiecewiseConstantTermStructure::Initialize(const std::vector<double> & dVariables, const std::vector<double> & dValues)
+    {
+        Utilities::require(!dVariables.empty(), "PiecewiseConstantTermStructure : empty term structure");
+        Utilities::require(dVariables.size() == dValues.size(), "Size of variables and values are not the same");
+
+        //  Equal pillars are collapsed on the last of their values (the value of the interval starting there)
+        dVariables_.clear();
+        dValues_.clear();
+        dVariables_.reserve(dVariables.size());
+        dValues_.reserve(dValues.size());
+        for (std::size_t i = 0 ; i < dVariables.size() ; ++i)
+        {
+            Utilities::require(i == 0 || dVariables[i] >= dVariables[i - 1], "PiecewiseConstantTermStructure : pillars are not sorted");
+            if (i > 0 && dVariables[i] == dVariables_.back())
+            {
+                dValues_.back() = dValues[i];
+            }
+            else
+            {
+                dVariables_.push_back(dVariables[i]);
+                dValues_.push_back(dValues[i]);
+            }
+        }
+
+        std::size_t iNVariables = dVariables_.size();
+        dIntegrals_.assign(iNVariables, 0.0);
+        dSquaredIntegrals_.assign(iNVariables, 0.0);
+        for (std::size_t i = 1 ; i < iNVariables ; ++i)
+        {
+            double dLength = dVariables_[i] - dVariables_[i - 1], dValue = dValues_[i - 1];
+            dIntegrals_[i] = dIntegrals_[i - 1] + dValue * dLength;
+            dSquaredIntegrals_[i] = dSquaredIntegrals_[i - 1] + dValue * dValue * dLength;
+        }
+    }
+
+    std::size_t PiecewiseConstantTermStructure::Locate(double dT) const
+    {
+        std::size_t i = std::upper_bound(dVariables_.begin(), dVariables_.end(), dT) - dVariables_.begin();
+        return i > 0 ? i - 1 : 0;
+    }
+
+    double PiecewiseConstantTermStructure::Interpolate(double dT) const
+    {
+        return dValues_[Locate(dT)];
+    }
+
+    double PiecewiseConstantTermStructure::Integral(double dT1, double dT2) const
+    {
+        //  Primitive from the first pillar : the value of the interval of t is integrated from its pillar (linear before the first pillar)
+        std::size_t i1 = Locate(dT1), i2 = Locate(dT2);
+        return (dIntegrals_[i2] - dIntegrals_[i1]) + dValues_[i2] * (dT2 - dVariables_[i2]) - dValues_[i1] * (dT1 - dVariables_[i1]);
+    }
+
+    double PiecewiseConstantTermStructure::SquaredIntegral(double dT1, double dT2) const
+    {
+        std::size_t i1 = Locate(dT1), i2 = Locate(dT2);
+        return (dSquaredIntegrals_[i2] - dSquaredIntegrals_[i1]) + dValues_[i2] * dValues_[i2] * (dT2 - dVariables_[i2]) - dValues_[i1] * dValues_[i1] * (dT1 - dVariables_[i1]);
+    }
+
+    TermStructure<double, double> PiecewiseConstantTermStructure::GetTermStructure() const
+    {
+        return TermStructure<double, double>(dVariables_, dValues_);
+    }
+
+    void PiecewiseConstantTermStructure::Align(const std::vector<const TermStructure<double, double> *> & sTermStructures, std::vector<PiecewiseConstantTermStructure> & sAligned)
+    {
+        std::size_t iNTermStructures = sTermStructures.size();
+        Utilities::require(iNTermStructures > 0, "PiecewiseConstantTermStructure::Align : no term structure");
+
+        //  iCursors[j] : first pillar of the term structure j above the last pillar of the grid
+        std::vector<std::size_t> iCursors(iNTermStructures, 0);
+        std::vector<double> dGrid;
+        std::vector<std::vector<double> > dValues(iNTermStructures);
+        std::size_t iNPillars = 0;
+        for (std::size_t j = 0 ; j < iNTermStructures ; ++j)
+        {
+            Utilities::require(!sTermStructures[j]->GetVariables().empty(), "PiecewiseConstantTermStructure::Align : empty term structure");
+            iNPillars += sTermStructures[j]->GetVariables().size();
+        }
+        dGrid.reserve(iNPillars);
+        for (std::size_t j = 0 ; j < iNTermStructures ; ++j)
+        {
+            dValues[j].reserve(iNPillars);
+        }
+
+        for ( ; ; )
+        {
+            //  Next pillar of the grid : smallest pillar of the cursors
+            bool bHasPillar = false;
+            double dPillar = 0.0;
+            for (std::size_t j = 0 ; j < iNTermStructures ; ++j)
+            {
+                const std::vector<double> & dVariables = sTermStructures[j]->GetVariables();
+                if (iCursors[j] < dVariables.size() && (!bHasPillar || dVariables[iCursors[j]] < dPillar))
+                {
+                    dPillar = dVariables[iCursors[j]];
+                    bHasPillar = true;
+                }
+            }
+            if (!bHasPillar)
+            {
+                break;
+            }
+
+            //  Value of each term structure on [dPillar, next pillar[ : the one of its last pillar lower or equal to dPillar
+            dGrid.push_back(dPillar);
+            for (std::size_t j = 0 ; j < iNTermStructures ; ++j)
+            {
+                const std::vector<double> & dVariables = sTermStructures[j]->GetVariables();
+                std::size_t & iCursor = iCursors[j];
+                while (iCursor < dVariables.size() && dVariables[iCursor] <= dPillar)
+                {
+                    Utilities::require(iCursor == 0 || dVariables[iCursor] >= dVariables[iCursor - 1], "PiecewiseConstantTermStructure::Align : pillars are not sorted");
+                    ++iCursor;
+                }
+                dValues[j].push_back(sTermStructures[j]->GetValues()[iCursor > 0 ? iCursor - 1 : 0]);
+            }
+        }
+
+        sAligned.clear();
+        sAligned.reserve(iNTermStructures);
+        for (std::size_t j = 0 ; j < iNTermStructures ; ++j)
+        {
+            sAligned.push_back(PiecewiseConstantTermStructure(dGrid, dValues[j]));
+        }
+    }
+
+    PiecewiseConstantTermStructure PiecewiseConstantTermStructure::Product(const std::vector<const TermStructure<double, double> *> & sTermStructures)
+    {
+        std::vector<PiecewiseConstantTermStructure> sAligned;
+        Align(sTermStructures, sAligned);
+        std::vector<double> dValues = sAligned[0].GetValues();
+        for (std::size_t j = 1 ; j < sAligned.size() ; ++j)
+        {
+            const std::vector<double> & dFactors = sAligned[j].GetValues();
+            for (std::size_t i = 0 ; i < dValues.size() ; ++i)
+            {
+                dValues[i] *= dFactors[i];
+            }
+        }
+        return PiecewiseConstantTermStructure(sAligned[0].GetVariables(), dValues);
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  PiecewiseConstantTermStructure.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_PiecewiseConstantTermStructure_h
+#define Seminaire_PiecewiseConstantTermStructure_h
+
+#include <vector>
+#include "TermStructure.h"
+
+namespace Finance {
+
+    //  Immutable right-continuous piecewise constant term structure (the convention of TermStructure::Interpolate) : value U_i on
+    //  [T_i, T_{i+1}[, U_0 before the first pillar and U_n after the last one
+    //  The intervals are found by binary search, and the integrals of the value and of its square are read on cumulative tables built
+    //  once on the pillars, so that an integral costs O(log n) whatever the number of pillars it covers
+    class PiecewiseConstantTermStructure
+    {
+    public:
+        //  Constant 0
+        PiecewiseConstantTermStructure();
+        //  dVariables : non-decreasing pillars (the last value of equal pillars is kept)
+        PiecewiseConstantTermStructure(const std::vector<double> & dVariables, const std::vector<double> & dValues);
+        explicit PiecewiseConstantTermStructure(const TermStructure<double, double> & sTermStructure);
+        virtual ~PiecewiseConstantTermStructure();
+
+        const std::vector<double> & GetVariables() const
+        {
+            return dVariables_;
+        }
+
+        const std::vector<double> & GetValues() const
+        {
+            return dValues_;
+        }
+
+        std::size_t GetNbVariables() const
+        {
+            return dVariables_.size();
+        }
+
+        //  Index of the interval of dT : last pillar lower or equal to dT, 0 before the first pillar
+        std::size_t Locate(double dT) const;
+
+        double Interpolate(double dT) const;
+
+        //  \int_{dT1}^{dT2} U(u) du and \int_{dT1}^{dT2} U(u)^2 du (opposite if dT2 < dT1)
+        double Integral(double dT1, double dT2) const;
+        double SquaredIntegral(double dT1, double dT2) const;
+
+        //  Conversion to the generic term structure
+        TermStructure<double, double> GetTermStructure() const;
+
+        //  Aligns the term structures on the union of their pillars in one pass (k-way merge of the pillars) : sAligned[j] has the values
+        //  of *sTermStructures[j] on the common grid, so that they can be combined pillar by pillar
+        static void Align(const std::vector<const TermStructure<double, double> *> & sTermStructures, std::vector<PiecewiseConstantTermStructure> & sAligned);
+        //  Product of the term structures on the union of their pillars (instantaneous covariance of several volatilities)
+        static PiecewiseConstantTermStructure Product(const std::vector<const TermStructure<double, double> *> & sTermStructures);
+
+    private:
+        //  Strictly increasing pillars and their values
+        std::vector<double> dVariables_, dValues_;
+        //  dIntegrals_[i] = \int_{T_0}^{T_i} U(u) du, dSquaredIntegrals_[i] = \int_{T_0}^{T_i} U(u)^2 du
+        std::vector<double> dIntegrals_, dSquaredIntegrals_;
+
+        void Initialize(const std::vector<double> & dVariables, const std::vector<double> & dValues);
+    };
+}
+
+#endif
@@ -12,6 +12,17 @@
 namespace Finance {
     
     Schedule::Schedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const YieldCurve & sYieldCurve, MyBasis eBasis, MyFrequency eFrequency) : eFrequency_(eFrequency)
+    {
+        BuildSchedule(sStart, sEnd, sYieldCurve, eBasis);
+    }
+    
+    Schedule::Schedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const DiscountCurve & sDiscountCurve, MyBasis eBasis, MyFrequency eFrequency) : eFrequency_(eFrequency)
+    {
+        BuildSchedule(sStart, sEnd, sDiscountCurve, eBasis);
+    }
+    
+    template<class Curve>
+    void Schedule::BuildSchedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const Curve & sCurve, MyBasis eBasis)
     {
         Utilities::Date::MyDate sCurrentStart, sCurrentEnd = sStart;
         std::pair<std::size_t, Utilities::Date::TimeUnits> NumberAndUnitToAdd = Frequency::ParseFrequency(eFrequency_);
@@ -20,7 +31,7 @@ namespace Finance {
         
         while (sCurrentEnd <= sEnd)
         {
-            EventOfSchedule sEvent(sCurrentStart, sCurrentEnd, sYieldCurve, eBasis);
+            EventOfSchedule sEvent(sCurrentStart, sCurrentEnd, sCurve, eBasis);
             sSchedule_.push_back(sEvent);
             
             //  Update current
@@ -34,7 +45,7 @@ namespace Finance {
         sSchedule_.clear();
     }
     
-    std::vector<EventOfSchedule> Schedule::GetSchedule() const
+    const std::vector<EventOfSchedule> & Schedule::GetSchedule() const
     {
         return sSchedule_;
     }
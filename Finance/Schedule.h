@@ -21,11 +21,16 @@ namespace Finance {
         std::vector<EventOfSchedule> sSchedule_;
         MyFrequency eFrequency_;
         
+        //  Events between sStart and sEnd, discounted on sCurve (YieldCurve or DiscountCurve)
+        template<class Curve>
+        void BuildSchedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const Curve & sCurve, MyBasis eBasis);
+        
     public:
         Schedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const YieldCurve & sYieldCurve, MyBasis eBasis, MyFrequency eFrequency);
+        Schedule(const Utilities::Date::MyDate & sStart, const Utilities::Date::MyDate & sEnd, const DiscountCurve & sDiscountCurve, MyBasis eBasis, MyFrequency eFrequency);
         virtual ~Schedule();
         
-        virtual std::vector<EventOfSchedule> GetSchedule() const;
+        virtual const std::vector<EventOfSchedule> & GetSchedule() const;
     };
 }
 
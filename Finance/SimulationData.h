@@ -14,9 +14,13 @@
 #include <cmath> // for floor and pow
 #include "VectorUtilities.h"
 #include "StringUtilities.h"
+#include "AlignedAllocator.h"
+#include "ArrayView.h"
 
 namespace Finance{
     
+    //  Simulated factors are stored in one contiguous aligned buffer laid out as [date][factor][path]
+    //  For a given date and factor, the values of all the paths are contiguous (iPathStride_ apart from the next factor)
     class SimulationData
     {
     public:
@@ -24,24 +28,31 @@ namespace Finance{
         typedef std::vector<std::vector<std::vector<double> > > Cube;
         typedef std::pair<std::vector<double>, Cube> Data;
         
-        SimulationData()
+        typedef std::vector<double, Utilities::AlignedAllocator<double, 64> > Buffer;
+        
+        //  Values of one factor at one date for all the paths
+        typedef Utilities::ArrayView<double> FactorView;
+        typedef Utilities::ArrayView<const double> ConstFactorView;
+        
+        //  Values of all the factors (rows) at one date for all the paths (columns)
+        typedef Utilities::MatrixView<double> DateView;
+        typedef Utilities::MatrixView<const double> ConstDateView;
+        
+        //  Values of one factor at all the dates (rows) for all the paths (columns)
+        typedef Utilities::MatrixView<double> FactorDatesView;
+        typedef Utilities::MatrixView<const double> ConstFactorDatesView;
+        
+        SimulationData() : iNDates_(0), iNFactors_(0), iNPaths_(0), iPathStride_(0)
         {};
         
-        virtual ~SimulationData()
+        SimulationData(std::size_t iNDates, std::size_t iNFactors, std::size_t iNPaths) : iNDates_(0), iNFactors_(0), iNPaths_(0), iPathStride_(0)
         {
-            DateList_.clear();
-            Data_.first.clear();
-            Data_.first.~vector();
-            
-            for (Cube::iterator itDates = Data_.second.begin() ; itDates != Data_.second.end() ; ++itDates)
-            {
-                for (std::vector<std::vector<double> >::iterator itPaths = (*itDates).begin() ; itPaths != (*itDates).end() ; ++itPaths)
-                {
-                    (*itPaths).clear();
-                }
-            }
+            Allocate(iNDates, iNFactors, iNPaths);
         };
         
+        virtual ~SimulationData()
+        {};
+        
         void ReadFromFile(const char * cFile)
         {
             std::ifstream stream;
@@ -57,13 +68,13 @@ namespace Finance{
                 std::size_t iDate;
                 if (!Utilities::IsFound(DateList_, lDate, &iDate))
                 {
+                    iDate = DateList_.size();
                     DateList_.push_back(lDate);
                 }
                 
                 //  Split vectorValues
                 std::vector<std::string> cVectorValues = Utilities::Split(cValues, " ");
                 
-                Data_.first = std::vector<double>(1,0.0);
                 std::vector<double> dVectorValues;
                 for (std::size_t i = 0 ; i < cVectorValues.size() ; ++i)
                 {
@@ -86,57 +97,48 @@ namespace Finance{
             if (sFile)
             {
                 fprintf(sFile, "Date Path Value\n");
-                std::size_t iDate = 0;
-                for (Cube::const_iterator itDates = Data_.second.begin() ; itDates != Data_.second.end() ; ++itDates)
+                for (std::size_t iDate = 0 ; iDate < iNDates_ ; ++iDate)
                 {
-                    std::size_t iPath = 0;
-                    for (std::vector<std::vector<double> >::const_iterator itPaths = (*itDates).begin() ; itPaths != (*itDates).end() ; ++itPaths)
+                    ConstDateView sDateView = GetDatePaths(iDate);
+                    for (std::size_t iPath = 0 ; iPath < iNPaths_ ; ++iPath)
                     {
                         fprintf(sFile, "%ld %lu", DateList_[iDate], iPath);
-                        for (std::size_t i = 0 ; i < (*itPaths).size() ; ++i)
+                        for (std::size_t iFactor = 0 ; iFactor < iNFactors_ ; ++iFactor)
                         {
-                            fprintf(sFile, " %.10lf", (*itPaths)[i]);
+                            fprintf(sFile, " %.10lf", sDateView(iFactor, iPath));
                         }
                         fprintf(sFile, "\n");
-                        //increment iPath
-                        iPath++;
                     }
-                    //  increment iDate
-                    iDate++;
                 }
+                fclose(sFile);
             }
-            fclose(sFile);
+        }
+        
+        //  Preallocate the storage for iNDates x iNFactors x iNPaths values (all set to 0)
+        //  Simulators should call this method once before writing through the views to avoid any reallocation
+        void Allocate(std::size_t iNDates, std::size_t iNFactors, std::size_t iNPaths)
+        {
+            iNDates_ = iNDates;
+            iNFactors_ = iNFactors;
+            iNPaths_ = iNPaths;
+            iPathStride_ = RoundStride(iNPaths);
+            
+            Buffer dBuffer(iNDates_ * iNFactors_ * iPathStride_, 0.0);
+            dBuffer_.swap(dBuffer);
         }
         
         //  Method to put values for a date at a specific path in Data_
+        //  The storage grows if the date, path or number of factors is not allocated yet
         void Put(std::size_t iDate, std::size_t iPath,const std::vector<double> & dValues)
         {
-            if (iDate < Data_.second.size())
+            if (iDate >= iNDates_ || iPath >= iNPaths_ || dValues.size() > iNFactors_)
             {
-                if (iPath < Data_.second[iDate].size())
-                {
-                    Data_.second[iDate][iPath] = dValues;
-                }
-                else
-                {
-                    std::size_t iNPaths = Data_.second[iDate].size();
-                    for (std::size_t i = iNPaths ; i < iPath + 1 ; ++i)
-                    {
-                        std::vector<double> dValues0(1,0.0);
-                        Data_.second[iDate].push_back(dValues0);
-                    }
-                    Data_.second[iDate].back() = dValues;
-                }
+                Resize(std::max(iDate + 1, iNDates_), std::max(dValues.size(), iNFactors_), std::max(iPath + 1, iNPaths_));
             }
-            else
+            double * pValues = &dBuffer_[Offset(iDate, 0, iPath)];
+            for (std::size_t iFactor = 0 ; iFactor < iNFactors_ ; ++iFactor)
             {
-                std::size_t iNDates = Data_.second.size();
-                for (std::size_t i = iNDates ; i < iDate + 1 ; ++i)
-                {
-                    std::vector<std::vector<double> > dVectorValues(iPath + 1, std::vector<double>(1,0.0));
-                    Data_.second.push_back(dVectorValues);
-                    Data_.second[iDate].back() = dValues;
-                }
+                pValues[iFactor * iPathStride_] = iFactor < dValues.size() ? dValues[iFactor] : 0.0;
             }
         }
         
@@ -158,12 +160,17 @@ namespace Finance{
         //  Get an element from the Data
         std::vector<double> Get(const std::size_t iDate, const std::size_t iPath)
         {
-            //if (Data_.second.count(iDate) != 0)
-            if (iDate < Data_.second.size())
+            if (iDate < iNDates_)
             {
-                if (iPath < Data_.second[iDate].size())
+                if (iPath < iNPaths_)
                 {
-                    return Data_.second[iDate][iPath];
+                    std::vector<double> dValues(iNFactors_);
+                    const double * pValues = &dBuffer_[Offset(iDate, 0, iPath)];
+                    for (std::size_t iFactor = 0 ; iFactor < iNFactors_ ; ++iFactor)
+                    {
+                        dValues[iFactor] = pValues[iFactor * iPathStride_];
+                    }
+                    return dValues;
                 }
             }
             else
@@ -174,19 +181,124 @@ namespace Finance{
             return std::vector<double>(1, pow(10.0,10));
         }
         
+        //  Views on the stored values (no copy)
+        ConstFactorView GetFactorPaths(std::size_t iDate, std::size_t iFactor) const
+        {
+            return ConstFactorView(dBuffer_.empty() ? 0 : &dBuffer_[Offset(iDate, iFactor, 0)], iNPaths_);
+        }
+        
+        FactorView GetFactorPaths(std::size_t iDate, std::size_t iFactor)
+        {
+            return FactorView(dBuffer_.empty() ? 0 : &dBuffer_[Offset(iDate, iFactor, 0)], iNPaths_);
+        }
+        
+        ConstDateView GetDatePaths(std::size_t iDate) const
+        {
+            return ConstDateView(dBuffer_.empty() ? 0 : &dBuffer_[Offset(iDate, 0, 0)], iNFactors_, iNPaths_, iPathStride_);
+        }
+        
+        DateView GetDatePaths(std::size_t iDate)
+        {
+            return DateView(dBuffer_.empty() ? 0 : &dBuffer_[Offset(iDate, 0, 0)], iNFactors_, iNPaths_, iPathStride_);
+        }
+        
+        ConstFactorDatesView GetFactorDatesPaths(std::size_t iFactor) const
+        {
+            return ConstFactorDatesView(dBuffer_.empty() ? 0 : &dBuffer_[Offset(0, iFactor, 0)], iNDates_, iNPaths_, iNFactors_ * iPathStride_);
+        }
+        
+        FactorDatesView GetFactorDatesPaths(std::size_t iFactor)
+        {
+            return FactorDatesView(dBuffer_.empty() ? 0 : &dBuffer_[Offset(0, iFactor, 0)], iNDates_, iNPaths_, iNFactors_ * iPathStride_);
+        }
+        
+        std::size_t GetNbDates() const
+        {
+            return iNDates_;
+        }
+        
+        std::size_t GetNbFactors() const
+        {
+            return iNFactors_;
+        }
+        
+        std::size_t GetNbPaths() const
+        {
+            return iNPaths_;
+        }
+        
+        //  Compatibility adapter : builds a full copy of the simulated values as a Cube (Dates x Paths x Factors)
+        //  Prefer GetFactorPaths / GetDatePaths which do not copy
         Data GetData() const
         {
-            return Data_;
+            Data sData;
+            sData.second.resize(iNDates_, std::vector<std::vector<double> >(iNPaths_, std::vector<double>(iNFactors_)));
+            for (std::size_t iDate = 0 ; iDate < iNDates_ ; ++iDate)
+            {
+                ConstDateView sDateView = GetDatePaths(iDate);
+                for (std::size_t iPath = 0 ; iPath < iNPaths_ ; ++iPath)
+                {
+                    for (std::size_t iFactor = 0 ; iFactor < iNFactors_ ; ++iFactor)
+                    {
+                        sData.second[iDate][iPath][iFactor] = sDateView(iFactor, iPath);
+                    }
+                }
+            }
+            return sData;
         }
         
-        std::vector<long> GetDateList() const
+        const std::vector<long> & GetDateList() const
         {
             return DateList_;
         }
         
     private:
-        Data Data_;
+        Buffer dBuffer_;
+        std::size_t iNDates_, iNFactors_, iNPaths_;
+        //  Distance between two consecutive factors in the buffer (number of paths rounded up to a whole cache line)
+        std::size_t iPathStride_;
         std::vector<long> DateList_;
+        
+        std::size_t Offset(std::size_t iDate, std::size_t iFactor, std::size_t iPath) const
+        {
+            return (iDate * iNFactors_ + iFactor) * iPathStride_ + iPath;
+        }
+        
+        static std::size_t RoundStride(std::size_t iNPaths)
+        {
+            //  8 doubles = 64 bytes
+            return (iNPaths + 7) & ~static_cast<std::size_t>(7);
+        }
+        
+        //  Grow the storage keeping the values already stored
+        void Resize(std::size_t iNDates, std::size_t iNFactors, std::size_t iNPaths)
+        {
+            if (iNFactors == iNFactors_ && iNPaths <= iPathStride_)
+            {
+                //  Only new dates (or paths within the current stride) : the layout is unchanged
+                dBuffer_.resize(iNDates * iNFactors * iPathStride_, 0.0);
+                iNDates_ = iNDates;
+                iNPaths_ = iNPaths;
+                return;
+            }
+            
+            //  Geometric growth of the stride so that path by path filling stays amortized linear
+            std::size_t iPathStride = iNPaths <= iPathStride_ ? iPathStride_ : RoundStride(std::max(iNPaths, 2 * iPathStride_));
+            Buffer dBuffer(iNDates * iNFactors * iPathStride, 0.0);
+            for (std::size_t iDate = 0 ; iDate < iNDates_ ; ++iDate)
+            {
+                for (std::size_t iFactor = 0 ; iFactor < iNFactors_ ; ++iFactor)
+                {
+                    const double * pOld = &dBuffer_[Offset(iDate, iFactor, 0)];
+                    std::copy(pOld, pOld + iNPaths_, dBuffer.begin() + (iDate * iNFactors + iFactor) * iPathStride);
+                }
+            }
+            dBuffer_.swap(dBuffer);
+            iNDates_ = iNDates;
+            iNFactors_ = iNFactors;
+            iNPaths_ = iNPaths;
+            iPathStride_ = iPathStride;
+        }
     };
 }
 
@@ -19,11 +19,21 @@ namespace Finance{
     
     {}
     
+    SwapMonoCurve::SwapMonoCurve(const Utilities::Date::MyDate & sStartSwap, const Utilities::Date::MyDate & sEndSwap, MyFrequency eFixedLegFrequency, MyBasis eBasis, const DiscountCurve & sDiscountCurve)
+    : 
+    Annuity(sStartSwap, sEndSwap, eBasis, eFixedLegFrequency, sDiscountCurve)
+    
+    {}
+    
     SwapMonoCurve::~SwapMonoCurve()
     {}
     
     double SwapMonoCurve::ComputeSwap() const
     {
+        if (pDiscountCurve_ != 0)
+        {
+            return (pDiscountCurve_->DiscountFactor(sStart_) - pDiscountCurve_->DiscountFactor(sEnd_)) / ComputeAnnuity();
+        }
         DF sDF(sYieldCurve_);
         
         return (sDF.DiscountFactor(sStart_) - sDF.DiscountFactor(sEnd_)) / ComputeAnnuity();
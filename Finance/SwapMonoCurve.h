@@ -19,6 +19,8 @@ namespace Finance {
         YieldCurve sYieldCurve_;
     public:
         SwapMonoCurve(const Utilities::Date::MyDate & sStartSwap, const Utilities::Date::MyDate & sEndSwap, MyFrequency eFixedLegFrequency, MyBasis eBasis, const YieldCurve & sYieldCurve);
+        //  Swap discounted on a shared precompiled curve (which has to outlive the swap)
+        SwapMonoCurve(const Utilities::Date::MyDate & sStartSwap, const Utilities::Date::MyDate & sEndSwap, MyFrequency eFixedLegFrequency, MyBasis eBasis, const DiscountCurve & sDiscountCurve);
         virtual ~SwapMonoCurve();
         
         virtual double ComputeSwap() const;
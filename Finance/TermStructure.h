@@ -10,17 +10,21 @@
 #define Seminaire_TermStructure_h
 
 #include <vector>
+#include <algorithm>
 #include "Require.h"
+#include "TermStructureExpression.h"
 
 //  This file creates a termstructure template
+//  Term structures are operands of the lazy algebra of TermStructureExpression.h : an expression is evaluated on the union of the
+//  pillars when it is assigned to (or constructs) a term structure
 
 namespace Finance {
     
     template<class T, class U>
-    class TermStructure
+    class TermStructure : public TermStructureExpression<TermStructure<T, U> >
     {
     public:
-        TermStructure()
+        TermStructure() : lVersion_(NewVersion())
         {
             TVariables_.resize(1);
             TVariables_[0] = 0;
@@ -29,20 +33,27 @@ namespace Finance {
             UValues_[0] = 0;
         }
         
-        TermStructure(const std::vector<T> & TVariables, const std::vector<U> & UValues) : TVariables_(TVariables), UValues_(UValues)
+        TermStructure(const std::vector<T> & TVariables, const std::vector<U> & UValues) : TVariables_(TVariables), UValues_(UValues), lVersion_(NewVersion())
         {
             Utilities::require(TVariables.size() == UValues.size(), "Size of variables and values are not the same");
         }
         
+        template<class E>
+        TermStructure(const TermStructureExpression<E> & sExpression) : lVersion_(NewVersion())
+        {
+            EvaluateTermStructure(sExpression, TVariables_, UValues_);
+        }
+        
         virtual ~TermStructure()
         {}
         
-        virtual std::vector<T> GetVariables() const
+        //  Accessors return references to the stored vectors : no copy
+        virtual const std::vector<T> & GetVariables() const
         {
             return TVariables_;
         }
         
-        virtual std::vector<U> GetValues() const
+        virtual const std::vector<U> & GetValues() const
         {
             return UValues_;
         }
@@ -50,17 +61,27 @@ namespace Finance {
         virtual void SetVariables(const std::vector<T> & TVariables)
         {
             TVariables_ = TVariables;
+            Modified();
         }
         
         virtual void SetValues(const std::vector<U> & UValues)
         {
             UValues_ = UValues;
+            Modified();
         }
         
         virtual void SetTermStructure(const std::vector<T> & TVariables, const std::vector<U> & UValues)
         {
             UValues_ = UValues;
             TVariables_ = TVariables;
+            Modified();
+        }
+        
+        //  Stamp of the pillars and values, renewed by every modification and copied with them (two term structures with the same stamp 
+        //  hold the same values) : the caches built on a term structure are valid as long as its stamp is the same
+        unsigned long GetVersion() const
+        {
+            return lVersion_;
         }
         
         virtual bool IsTermStructure() const
@@ -70,26 +91,10 @@ namespace Finance {
         
         virtual U Interpolate(const T& variable) const
         {
-            //  Flat extrapolation on the left
-            if (variable < TVariables_[0])
-            {
-                return UValues_[0];
-            }
-            for (std::size_t i = 0 ; i < TVariables_.size() - 1 ; ++i)
-            {
-                //  Right-continuous piecewise constant function
-                if (TVariables_[i] <= variable < TVariables_[i + 1] )
-                {
-                    return UValues_[i];
-                }
-            }
-            
-            //  Flat extrapolation on the right
-            if (variable >= TVariables_.back())
-            {
-                return UValues_.back();
-            }
-            return 0.0;
+            //  Right-continuous piecewise constant function : value of the last pillar lower or equal to variable (binary search), 
+            //  flat extrapolation on both sides
+            std::size_t i = std::upper_bound(TVariables_.begin(), TVariables_.end(), variable) - TVariables_.begin();
+            return UValues_[i > 0 ? i - 1 : 0];
         }
         
         virtual void MergeTermStructure(TermStructure<T,U> & sTermStructure)
@@ -98,15 +103,19 @@ namespace Finance {
             {  
                 size_t iSizeA = TVariables_.size(), iSizeB = sTermStructure.GetVariables().size();
                 
-                std::vector<T> TVariablesA = TVariables_;
-                std::vector<U> TVariablesB = sTermStructure.GetVariables();
+                //  Both term structures are only read until the merged vectors are swapped in
+                const std::vector<T> & TVariablesA = TVariables_;
+                const std::vector<T> & TVariablesB = sTermStructure.GetVariables();
                 
-                std::vector<T> UValuesA = UValues_;
-                std::vector<U> UValuesB = sTermStructure.GetValues();
+                const std::vector<U> & UValuesA = UValues_;
+                const std::vector<U> & UValuesB = sTermStructure.GetValues();
                 
                 std::vector<T> TVariablesMerged;
                 std::vector<U> UValuesAMerged;
                 std::vector<U> UValuesBMerged;
+                TVariablesMerged.reserve(iSizeA + iSizeB);
+                UValuesAMerged.reserve(iSizeA + iSizeB);
+                UValuesBMerged.reserve(iSizeA + iSizeB);
                 
                 int iIndexA = 0, iIndexB = 0;
                 
@@ -132,7 +141,7 @@ namespace Finance {
                     else if (TVariablesA[iIndexA] == TVariablesB[iIndexB]) {
                         TVariablesMerged.push_back(TVariablesA[iIndexA]);
                         UValuesAMerged.push_back(UValuesA[iIndexA]);
-                        UValuesBMerged.push_back(UValuesB[std::max(0,iIndexB-1)]);
+                        UValuesBMerged.push_back(UValuesB[iIndexB]);
                         ++iIndexA;
                         ++iIndexB;
                     }
@@ -145,40 +154,68 @@ namespace Finance {
                 }
                 
                 
-                TVariables_ = TVariablesMerged;
-                UValues_ = UValuesAMerged;
+                TVariables_.swap(TVariablesMerged);
+                UValues_.swap(UValuesAMerged);
+                Modified();
                 
-                sTermStructure.SetVariables(TVariablesMerged);
+                sTermStructure.SetVariables(TVariables_);
                 sTermStructure.SetValues(UValuesBMerged);
 			}
 		}
         
-        TermStructure<double, U> operator = (U& value)
+        TermStructure<T, U> & operator = (const U & value)
         {
-            TVariables_.clear();
-            UValues_.clear();
-            TVariables_.push_back(0.0);
-            UValues_.push_back(value);
+            TVariables_.assign(1, T(0));
+            UValues_.assign(1, value);
+            Modified();
             return *this;
         }
         
-        TermStructure<T,U> operator *= (TermStructure<T,U> & sTermstructure)
+        //  The expression is evaluated in new vectors before they are swapped in : it may refer to this term structure
+        template<class E>
+        TermStructure<T, U> & operator = (const TermStructureExpression<E> & sExpression)
         {
-            MergeTermStructure(sTermstructure);
-            
-            std::vector<U> UValuesTS = sTermstructure.GetValues();
-            
-            for (std::size_t i = 0 ; i < TVariables_.size() ; ++i)
+            std::vector<T> TVariables;
+            std::vector<U> UValues;
+            EvaluateTermStructure(sExpression, TVariables, UValues);
+            TVariables_.swap(TVariables);
+            UValues_.swap(UValues);
+            Modified();
+            return *this;
+        }
+        
+        template<class E>
+        TermStructure<T, U> & operator += (const TermStructureExpression<E> & sExpression)
+        {
+            return *this = *this + sExpression;
+        }
+        
+        template<class E>
+        TermStructure<T, U> & operator -= (const TermStructureExpression<E> & sExpression)
+        {
+            return *this = *this - sExpression;
+        }
+        
+        template<class E>
+        TermStructure<T, U> & operator *= (const TermStructureExpression<E> & sExpression)
+        {
+            return *this = *this * sExpression;
+        }
+        
+        TermStructure<T, U> & operator *= (double dValue)
+        {
+            for (std::size_t i = 0 ; i < UValues_.size() ; ++i)
             {
-                UValues_[i] *= UValuesTS[i]; 
+                UValues_[i] *= dValue;
             }
+            Modified();
             return *this;
         }
         
         template<class V, class W>
         bool IsSameTermStructure(const TermStructure<V, W> & sTermStructure) const
         {
-            std::vector<V> sTSVariables = sTermStructure.GetVariables();
+            const std::vector<V> & sTSVariables = sTermStructure.GetVariables();
             if (sTSVariables.size() != TVariables_.size())
             {
                 return false;
@@ -204,6 +241,21 @@ namespace Finance {
     protected:
         std::vector<T> TVariables_;
         std::vector<U> UValues_;
+        unsigned long lVersion_;
+        
+        //  To call after any change of TVariables_ or UValues_
+        void Modified()
+        {
+            lVersion_ = NewVersion();
+        }
+        
+    private:
+        //  Atomic increment : term structures may be built or modified concurrently (in the tasks of a ThreadPool for instance)
+        static unsigned long NewVersion()
+        {
+            static unsigned long lLastVersion = 0;
+            return __sync_add_and_fetch(&lLastVersion, 1UL);
+        }
     };
     
 }
@@ -0,0 +1,297 @@
+//
+//  TermStructureExpression.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_TermStructureExpression_h
+#define Seminaire_TermStructureExpression_h
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//  Lazy algebra on piecewise constant term structures : sums, differences, products, quotients and scalar operations build a tree of
+//  lightweight nodes (references to the term structures, no copy) which is evaluated only when it is assigned to a TermStructure.
+//  The evaluation walks the union of the pillars of all the leaves in one pass (one cursor per leaf), so that a composite such as
+//  rho * sigma1 * sigma2 - sigma2 * sigma2 is materialised with one allocation per vector of the result, without intermediate term
+//  structure nor merge
+//  Node protocol (on a copy of the tree, the cursors start before the first pillar) :
+//      NextVariable(dNext) : smallest pillar not consumed yet (false if none)
+//      Advance(dVariable) : consumes the pillars lower or equal to dVariable
+//      Value() : value on the interval of the last consumed pillar (value of the first pillar before it, as TermStructure::Interpolate)
+
+namespace Finance {
+
+    template<class T, class U>
+    class TermStructure;
+
+    //  Base of the nodes (CRTP)
+    template<class E>
+    class TermStructureExpression
+    {
+    public:
+        const E & Derived() const
+        {
+            return static_cast<const E &>(*this);
+        }
+    };
+
+    //  Leaf : reference to a term structure and its cursor
+    template<class T, class U>
+    class TermStructureLeaf : public TermStructureExpression<TermStructureLeaf<T, U> >
+    {
+    public:
+        TermStructureLeaf(const TermStructure<T, U> & sTermStructure) : TVariables_(sTermStructure.GetVariables()), UValues_(sTermStructure.GetValues()), iCursor_(0)
+        {}
+
+        std::size_t GetMaxNbVariables() const
+        {
+            return TVariables_.size();
+        }
+
+        bool NextVariable(double & dNext) const
+        {
+            if (iCursor_ < TVariables_.size())
+            {
+                dNext = TVariables_[iCursor_];
+                return true;
+            }
+            return false;
+        }
+
+        void Advance(double dVariable)
+        {
+            while (iCursor_ < TVariables_.size() && TVariables_[iCursor_] <= dVariable)
+            {
+                ++iCursor_;
+            }
+        }
+
+        double Value() const
+        {
+            return UValues_[iCursor_ > 0 ? iCursor_ - 1 : 0];
+        }
+
+        double Interpolate(double dVariable) const
+        {
+            std::size_t i = std::upper_bound(TVariables_.begin(), TVariables_.end(), dVariable) - TVariables_.begin();
+            return UValues_[i > 0 ? i - 1 : 0];
+        }
+
+    private:
+        const std::vector<T> & TVariables_;
+        const std::vector<U> & UValues_;
+        std::size_t iCursor_;
+    };
+
+    //  Constant : no pillar
+    class TermStructureScalar : public TermStructureExpression<TermStructureScalar>
+    {
+    public:
+        TermStructureScalar(double dValue) : dValue_(dValue)
+        {}
+
+        std::size_t GetMaxNbVariables() const
+        {
+            return 0;
+        }
+
+        bool NextVariable(double & /*dNext*/) const
+        {
+            return false;
+        }
+
+        void Advance(double /*dVariable*/)
+        {}
+
+        double Value() const
+        {
+            return dValue_;
+        }
+
+        double Interpolate(double /*dVariable*/) const
+        {
+            return dValue_;
+        }
+
+    private:
+        double dValue_;
+    };
+
+    //  Type stored in a node for an operand : a term structure is held through a leaf, a node by value
+    template<class E>
+    struct TermStructureOperand
+    {
+        typedef E Type;
+    };
+
+    template<class T, class U>
+    struct TermStructureOperand<TermStructure<T, U> >
+    {
+        typedef TermStructureLeaf<T, U> Type;
+    };
+
+    //  Operations
+    struct TermStructurePlus
+    {
+        static double Apply(double dLeft, double dRight)
+        {
+            return dLeft + dRight;
+        }
+    };
+
+    struct TermStructureMinus
+    {
+        static double Apply(double dLeft, double dRight)
+        {
+            return dLeft - dRight;
+        }
+    };
+
+    struct TermStructureMultiplies
+    {
+        static double Apply(double dLeft, double dRight)
+        {
+            return dLeft * dRight;
+        }
+    };
+
+    struct TermStructureDivides
+    {
+        static double Apply(double dLeft, double dRight)
+        {
+            return dLeft / dRight;
+        }
+    };
+
+    template<class L, class R, class Op>
+    class TermStructureBinary : public TermStructureExpression<TermStructureBinary<L, R, Op> >
+    {
+    public:
+        TermStructureBinary(const L & sLeft, const R & sRight) : sLeft_(sLeft), sRight_(sRight)
+        {}
+
+        std::size_t GetMaxNbVariables() const
+        {
+            return sLeft_.GetMaxNbVariables() + sRight_.GetMaxNbVariables();
+        }
+
+        bool NextVariable(double & dNext) const
+        {
+            double dNextLeft = 0.0, dNextRight = 0.0;
+            bool bLeft = sLeft_.NextVariable(dNextLeft), bRight = sRight_.NextVariable(dNextRight);
+            if (bLeft && bRight)
+            {
+                dNext = std::min(dNextLeft, dNextRight);
+            }
+            else if (bLeft || bRight)
+            {
+                dNext = bLeft ? dNextLeft : dNextRight;
+            }
+            return bLeft || bRight;
+        }
+
+        void Advance(double dVariable)
+        {
+            sLeft_.Advance(dVariable);
+            sRight_.Advance(dVariable);
+        }
+
+        double Value() const
+        {
+            return Op::Apply(sLeft_.Value(), sRight_.Value());
+        }
+
+        double Interpolate(double dVariable) const
+        {
+            return Op::Apply(sLeft_.Interpolate(dVariable), sRight_.Interpolate(dVariable));
+        }
+
+    private:
+        typename TermStructureOperand<L>::Type sLeft_;
+        typename TermStructureOperand<R>::Type sRight_;
+    };
+
+    //  Operators : term structures and nodes on both sides, doubles on either side
+#define TERMSTRUCTUREOPERATOR(Operator, Op)                                                                                                         \
+    template<class L, class R>                                                                                                                      \
+    inline TermStructureBinary<L, R, Op> Operator(const TermStructureExpression<L> & sLeft, const TermStructureExpression<R> & sRight)              \
+    {                                                                                                                                               \
+        return TermStructureBinary<L, R, Op>(sLeft.Derived(), sRight.Derived());                                                                    \
+    }                                                                                                                                               \
+    template<class L>                                                                                                                               \
+    inline TermStructureBinary<L, TermStructureScalar, Op> Operator(const TermStructureExpression<L> & sLeft, double dRight)                         \
+    {                                                                                                                                               \
+        return TermStructureBinary<L, TermStructureScalar, Op>(sLeft.Derived(), TermStructureScalar(dRight));                                       \
+    }                                                                                                                                               \
+    template<class R>                                                                                                                               \
+    inline TermStructureBinary<TermStructureScalar, R, Op> Operator(double dLeft, const TermStructureExpression<R> & sRight)                         \
+    {                                                                                                                                               \
+        return TermStructureBinary<TermStructureScalar, R, Op>(TermStructureScalar(dLeft), sRight.Derived());                                       \
+    }
+
+    TERMSTRUCTUREOPERATOR(operator +, TermStructurePlus)
+    TERMSTRUCTUREOPERATOR(operator -, TermStructureMinus)
+    TERMSTRUCTUREOPERATOR(operator *, TermStructureMultiplies)
+    TERMSTRUCTUREOPERATOR(operator /, TermStructureDivides)
+
+#undef TERMSTRUCTUREOPERATOR
+
+    template<class E>
+    inline TermStructureBinary<TermStructureScalar, E, TermStructureMinus> operator - (const TermStructureExpression<E> & sExpression)
+    {
+        return TermStructureBinary<TermStructureScalar, E, TermStructureMinus>(TermStructureScalar(0.0), sExpression.Derived());
+    }
+
+    //  Evaluation on the union of the pillars in one pass (at least one pillar, 0 for an expression of constants)
+    template<class E>
+    void EvaluateTermStructure(const TermStructureExpression<E> & sExpression, std::vector<double> & dVariables, std::vector<double> & dValues)
+    {
+        typename TermStructureOperand<E>::Type sNode(sExpression.Derived());
+        std::size_t iMaxNbVariables = std::max(sNode.GetMaxNbVariables(), (std::size_t)1);
+        dVariables.clear();
+        dValues.clear();
+        dVariables.reserve(iMaxNbVariables);
+        dValues.reserve(iMaxNbVariables);
+
+        double dVariable = 0.0;
+        while (sNode.NextVariable(dVariable))
+        {
+            sNode.Advance(dVariable);
+            dVariables.push_back(dVariable);
+            dValues.push_back(sNode.Value());
+        }
+        if (dVariables.empty())
+        {
+            dVariables.push_back(0.0);
+            dValues.push_back(sNode.Value());
+        }
+    }
+
+    //  \int_{dT1}^{dT2} E(u) exp(dLambda u) du with dT1 <= dT2, in one pass on the pillars of the expression without materialising it
+    //  (dLambda = 0 : integral of the expression)
+    template<class E>
+    double ExpWeightedIntegral(const TermStructureExpression<E> & sExpression, double dLambda, double dT1, double dT2)
+    {
+        typename TermStructureOperand<E>::Type sNode(sExpression.Derived());
+        sNode.Advance(dT1);
+
+        double dIntegral = 0.0, dStart = dT1, dNext = 0.0;
+        while (dStart < dT2)
+        {
+            double dEnd = sNode.NextVariable(dNext) ? std::min(dNext, dT2) : dT2;
+            //  \int_{a}^{b} exp(lambda u) du = exp(lambda a) (b - a) (exp(x) - 1) / x with x = lambda (b - a)
+            double dLength = dEnd - dStart, dLambdaLength = dLambda * dLength;
+            double dPhi = dLambdaLength != 0.0 ? expm1(dLambdaLength) / dLambdaLength : 1.0;
+            dIntegral += sNode.Value() * exp(dLambda * dStart) * dLength * dPhi;
+            sNode.Advance(dEnd);
+            dStart = dEnd;
+        }
+        return dIntegral;
+    }
+}
+
+#endif
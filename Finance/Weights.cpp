@@ -17,6 +17,37 @@ namespace Finance {
     {}
     
     Weights::Weights(const YieldCurve & sInitialYieldCurve, const std::vector<double> & dS) : DF(sInitialYieldCurve), dS_(dS)
+    {
+        ComputeWeights(*this);
+    }
+    
+    Weights::Weights(const DiscountCurve & sDiscountCurve, const std::vector<double> & dS) : DF(sDiscountCurve.GetYieldCurve()), dS_(dS)
+    {
+        ComputeWeights(sDiscountCurve);
+    }
+    
+	Weights::Weights(const YieldCurve & sInitialYieldCurve, const std::vector<double> & dT, const std::vector<double> & dS) : DF(sInitialYieldCurve), dS_(dT)
+    {
+        ComputeWeights(*this, dS);
+    }
+    
+    Weights::Weights(const DiscountCurve & sDiscountCurve, const std::vector<double> & dT, const std::vector<double> & dS) : DF(sDiscountCurve.GetYieldCurve()), dS_(dT)
+    {
+        ComputeWeights(sDiscountCurve, dS);
+    }
+    
+    Weights::Weights(const YieldCurve & sInitialYieldCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis) : DF(sInitialYieldCurve)
+    {
+        ComputeWeights(sInitialYieldCurve, dStart, dEnd, eFrequency, eBasis);
+    }
+    
+    Weights::Weights(const DiscountCurve & sDiscountCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis) : DF(sDiscountCurve.GetYieldCurve())
+    {
+        ComputeWeights(sDiscountCurve, dStart, dEnd, eFrequency, eBasis);
+    }
+    
+    template<class Curve>
+    void Weights::ComputeWeights(const Curve & sCurve)
     {
 		std::size_t iSizeS = dS_.size() ;
 		double dAnnuity = 0. ;
@@ -27,7 +58,7 @@ namespace Finance {
 		
 		for (std::size_t iFixing = 1; iFixing < iSizeS; ++iFixing) {
 			// We will first assume that the dCoverage is computed with respect to the ACT / 365 convention
-            double dDF = (dS_[iFixing] - dS_[iFixing - 1]) * DiscountFactor(dS_[iFixing]) ;
+            double dDF = (dS_[iFixing] - dS_[iFixing - 1]) * sCurve.DiscountFactor(dS_[iFixing]) ;
 			dAnnuity += dDF ;
 			dWeights_[iFixing - 1] = dDF ;
 		}
@@ -37,8 +68,9 @@ namespace Finance {
 		}
 		
 	}
-	
-	Weights::Weights(const YieldCurve & sInitialYieldCurve, const std::vector<double> & dT, const std::vector<double> & dS) : DF(sInitialYieldCurve), dS_(dT)
+    
+    template<class Curve>
+    void Weights::ComputeWeights(const Curve & sCurve, const std::vector<double> & dS)
     {
 		std::size_t iSizeT = dS_.size() ;
 		std::size_t iSizeS = dS.size() ;
@@ -50,12 +82,12 @@ namespace Finance {
 		
 		for (std::size_t iFixing = 1; iFixing < iSizeT; ++iFixing) {
 			// We will first assume that the dCoverage is computed with respect to the ACT / 365 convention
-			double dDF = (dT[iFixing] - dT[iFixing-1]) * DiscountFactor(dT[iFixing]) ;
+			double dDF = (dS_[iFixing] - dS_[iFixing-1]) * sCurve.DiscountFactor(dS_[iFixing]) ;
 			dWeights_[iFixing] = dDF ;
 		}
 		
 		for (std::size_t iFixing = 1; iFixing < iSizeS; ++iFixing) {
-			dAnnuity += (dS_[iFixing] - dS_[iFixing-1]) * DiscountFactor(dS_[iFixing]) ;
+			dAnnuity += (dS_[iFixing] - dS_[iFixing-1]) * sCurve.DiscountFactor(dS_[iFixing]) ;
 		}
 		
 		for (std::size_t iFixing = 1; iFixing < iSizeT; ++iFixing) {
@@ -64,13 +96,14 @@ namespace Finance {
 		
 	}
     
-    Weights::Weights(const YieldCurve & sInitialYieldCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis) : DF(sInitialYieldCurve)
+    template<class Curve>
+    void Weights::ComputeWeights(const Curve & sCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis)
     {
         Utilities::require(dEnd > dStart, "Start is after end");
         Utilities::Date::MyDate sStart(dStart), sEnd(dEnd);
         
-        Schedule sSchedule(sStart, sEnd, sInitialYieldCurve, eBasis, eFrequency);
-        std::vector<EventOfSchedule> sVectOfEventOfSchedule = sSchedule.GetSchedule();
+        Schedule sSchedule(sStart, sEnd, sCurve, eBasis, eFrequency);
+        const std::vector<EventOfSchedule> & sVectOfEventOfSchedule = sSchedule.GetSchedule();
         dWeights_.resize(sVectOfEventOfSchedule.size());
         double dAnnuity = 0;
         
@@ -100,7 +133,7 @@ namespace Finance {
         return dWeights_[iFixing] ;
     }
 	
-	std::vector <double> Weights::GetWeights() const
+	const std::vector <double> & Weights::GetWeights() const
     {
         return dWeights_ ;
     }
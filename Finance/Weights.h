@@ -11,6 +11,7 @@
 #define Seminaire_Weights_h
 
 #include "DiscountFactor.h"
+#include "DiscountCurve.h"
 #include <vector>
 #include "Basis.h"
 #include "Frequency.h"
@@ -25,12 +26,24 @@ namespace Finance {
 		// Overloading the constructor to compute the weights in the case there are different fixing dates for the fixed and the float leg fixing dates
 		Weights(const YieldCurve & sInitialYieldCurve, const std::vector<double> & dT, const std::vector<double> & dS);
         Weights(const YieldCurve & sInitialYieldCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis);
+        //  Same weights discounted on a shared precompiled curve (the DF part of the weights is the yield curve of the discount curve)
+        Weights(const DiscountCurve & sDiscountCurve, const std::vector<double> & dS);
+        Weights(const DiscountCurve & sDiscountCurve, const std::vector<double> & dT, const std::vector<double> & dS);
+        Weights(const DiscountCurve & sDiscountCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis);
 		virtual ~Weights();
 		virtual double GetWeight(std::size_t iFixing) const;
-		virtual std::vector <double> GetWeights() const;
+		virtual const std::vector <double> & GetWeights() const;
 	private:
 		std::vector <double> dS_ ;
 		std::vector <double> dWeights_ ;
+        
+        //  Computation of the weights of each constructor with the discount factors of sCurve (DF or DiscountCurve)
+        template<class Curve>
+        void ComputeWeights(const Curve & sCurve);
+        template<class Curve>
+        void ComputeWeights(const Curve & sCurve, const std::vector<double> & dS);
+        template<class Curve>
+        void ComputeWeights(const Curve & sCurve, double dStart, double dEnd, MyFrequency eFrequency, MyBasis eBasis);
 	};
 }
 
@@ -7,6 +7,7 @@
 //
 
 #include <iostream>
+#include <algorithm>
 #include "YieldCurve.h"
 #include "VectorUtilities.h"
 
@@ -27,6 +28,7 @@ namespace Finance {
         dVariables_ = YC0.first;
         dValues_ = YC0.second;
         eInterpolationType_ = eInterExtrapolationType;
+        UpdateGrid();
     }
     
     YieldCurve::~YieldCurve()
@@ -42,6 +44,32 @@ namespace Finance {
         return Interp1D(t);
     }
     
+    void YieldCurve::YC(Utilities::ArrayView<const double> dT, Utilities::ArrayView<double> dResults) const
+    {
+        Utilities::require(dT.data() != dResults.data(), "YieldCurve::YC : the results cannot overwrite the times");
+        Interp1D(dT, dResults);
+        for (std::size_t i = 0 ; i < dT.size() ; ++i)
+        {
+            if (dT[i] < 1e-03)
+            {
+                dResults[i] = dValues_[0];
+            }
+        }
+    }
+    
+    void YieldCurve::YCSensitivities(const Utilities::Interp::InterExtrapolation1DSensitivities & sSensitivities, double t, Utilities::ArrayView<double> dSensitivities) const
+    {
+        if (t < 1e-03)
+        {
+            Utilities::require(dSensitivities.size() == dValues_.size(), "YieldCurve::YCSensitivities : the sensitivities are not of the number of pillars");
+            std::fill(dSensitivities.begin(), dSensitivities.end(), 0.0);
+            dSensitivities[0] = 1.0;
+            return;
+        }
+        Utilities::require(t > 0, "t is not positive in YieldCurve::YCSensitivities");
+        sSensitivities.Sensitivities(t, dSensitivities);
+    }
+    
     std::string YieldCurve::GetCurrency() const
     {
         return cCCY_;
@@ -66,6 +94,7 @@ namespace Finance {
             sResult.dVariables_.push_back(sYieldCurve.dVariables_[iPillar] + dVariables_[iPillar]);
             sResult.dValues_.push_back(sYieldCurve.dValues_[iPillar] + dValues_[iPillar]);
         }
+        sResult.UpdateGrid();
         
         return sResult;
     }
@@ -73,19 +102,14 @@ namespace Finance {
     YieldCurve YieldCurve::operator=(double dValue)
     {
         eInterpolationType_ = Utilities::Interp::LIN;
+        dVariables_.clear();
+        dValues_.clear();
         for (std::size_t i = 0 ; i < 31 ; ++i)
         {   
-            if (i >= dVariables_.size())
-            {
-                dVariables_.push_back(i);
-                dValues_.push_back(dValue);
-            }
-            else 
-            {
-                dVariables_[i] = i;
-                dValues_[i] = dValue;
-            }
+            dVariables_.push_back(i);
+            dValues_.push_back(dValue);
         }
+        UpdateGrid();
         return *this;
     }
     
@@ -95,5 +119,6 @@ namespace Finance {
         {
             dValues_[i] -= dShift * exp(-dVariables_[i] / dTau);
         }
+        UpdateGrid();
     }
 }
\ No newline at end of file
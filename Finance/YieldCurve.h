@@ -29,6 +29,12 @@ namespace Finance {
         virtual std::string GetName() const;
         
         virtual double YC(double t) const;
+        //  Batched version : dResults[i] = YC(dT[i]) with one call to the batched interpolation (dResults must not be dT)
+        virtual void YC(Utilities::ArrayView<const double> dT, Utilities::ArrayView<double> dResults) const;
+        
+        //  Bucketed sensitivities : dSensitivities[k] = derivative of YC(t) with respect to the rate of the pillar k, read on the 
+        //  sensitivities sSensitivities of the interpolation of this curve (pillars bumped with BumpValue)
+        virtual void YCSensitivities(const Utilities::Interp::InterExtrapolation1DSensitivities & sSensitivities, double t, Utilities::ArrayView<double> dSensitivities) const;
         
         virtual YieldCurve operator + (const YieldCurve & sYieldCurve);
         virtual YieldCurve operator = (double dValue);
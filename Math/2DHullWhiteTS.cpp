@@ -14,16 +14,8 @@
 namespace Maths {
     TwoDimHullWhiteTS::TwoDimHullWhiteTS(const Finance::TermStructure<double,double> & sTermStructure1, const Finance::TermStructure<double,double> & sTermStructure2)
     {
-		Finance::TermStructure <double, double> sTermStructureProduct, sTermStructure2_ ;
-        sTermStructureProduct = sTermStructure1;
-        //  Little trick to make it build
-        sTermStructure2_ = sTermStructure2;
-		sTermStructureProduct *= sTermStructure2_ ;
-		
-        //	Initialize data member of termstructure integral
-		
-		UValues_ = sTermStructureProduct.GetValues() ;
-		TVariables_ = sTermStructureProduct.GetVariables();
+        //  Product of the two volatilities evaluated on the union of their pillars in one pass (no copy of the inputs, no merge)
+        Finance::EvaluateTermStructure(sTermStructure1 * sTermStructure2, TVariables_, UValues_);
 	}
     
     TwoDimHullWhiteTS::~TwoDimHullWhiteTS()
@@ -52,7 +44,7 @@ namespace Maths {
 	{
         //  This function now computes \int_{T1}^{T2} \Gamma_1(u,S_1) \Gamma_2(u, S_2) du
         
-		std::vector<double> dTSVariables = GetVariables(), dTSValues = GetValues();
+		const std::vector<double> & dTSVariables = GetVariables(), & dTSValues = GetValues();
         //  if T1 and T2 are too close the integral should be 0
         //  A.H. 20.02.2012
         if (std::abs(dT1 - dT2) < 1e-07)
@@ -66,6 +58,15 @@ namespace Maths {
         {
 			return dTSValues[0] * TwoDimSubIntegral(dT1, dT2, dS1, dS2, dLambda1, dLambda2);
 		}
+		else if (dLambda1 + dLambda2 >= BETAOUTHRESHOLD)
+        {
+            //  The kernel is a combination of exponentials of u : four lookups in the cumulative tables of \int \sigma(u) exp(kappa u) du
+            double dExp1 = exp(-dLambda1 * dS1), dExp2 = exp(-dLambda2 * dS2);
+            return (ExpIntegral(0.0, dT1, dT2)
+                    - dExp1 * ExpIntegral(dLambda1, dT1, dT2)
+                    - dExp2 * ExpIntegral(dLambda2, dT1, dT2)
+                    + dExp1 * dExp2 * ExpIntegral(dLambda1 + dLambda2, dT1, dT2)) / (dLambda1 * dLambda2);
+        }
 		else 
         {
 			double dInf = 0.0, dSup = 0.0, dIntegral = 0.0 ;
@@ -76,8 +77,9 @@ namespace Maths {
 				dIntegral += dTSValues[0] * TwoDimSubIntegral(dT1, std::min(dTSVariables[0], dT2), dS1, dS2, dLambda1, dLambda2);
 			}
 			
-			// middle
-			for (std::size_t iTS = 1; iTS < iSize; ++iTS) 
+			// middle : from the interval of T1 (binary search)
+			std::size_t iFirst = std::upper_bound(dTSVariables.begin(), dTSVariables.end(), dT1) - dTSVariables.begin();
+			for (std::size_t iTS = std::max(iFirst, (std::size_t)1); iTS < iSize; ++iTS) 
             {
 				dInf = std::max(dTSVariables[iTS-1], dT1);
 				dSup = std::min(dTSVariables[iTS], dT2);
@@ -30,6 +30,7 @@ namespace Maths {
 		virtual double TwoDimSubIntegral(double dA, double dB, double dS1, double dS2, double dLambda1, double dLambda2) const ;
 		//  overloading the Integral method to compute the integrals of the sum
         //  This function now computes \int_{T1}^{T2} \Gamma_1(u,S_1) \Gamma_2(u, S_2) du (20/02/2013 A.H. bug fix)
+        //  O(log n) on the cumulative tables of ExpIntegral when lambda1 + lambda2 >= BETAOUTHRESHOLD
         virtual double Integral(double dT1, double dT2, double dS1, double dS2, double dLambda1, double dLambda2) const;
 		virtual double SubIntegral(double dA, double dB) const ;
     };
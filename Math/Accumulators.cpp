@@ -0,0 +1,431 @@
+//
+//  Accumulators.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Accumulators.h"
+#include "Constants.h"
+#include "Require.h"
+
+//  Number of values buffered by the t-digest for each unit of compression before merging them
+#define TDIGESTBUFFERFACTOR 5
+
+namespace Stats {
+
+    /////////////////////////////////////////////////////////
+    //
+    //  MeanVarianceAccumulator
+    //
+    /////////////////////////////////////////////////////////
+
+    MeanVarianceAccumulator::MeanVarianceAccumulator() : iCount_(0), dMean_(0.0), dSquares_(0.0)
+    {}
+
+    MeanVarianceAccumulator::~MeanVarianceAccumulator()
+    {}
+
+    void MeanVarianceAccumulator::Add(double dValue)
+    {
+        ++iCount_;
+        double dDelta = dValue - dMean_;
+        dMean_ += dDelta / iCount_;
+        dSquares_ += dDelta * (dValue - dMean_);
+    }
+
+    void MeanVarianceAccumulator::Add(Utilities::ArrayView<const double> dValues)
+    {
+        if (dValues.empty())
+        {
+            return;
+        }
+        MeanVarianceAccumulator sBlock;
+        sBlock.iCount_ = dValues.size();
+        double dMean = 0.0;
+        for (std::size_t i = 0 ; i < dValues.size() ; ++i)
+        {
+            dMean += dValues[i];
+        }
+        dMean /= dValues.size();
+        double dSquares = 0.0;
+        for (std::size_t i = 0 ; i < dValues.size() ; ++i)
+        {
+            dSquares += (dValues[i] - dMean) * (dValues[i] - dMean);
+        }
+        sBlock.dMean_ = dMean;
+        sBlock.dSquares_ = dSquares;
+        Merge(sBlock);
+    }
+
+    void MeanVarianceAccumulator::Merge(const MeanVarianceAccumulator & sOther)
+    {
+        if (sOther.iCount_ == 0)
+        {
+            return;
+        }
+        std::size_t iCount = iCount_ + sOther.iCount_;
+        double dDelta = sOther.dMean_ - dMean_;
+        dMean_ += dDelta * sOther.iCount_ / iCount;
+        dSquares_ += sOther.dSquares_ + dDelta * dDelta * iCount_ * sOther.iCount_ / iCount;
+        iCount_ = iCount;
+    }
+
+    double MeanVarianceAccumulator::GetVariance() const
+    {
+        return iCount_ > 1 ? dSquares_ / (iCount_ - 1) : 0.0;
+    }
+
+    double MeanVarianceAccumulator::GetStandardDeviation() const
+    {
+        return sqrt(GetVariance());
+    }
+
+    double MeanVarianceAccumulator::GetStandardError() const
+    {
+        return iCount_ > 0 ? sqrt(GetVariance() / iCount_) : 0.0;
+    }
+
+    /////////////////////////////////////////////////////////
+    //
+    //  CovarianceAccumulator
+    //
+    /////////////////////////////////////////////////////////
+
+    CovarianceAccumulator::CovarianceAccumulator(std::size_t iNVariables) :
+    iNVariables_(iNVariables),
+    iCount_(0),
+    dMeans_(iNVariables, 0.0),
+    dCoSquares_(iNVariables * iNVariables, 0.0),
+    dDeviations_(iNVariables, 0.0)
+    {}
+
+    CovarianceAccumulator::~CovarianceAccumulator()
+    {}
+
+    void CovarianceAccumulator::Add(Utilities::ArrayView<const double> dValues)
+    {
+        Utilities::require(dValues.size() == iNVariables_, "CovarianceAccumulator : wrong number of variables");
+        ++iCount_;
+        for (std::size_t i = 0 ; i < iNVariables_ ; ++i)
+        {
+            dDeviations_[i] = dValues[i] - dMeans_[i];
+            dMeans_[i] += dDeviations_[i] / iCount_;
+        }
+        //  (x_i - old mean_i) (x_j - new mean_j) = (x_i - old mean_i) (x_j - old mean_j) (n - 1) / n
+        double dFactor = (iCount_ - 1.0) / iCount_;
+        for (std::size_t i = 0 ; i < iNVariables_ ; ++i)
+        {
+            double dDeviation = dDeviations_[i] * dFactor;
+            for (std::size_t j = 0 ; j < iNVariables_ ; ++j)
+            {
+                dCoSquares_[i * iNVariables_ + j] += dDeviation * dDeviations_[j];
+            }
+        }
+    }
+
+    void CovarianceAccumulator::Add(const std::vector<double> & dValues)
+    {
+        Add(Utilities::ArrayView<const double>(dValues.empty() ? 0 : &dValues[0], dValues.size()));
+    }
+
+    void CovarianceAccumulator::Add(Utilities::MatrixView<const double> dValues)
+    {
+        Utilities::require(dValues.rows() == iNVariables_, "CovarianceAccumulator : wrong number of variables");
+        std::size_t iNObservations = dValues.columns();
+        if (iNObservations == 0)
+        {
+            return;
+        }
+        CovarianceAccumulator sBlock(iNVariables_);
+        sBlock.iCount_ = iNObservations;
+        for (std::size_t i = 0 ; i < iNVariables_ ; ++i)
+        {
+            Utilities::ArrayView<const double> dVariable = dValues[i];
+            double dMean = 0.0;
+            for (std::size_t iObservation = 0 ; iObservation < iNObservations ; ++iObservation)
+            {
+                dMean += dVariable[iObservation];
+            }
+            sBlock.dMeans_[i] = dMean / iNObservations;
+        }
+        for (std::size_t i = 0 ; i < iNVariables_ ; ++i)
+        {
+            Utilities::ArrayView<const double> dVariable1 = dValues[i];
+            for (std::size_t j = i ; j < iNVariables_ ; ++j)
+            {
+                Utilities::ArrayView<const double> dVariable2 = dValues[j];
+                double dCoSquares = 0.0;
+                for (std::size_t iObservation = 0 ; iObservation < iNObservations ; ++iObservation)
+                {
+                    dCoSquares += (dVariable1[iObservation] - sBlock.dMeans_[i]) * (dVariable2[iObservation] - sBlock.dMeans_[j]);
+                }
+                sBlock.dCoSquares_[i * iNVariables_ + j] = dCoSquares;
+                sBlock.dCoSquares_[j * iNVariables_ + i] = dCoSquares;
+            }
+        }
+        Merge(sBlock);
+    }
+
+    void CovarianceAccumulator::Merge(const CovarianceAccumulator & sOther)
+    {
+        Utilities::require(sOther.iNVariables_ == iNVariables_, "CovarianceAccumulator : wrong number of variables");
+        if (sOther.iCount_ == 0)
+        {
+            return;
+        }
+        std::size_t iCount = iCount_ + sOther.iCount_;
+        double dFactor = static_cast<double>(iCount_) * sOther.iCount_ / iCount;
+        for (std::size_t i = 0 ; i < iNVariables_ ; ++i)
+        {
+            dDeviations_[i] = sOther.dMeans_[i] - dMeans_[i];
+        }
+        for (std::size_t i = 0 ; i < iNVariables_ ; ++i)
+        {
+            for (std::size_t j = 0 ; j < iNVariables_ ; ++j)
+            {
+                dCoSquares_[i * iNVariables_ + j] += sOther.dCoSquares_[i * iNVariables_ + j] + dDeviations_[i] * dDeviations_[j] * dFactor;
+            }
+            dMeans_[i] += dDeviations_[i] * sOther.iCount_ / iCount;
+        }
+        iCount_ = iCount;
+    }
+
+    double CovarianceAccumulator::GetCovariance(std::size_t i, std::size_t j) const
+    {
+        return iCount_ > 1 ? dCoSquares_[i * iNVariables_ + j] / (iCount_ - 1) : 0.0;
+    }
+
+    double CovarianceAccumulator::GetVariance(std::size_t i) const
+    {
+        return GetCovariance(i, i);
+    }
+
+    double CovarianceAccumulator::GetCorrelation(std::size_t i, std::size_t j) const
+    {
+        double dVariances = GetVariance(i) * GetVariance(j);
+        return dVariances > 0.0 ? GetCovariance(i, j) / sqrt(dVariances) : 0.0;
+    }
+
+    /////////////////////////////////////////////////////////
+    //
+    //  TDigest
+    //
+    /////////////////////////////////////////////////////////
+
+    namespace {
+
+        //  Scale function k_1 of the t-digest and its inverse : a centroid can not spread over more than one unit of k
+        double ScaleK(double dProbability, double dCompression)
+        {
+            return dCompression / (2.0 * PI) * asin(2.0 * dProbability - 1.0);
+        }
+
+        double InverseScaleK(double dK, double dCompression)
+        {
+            return dK >= 0.25 * dCompression ? 1.0 : 0.5 * (sin(2.0 * PI * dK / dCompression) + 1.0);
+        }
+    }
+
+    TDigest::TDigest(double dCompression) :
+    dCompression_(dCompression),
+    dTotalWeight_(0.0),
+    dBufferWeight_(0.0),
+    dMin_(std::numeric_limits<double>::max()),
+    dMax_(-std::numeric_limits<double>::max())
+    {
+        Utilities::require(dCompression > 0.0, "TDigest : compression has to be positive");
+    }
+
+    TDigest::~TDigest()
+    {}
+
+    void TDigest::Add(double dValue)
+    {
+        dBuffer_.push_back(std::make_pair(dValue, 1.0));
+        dBufferWeight_ += 1.0;
+        dMin_ = std::min(dMin_, dValue);
+        dMax_ = std::max(dMax_, dValue);
+        if (dBuffer_.size() >= TDIGESTBUFFERFACTOR * dCompression_)
+        {
+            Compress();
+        }
+    }
+
+    void TDigest::Add(Utilities::ArrayView<const double> dValues)
+    {
+        for (std::size_t i = 0 ; i < dValues.size() ; ++i)
+        {
+            Add(dValues[i]);
+        }
+    }
+
+    void TDigest::Merge(const TDigest & sOther)
+    {
+        //  The centroids of the other digest are merged with ours as weighted values
+        dBuffer_.insert(dBuffer_.end(), sOther.dCentroids_.begin(), sOther.dCentroids_.end());
+        dBuffer_.insert(dBuffer_.end(), sOther.dBuffer_.begin(), sOther.dBuffer_.end());
+        dBufferWeight_ += sOther.dTotalWeight_ + sOther.dBufferWeight_;
+        dMin_ = std::min(dMin_, sOther.dMin_);
+        dMax_ = std::max(dMax_, sOther.dMax_);
+        Compress();
+    }
+
+    void TDigest::Compress()
+    {
+        if (dBuffer_.empty())
+        {
+            return;
+        }
+        std::vector<std::pair<double, double> > dPoints;
+        dPoints.reserve(dCentroids_.size() + dBuffer_.size());
+        dPoints.insert(dPoints.end(), dCentroids_.begin(), dCentroids_.end());
+        dPoints.insert(dPoints.end(), dBuffer_.begin(), dBuffer_.end());
+        dTotalWeight_ += dBufferWeight_;
+        dBuffer_.clear();
+        dBufferWeight_ = 0.0;
+        std::sort(dPoints.begin(), dPoints.end());
+
+        //  Greedy merge of consecutive points while the centroid spreads over less than one unit of the scale function
+        dCentroids_.clear();
+        std::pair<double, double> sCurrent = dPoints[0];
+        double dWeightBefore = 0.0, dWeightLimit = dTotalWeight_ * InverseScaleK(ScaleK(0.0, dCompression_) + 1.0, dCompression_);
+        for (std::size_t i = 1 ; i < dPoints.size() ; ++i)
+        {
+            double dWeight = sCurrent.second + dPoints[i].second;
+            if (dWeightBefore + dWeight <= dWeightLimit)
+            {
+                sCurrent.first += (dPoints[i].first - sCurrent.first) * dPoints[i].second / dWeight;
+                sCurrent.second = dWeight;
+            }
+            else
+            {
+                dWeightBefore += sCurrent.second;
+                dCentroids_.push_back(sCurrent);
+                dWeightLimit = dTotalWeight_ * InverseScaleK(ScaleK(dWeightBefore / dTotalWeight_, dCompression_) + 1.0, dCompression_);
+                sCurrent = dPoints[i];
+            }
+        }
+        dCentroids_.push_back(sCurrent);
+    }
+
+    double TDigest::Quantile(double dProbability) const
+    {
+        Utilities::require(0.0 <= dProbability && dProbability <= 1.0, "TDigest : probability has to be in [0,1]");
+        if (!dBuffer_.empty())
+        {
+            TDigest sCompressed(*this);
+            sCompressed.Compress();
+            return sCompressed.Quantile(dProbability);
+        }
+        Utilities::require(!dCentroids_.empty(), "TDigest : no value");
+
+        //  Linear interpolation between the centers of the centroids (the minimum and the maximum at both ends)
+        double dTarget = dProbability * dTotalWeight_;
+        double dCenter = 0.5 * dCentroids_[0].second;
+        if (dTarget <= dCenter)
+        {
+            return dCenter > 0.5 ? dMin_ + (dCentroids_[0].first - dMin_) * (dTarget / dCenter) : dCentroids_[0].first;
+        }
+        for (std::size_t i = 1 ; i < dCentroids_.size() ; ++i)
+        {
+            double dNextCenter = dCenter + 0.5 * (dCentroids_[i - 1].second + dCentroids_[i].second);
+            if (dTarget <= dNextCenter)
+            {
+                return dCentroids_[i - 1].first + (dCentroids_[i].first - dCentroids_[i - 1].first) * (dTarget - dCenter) / (dNextCenter - dCenter);
+            }
+            dCenter = dNextCenter;
+        }
+        double dLastHalf = dTotalWeight_ - dCenter;
+        return dLastHalf > 0.5 ? dCentroids_.back().first + (dMax_ - dCentroids_.back().first) * ((dTarget - dCenter) / dLastHalf) : dCentroids_.back().first;
+    }
+
+    /////////////////////////////////////////////////////////
+    //
+    //  Histogram
+    //
+    /////////////////////////////////////////////////////////
+
+    Histogram::Histogram(double dLower, double dUpper, std::size_t iNBuckets) :
+    dLower_(dLower),
+    dUpper_(dUpper),
+    dWidth_((dUpper - dLower) / iNBuckets),
+    iCounts_(iNBuckets, 0),
+    iUnderflow_(0),
+    iOverflow_(0)
+    {
+        Utilities::require(iNBuckets > 0 && dUpper > dLower, "Histogram : empty range");
+    }
+
+    Histogram::~Histogram()
+    {}
+
+    void Histogram::Add(double dValue)
+    {
+        if (dValue < dLower_)
+        {
+            ++iUnderflow_;
+        }
+        else if (dValue >= dUpper_)
+        {
+            ++iOverflow_;
+        }
+        else
+        {
+            //  Rounding may give the last bucket + 1 for values close to dUpper_
+            ++iCounts_[std::min(static_cast<std::size_t>((dValue - dLower_) / dWidth_), iCounts_.size() - 1)];
+        }
+    }
+
+    void Histogram::Add(Utilities::ArrayView<const double> dValues)
+    {
+        for (std::size_t i = 0 ; i < dValues.size() ; ++i)
+        {
+            Add(dValues[i]);
+        }
+    }
+
+    void Histogram::Merge(const Histogram & sOther)
+    {
+        Utilities::require(sOther.dLower_ == dLower_ && sOther.dUpper_ == dUpper_ && sOther.iCounts_.size() == iCounts_.size(), "Histogram : different buckets");
+        for (std::size_t iBucket = 0 ; iBucket < iCounts_.size() ; ++iBucket)
+        {
+            iCounts_[iBucket] += sOther.iCounts_[iBucket];
+        }
+        iUnderflow_ += sOther.iUnderflow_;
+        iOverflow_ += sOther.iOverflow_;
+    }
+
+    std::size_t Histogram::GetTotalCount() const
+    {
+        std::size_t iTotal = iUnderflow_ + iOverflow_;
+        for (std::size_t iBucket = 0 ; iBucket < iCounts_.size() ; ++iBucket)
+        {
+            iTotal += iCounts_[iBucket];
+        }
+        return iTotal;
+    }
+
+    double Histogram::Quantile(double dProbability) const
+    {
+        Utilities::require(0.0 <= dProbability && dProbability <= 1.0, "Histogram : probability has to be in [0,1]");
+        double dTarget = dProbability * GetTotalCount(), dCount = static_cast<double>(iUnderflow_);
+        if (dTarget <= dCount)
+        {
+            return dLower_;
+        }
+        for (std::size_t iBucket = 0 ; iBucket < iCounts_.size() ; ++iBucket)
+        {
+            if (iCounts_[iBucket] > 0 && dTarget <= dCount + iCounts_[iBucket])
+            {
+                return GetBucketLower(iBucket) + dWidth_ * (dTarget - dCount) / iCounts_[iBucket];
+            }
+            dCount += iCounts_[iBucket];
+        }
+        return dUpper_;
+    }
+}
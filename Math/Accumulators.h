@@ -0,0 +1,204 @@
+//
+//  Accumulators.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_Accumulators_h
+#define Seminaire_Accumulators_h
+
+#include <vector>
+#include <utility>
+#include "ArrayView.h"
+
+//  Streaming statistics : the data are seen once and never stored
+//  Each accumulator can merge the accumulator of another part of the data (another thread, another block of paths, ...) : merging the
+//  partial accumulators in a fixed order gives the same result whatever the number of threads
+
+namespace Stats {
+
+    //  Count, mean and variance (Welford's update, Chan's merge)
+    class MeanVarianceAccumulator
+    {
+    public:
+        MeanVarianceAccumulator();
+        virtual ~MeanVarianceAccumulator();
+
+        void Add(double dValue);
+        //  Two-pass mean and variance of the block, then merge
+        void Add(Utilities::ArrayView<const double> dValues);
+        void Merge(const MeanVarianceAccumulator & sOther);
+
+        std::size_t GetCount() const
+        {
+            return iCount_;
+        }
+
+        double GetMean() const
+        {
+            return dMean_;
+        }
+
+        //  Unbiased variance (0 with less than two values)
+        double GetVariance() const;
+        double GetStandardDeviation() const;
+        //  Standard deviation of the mean
+        double GetStandardError() const;
+
+    private:
+        std::size_t iCount_;
+        double dMean_;
+        //  Sum of the squared deviations to the mean
+        double dSquares_;
+    };
+
+    //  Means and covariance matrix of iNVariables variables observed together
+    class CovarianceAccumulator
+    {
+    public:
+        CovarianceAccumulator(std::size_t iNVariables);
+        virtual ~CovarianceAccumulator();
+
+        //  One observation of the iNVariables variables
+        void Add(Utilities::ArrayView<const double> dValues);
+        void Add(const std::vector<double> & dValues);
+        //  Block of observations dValues[iVariable][iObservation] : two-pass means and co-squares of the block, then merge
+        void Add(Utilities::MatrixView<const double> dValues);
+        void Merge(const CovarianceAccumulator & sOther);
+
+        std::size_t GetNbVariables() const
+        {
+            return iNVariables_;
+        }
+
+        std::size_t GetCount() const
+        {
+            return iCount_;
+        }
+
+        double GetMean(std::size_t i) const
+        {
+            return dMeans_[i];
+        }
+
+        //  Unbiased covariance of the variables i and j
+        double GetCovariance(std::size_t i, std::size_t j) const;
+        double GetVariance(std::size_t i) const;
+        double GetCorrelation(std::size_t i, std::size_t j) const;
+
+    private:
+        std::size_t iNVariables_;
+        std::size_t iCount_;
+        std::vector<double> dMeans_;
+        //  Sums of the cross products of the deviations to the means (row-major)
+        std::vector<double> dCoSquares_;
+        std::vector<double> dDeviations_;
+    };
+
+    //  Quantiles with a merging t-digest (Dunning & Ertl, "Computing extremely accurate quantiles using t-digests", 2019)
+    //  The values are summarized by at most about dCompression weighted centroids, which are smaller in the tails so that the extreme
+    //  quantiles stay accurate
+    class TDigest
+    {
+    public:
+        TDigest(double dCompression = 100.0);
+        virtual ~TDigest();
+
+        void Add(double dValue);
+        void Add(Utilities::ArrayView<const double> dValues);
+        void Merge(const TDigest & sOther);
+
+        //  Merge the buffered values in the centroids
+        void Compress();
+
+        //  Quantile of probability dProbability in [0,1]
+        double Quantile(double dProbability) const;
+
+        double GetCount() const
+        {
+            return dTotalWeight_ + dBufferWeight_;
+        }
+
+        double GetMin() const
+        {
+            return dMin_;
+        }
+
+        double GetMax() const
+        {
+            return dMax_;
+        }
+
+        std::size_t GetNbCentroids() const
+        {
+            return dCentroids_.size();
+        }
+
+    private:
+        double dCompression_;
+        //  (mean, weight) sorted by mean
+        std::vector<std::pair<double, double> > dCentroids_;
+        double dTotalWeight_;
+        //  Values (or centroids of merged digests) not merged yet in the centroids, and their weight
+        std::vector<std::pair<double, double> > dBuffer_;
+        double dBufferWeight_;
+        double dMin_, dMax_;
+    };
+
+    //  Counts of the values in iNBuckets buckets of the same width between dLower and dUpper (plus the values below and above)
+    class Histogram
+    {
+    public:
+        Histogram(double dLower, double dUpper, std::size_t iNBuckets);
+        virtual ~Histogram();
+
+        void Add(double dValue);
+        void Add(Utilities::ArrayView<const double> dValues);
+        //  The histograms must have the same buckets
+        void Merge(const Histogram & sOther);
+
+        std::size_t GetNbBuckets() const
+        {
+            return iCounts_.size();
+        }
+
+        double GetBucketLower(std::size_t iBucket) const
+        {
+            return dLower_ + iBucket * dWidth_;
+        }
+
+        double GetBucketUpper(std::size_t iBucket) const
+        {
+            return dLower_ + (iBucket + 1) * dWidth_;
+        }
+
+        std::size_t GetCount(std::size_t iBucket) const
+        {
+            return iCounts_[iBucket];
+        }
+
+        std::size_t GetUnderflow() const
+        {
+            return iUnderflow_;
+        }
+
+        std::size_t GetOverflow() const
+        {
+            return iOverflow_;
+        }
+
+        std::size_t GetTotalCount() const;
+
+        //  Quantile interpolated linearly in its bucket (the bounds of the histogram if it is below or above)
+        double Quantile(double dProbability) const;
+
+    private:
+        double dLower_, dUpper_, dWidth_;
+        std::vector<std::size_t> iCounts_;
+        std::size_t iUnderflow_, iOverflow_;
+    };
+}
+
+#endif
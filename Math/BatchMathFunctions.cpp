@@ -0,0 +1,600 @@
+//
+//  BatchMathFunctions.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include "BatchMathFunctions.h"
+#include "MathFunctions.h"
+#include "CPUFeatures.h"
+#include "Require.h"
+
+#ifdef SEMINAIRE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+//  Coefficients of the central region of Acklam's approximation (same as MathFunctions::InvCumNorm)
+#define ACKLAM_A1 -3.969683028665376e+01
+#define ACKLAM_A2  2.209460984245205e+02
+#define ACKLAM_A3 -2.759285104469687e+02
+#define ACKLAM_A4  1.383577518672690e+02
+#define ACKLAM_A5 -3.066479806614716e+01
+#define ACKLAM_A6  2.506628277459239e+00
+#define ACKLAM_B1 -5.447609879822406e+01
+#define ACKLAM_B2  1.615858368580409e+02
+#define ACKLAM_B3 -1.556989798598866e+02
+#define ACKLAM_B4  6.680131188771972e+01
+#define ACKLAM_B5 -1.328068155288572e+01
+#define ACKLAM_PLOW 0.02425
+#define ACKLAM_PHIGH (1 - ACKLAM_PLOW)
+
+//  Vectorized exponential : exp(x) = 2^k exp(r) with k = round(x / ln 2) and r = x - k ln 2 (Cody-Waite split of ln 2, k ln2_HI is exact),
+//  exp(r) by its Taylor polynomial of degree 13 on |r| <= ln 2 / 2 (truncation below 1e-17)
+#define EXP_LOG2E 1.4426950408889634074
+#define EXP_LN2_HI 6.93145751953125e-01
+#define EXP_LN2_LO 1.42860682030941723212e-06
+//  1.5 * 2^52 : n + EXP_MAGIC holds the integer n in the low bits of its mantissa
+#define EXP_MAGIC 6755399441055744.0
+
+//  Vectorized logarithm : log(x) = e ln 2 + log(m) with m in [sqrt(1/2), sqrt(2)], log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.172,
+//  by its series up to s^23 (truncation below 1e-18)
+#define LOG_SQRT2 1.41421356237309504880
+
+//  Arguments of West's approximation (same as MathFunctions::AccCumNorm)
+#define WEST_TAIL 7.07106781186547
+#define WEST_CUTOFF 37.0
+#define WEST_SQRT2PI 2.506628274631
+
+//  1 / sqrt(2 pi) for the gaussian density
+#define INVSQRT2PI 0.39894228040143267794
+
+namespace MathFunctions {
+    
+    namespace {
+        
+        void InvCumNormScalar(const double * p, double * x, std::size_t iN)
+        {
+            for (std::size_t i = 0 ; i < iN ; ++i)
+            {
+                x[i] = InvCumNorm(p[i]);
+            }
+        }
+        
+#ifdef SEMINAIRE_X86_SIMD
+        SEMINAIRE_TARGET("avx2")
+        std::size_t InvCumNormAVX2(const double * p, double * x, std::size_t iN)
+        {
+            const __m256d dLow = _mm256_set1_pd(ACKLAM_PLOW), dHigh = _mm256_set1_pd(ACKLAM_PHIGH), dHalf = _mm256_set1_pd(0.5), dOne = _mm256_set1_pd(1.0);
+            std::size_t i = 0;
+            for ( ; i + 4 <= iN ; i += 4)
+            {
+                __m256d dP = _mm256_loadu_pd(p + i);
+                __m256d q = _mm256_sub_pd(dP, dHalf), r = _mm256_mul_pd(q, q);
+                
+                __m256d dNum = _mm256_set1_pd(ACKLAM_A1);
+                dNum = _mm256_add_pd(_mm256_mul_pd(dNum, r), _mm256_set1_pd(ACKLAM_A2));
+                dNum = _mm256_add_pd(_mm256_mul_pd(dNum, r), _mm256_set1_pd(ACKLAM_A3));
+                dNum = _mm256_add_pd(_mm256_mul_pd(dNum, r), _mm256_set1_pd(ACKLAM_A4));
+                dNum = _mm256_add_pd(_mm256_mul_pd(dNum, r), _mm256_set1_pd(ACKLAM_A5));
+                dNum = _mm256_add_pd(_mm256_mul_pd(dNum, r), _mm256_set1_pd(ACKLAM_A6));
+                
+                __m256d dDen = _mm256_set1_pd(ACKLAM_B1);
+                dDen = _mm256_add_pd(_mm256_mul_pd(dDen, r), _mm256_set1_pd(ACKLAM_B2));
+                dDen = _mm256_add_pd(_mm256_mul_pd(dDen, r), _mm256_set1_pd(ACKLAM_B3));
+                dDen = _mm256_add_pd(_mm256_mul_pd(dDen, r), _mm256_set1_pd(ACKLAM_B4));
+                dDen = _mm256_add_pd(_mm256_mul_pd(dDen, r), _mm256_set1_pd(ACKLAM_B5));
+                dDen = _mm256_add_pd(_mm256_mul_pd(dDen, r), dOne);
+                
+                __m256d dCentral = _mm256_and_pd(_mm256_cmp_pd(dP, dLow, _CMP_GE_OQ), _mm256_cmp_pd(dP, dHigh, _CMP_LE_OQ));
+                int iCentral = _mm256_movemask_pd(dCentral);
+                
+                if (iCentral != 0xF)
+                {
+                    //  About 5% of the draws are in the tails : computed in scalar (p may be the same buffer as x)
+                    double dTail[4], dResult[4];
+                    _mm256_storeu_pd(dTail, dP);
+                    _mm256_storeu_pd(dResult, _mm256_div_pd(_mm256_mul_pd(dNum, q), dDen));
+                    for (std::size_t iLane = 0 ; iLane < 4 ; ++iLane)
+                    {
+                        x[i + iLane] = iCentral & (1 << iLane) ? dResult[iLane] : InvCumNorm(dTail[iLane]);
+                    }
+                }
+                else
+                {
+                    _mm256_storeu_pd(x + i, _mm256_div_pd(_mm256_mul_pd(dNum, q), dDen));
+                }
+            }
+            return i;
+        }
+        
+        SEMINAIRE_TARGET("avx512f")
+        std::size_t InvCumNormAVX512(const double * p, double * x, std::size_t iN)
+        {
+            const __m512d dLow = _mm512_set1_pd(ACKLAM_PLOW), dHigh = _mm512_set1_pd(ACKLAM_PHIGH), dHalf = _mm512_set1_pd(0.5), dOne = _mm512_set1_pd(1.0);
+            std::size_t i = 0;
+            for ( ; i + 8 <= iN ; i += 8)
+            {
+                __m512d dP = _mm512_loadu_pd(p + i);
+                __m512d q = _mm512_sub_pd(dP, dHalf), r = _mm512_mul_pd(q, q);
+                
+                __m512d dNum = _mm512_set1_pd(ACKLAM_A1);
+                dNum = _mm512_add_pd(_mm512_mul_pd(dNum, r), _mm512_set1_pd(ACKLAM_A2));
+                dNum = _mm512_add_pd(_mm512_mul_pd(dNum, r), _mm512_set1_pd(ACKLAM_A3));
+                dNum = _mm512_add_pd(_mm512_mul_pd(dNum, r), _mm512_set1_pd(ACKLAM_A4));
+                dNum = _mm512_add_pd(_mm512_mul_pd(dNum, r), _mm512_set1_pd(ACKLAM_A5));
+                dNum = _mm512_add_pd(_mm512_mul_pd(dNum, r), _mm512_set1_pd(ACKLAM_A6));
+                
+                __m512d dDen = _mm512_set1_pd(ACKLAM_B1);
+                dDen = _mm512_add_pd(_mm512_mul_pd(dDen, r), _mm512_set1_pd(ACKLAM_B2));
+                dDen = _mm512_add_pd(_mm512_mul_pd(dDen, r), _mm512_set1_pd(ACKLAM_B3));
+                dDen = _mm512_add_pd(_mm512_mul_pd(dDen, r), _mm512_set1_pd(ACKLAM_B4));
+                dDen = _mm512_add_pd(_mm512_mul_pd(dDen, r), _mm512_set1_pd(ACKLAM_B5));
+                dDen = _mm512_add_pd(_mm512_mul_pd(dDen, r), dOne);
+                
+                __mmask8 iCentral = _mm512_cmp_pd_mask(dP, dLow, _CMP_GE_OQ) & _mm512_cmp_pd_mask(dP, dHigh, _CMP_LE_OQ);
+                
+                if (iCentral != 0xFF)
+                {
+                    double dTail[8], dResult[8];
+                    _mm512_storeu_pd(dTail, dP);
+                    _mm512_storeu_pd(dResult, _mm512_div_pd(_mm512_mul_pd(dNum, q), dDen));
+                    for (std::size_t iLane = 0 ; iLane < 8 ; ++iLane)
+                    {
+                        x[i + iLane] = iCentral & (1 << iLane) ? dResult[iLane] : InvCumNorm(dTail[iLane]);
+                    }
+                }
+                else
+                {
+                    _mm512_storeu_pd(x + i, _mm512_div_pd(_mm512_mul_pd(dNum, q), dDen));
+                }
+            }
+            return i;
+        }
+#endif
+        
+        void AccCumNormScalar(const double * x, double * y, std::size_t iN)
+        {
+            for (std::size_t i = 0 ; i < iN ; ++i)
+            {
+                y[i] = AccCumNorm(x[i]);
+            }
+        }
+        
+        //  dPhi = 1 for a call, -1 for a put ; the greeks are only computed if pDeltas is not null
+        void BlackScholesScalar(const double * pForwards, const double * pStrikes, const double * pStdDevs, double dPhi, double * pPrices,
+                                double * pDeltas, double * pVegas, double * pGammas, std::size_t iN)
+        {
+            for (std::size_t i = 0 ; i < iN ; ++i)
+            {
+                double dForward = pForwards[i], dStrike = pStrikes[i], dStdDev = pStdDevs[i];
+                double dPrice = 0.0, dDelta = 0.0, dVega = 0.0, dGamma = 0.0;
+                if (std::abs(dStrike) < 1e-10)
+                {
+                    dPrice = dPhi > 0.0 ? dForward : 0.0;
+                    dDelta = dPhi > 0.0 ? 1.0 : 0.0;
+                }
+                else if (std::abs(dStdDev) < 1e-10)
+                {
+                    dPrice = std::max(dPhi * (dForward - dStrike), 0.0);
+                    dDelta = dPrice > 0.0 ? dPhi : 0.0;
+                }
+                else
+                {
+                    double d1 = log(dForward / dStrike) / dStdDev + 0.5 * dStdDev, d2 = d1 - dStdDev;
+                    double dN1 = AccCumNorm(dPhi * d1);
+                    dPrice = dPhi * (dForward * dN1 - dStrike * AccCumNorm(dPhi * d2));
+                    if (pDeltas)
+                    {
+                        double dDensity = std::abs(d1) > WEST_CUTOFF ? 0.0 : exp(-std::abs(d1) * std::abs(d1) * 0.5) * INVSQRT2PI;
+                        dDelta = dPhi * dN1;
+                        dVega = dForward * dDensity;
+                        dGamma = dDensity / (dForward * dStdDev);
+                    }
+                }
+                pPrices[i] = dPrice;
+                if (pDeltas)
+                {
+                    pDeltas[i] = dDelta;
+                    pVegas[i] = dVega;
+                    pGammas[i] = dGamma;
+                }
+            }
+        }
+        
+#ifdef SEMINAIRE_X86_SIMD
+        SEMINAIRE_TARGET("avx2")
+        inline __m256d ExpAVX2(__m256d x)
+        {
+            x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-708.0)), _mm256_set1_pd(709.0));
+            __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(EXP_LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m256d r = _mm256_sub_pd(_mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(EXP_LN2_HI))), _mm256_mul_pd(k, _mm256_set1_pd(EXP_LN2_LO)));
+            
+            __m256d p = _mm256_set1_pd(1.0 / 6227020800.0);
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 479001600.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 39916800.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 3628800.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 362880.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 40320.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 5040.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 720.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 120.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 24.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0 / 6.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(0.5));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(1.0));
+            
+            //  2^k : k + 1023 in [1, 2046] shifted in the exponent field
+            __m256i iScale = _mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(_mm256_add_pd(k, _mm256_set1_pd(1023.0)), _mm256_set1_pd(EXP_MAGIC))), 52);
+            return _mm256_mul_pd(p, _mm256_castsi256_pd(iScale));
+        }
+        
+        //  Positive normal numbers only
+        SEMINAIRE_TARGET("avx2")
+        inline __m256d LogAVX2(__m256d x)
+        {
+            const __m256d dTwo52 = _mm256_set1_pd(4503599627370496.0), dOne = _mm256_set1_pd(1.0);
+            __m256i iBits = _mm256_castpd_si256(x);
+            //  Exponent field as a double (2^52 + e - 2^52) and mantissa in [1, 2[
+            __m256d e = _mm256_sub_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(iBits, 52), _mm256_castpd_si256(dTwo52))), dTwo52), _mm256_set1_pd(1023.0));
+            __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(iBits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)), _mm256_castpd_si256(dOne)));
+            __m256d dAbove = _mm256_cmp_pd(m, _mm256_set1_pd(LOG_SQRT2), _CMP_GT_OQ);
+            m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), dAbove);
+            e = _mm256_add_pd(e, _mm256_and_pd(dAbove, dOne));
+            
+            __m256d dS = _mm256_div_pd(_mm256_sub_pd(m, dOne), _mm256_add_pd(m, dOne)), dS2 = _mm256_mul_pd(dS, dS);
+            __m256d p = _mm256_set1_pd(1.0 / 23.0);
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 21.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 19.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 17.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 15.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 13.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 11.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 9.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 7.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 5.0));
+            p = _mm256_add_pd(_mm256_mul_pd(p, dS2), _mm256_set1_pd(1.0 / 3.0));
+            __m256d dLogM = _mm256_mul_pd(_mm256_add_pd(dS, dS), _mm256_add_pd(_mm256_mul_pd(p, dS2), dOne));
+            return _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(EXP_LN2_HI)), _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(EXP_LN2_LO)), dLogM));
+        }
+        
+        //  AccCumNorm(x), and exp(- x^2 / 2) in dExp (0 beyond the cut-off as in AccCumNorm)
+        SEMINAIRE_TARGET("avx2")
+        inline __m256d AccCumNormAVX2(__m256d x, __m256d & dExp)
+        {
+            const __m256d dSign = _mm256_set1_pd(-0.0), dZero = _mm256_setzero_pd();
+            __m256d a = _mm256_andnot_pd(dSign, x);
+            __m256d dInside = _mm256_cmp_pd(a, _mm256_set1_pd(WEST_CUTOFF), _CMP_LE_OQ);
+            dExp = _mm256_and_pd(dInside, ExpAVX2(_mm256_mul_pd(_mm256_mul_pd(_mm256_xor_pd(a, dSign), a), _mm256_set1_pd(0.5))));
+            
+            __m256d dBuild = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(3.52624965998911E-02), a), _mm256_set1_pd(0.700383064443688));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(6.37396220353165));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(33.912866078383));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(112.079291497871));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(221.213596169931));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(220.206867912376));
+            __m256d dRes = _mm256_mul_pd(dExp, dBuild);
+            
+            dBuild = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(8.83883476483184E-02), a), _mm256_set1_pd(1.75566716318264));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(16.064177579207));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(86.7807322029461));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(296.564248779674));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(637.333633378831));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(793.826512519948));
+            dBuild = _mm256_add_pd(_mm256_mul_pd(dBuild, a), _mm256_set1_pd(440.413735824752));
+            dRes = _mm256_div_pd(dRes, dBuild);
+            
+            //  Continued fraction in the tails (rare : only computed if a lane needs it)
+            __m256d dTail = _mm256_cmp_pd(a, _mm256_set1_pd(WEST_TAIL), _CMP_GE_OQ);
+            if (_mm256_movemask_pd(dTail) != 0)
+            {
+                dBuild = _mm256_add_pd(a, _mm256_set1_pd(0.65));
+                dBuild = _mm256_add_pd(a, _mm256_div_pd(_mm256_set1_pd(4.0), dBuild));
+                dBuild = _mm256_add_pd(a, _mm256_div_pd(_mm256_set1_pd(3.0), dBuild));
+                dBuild = _mm256_add_pd(a, _mm256_div_pd(_mm256_set1_pd(2.0), dBuild));
+                dBuild = _mm256_add_pd(a, _mm256_div_pd(_mm256_set1_pd(1.0), dBuild));
+                dRes = _mm256_blendv_pd(dRes, _mm256_div_pd(_mm256_div_pd(dExp, dBuild), _mm256_set1_pd(WEST_SQRT2PI)), dTail);
+            }
+            dRes = _mm256_and_pd(dInside, dRes);
+            return _mm256_blendv_pd(dRes, _mm256_sub_pd(_mm256_set1_pd(1.0), dRes), _mm256_cmp_pd(x, dZero, _CMP_GT_OQ));
+        }
+        
+        SEMINAIRE_TARGET("avx2")
+        std::size_t AccCumNormAVX2(const double * x, double * y, std::size_t iN)
+        {
+            std::size_t i = 0;
+            __m256d dExp;
+            for ( ; i + 4 <= iN ; i += 4)
+            {
+                _mm256_storeu_pd(y + i, AccCumNormAVX2(_mm256_loadu_pd(x + i), dExp));
+            }
+            return i;
+        }
+        
+        SEMINAIRE_TARGET("avx2")
+        std::size_t BlackScholesAVX2(const double * pForwards, const double * pStrikes, const double * pStdDevs, double dPhi, double * pPrices,
+                                     double * pDeltas, double * pVegas, double * pGammas, std::size_t iN)
+        {
+            const __m256d dSign = _mm256_set1_pd(-0.0), dZero = _mm256_setzero_pd(), dOne = _mm256_set1_pd(1.0), dEpsilon = _mm256_set1_pd(1e-10);
+            const __m256d dPhis = _mm256_set1_pd(dPhi), dCallOne = _mm256_set1_pd(dPhi > 0.0 ? 1.0 : 0.0);
+            std::size_t i = 0;
+            for ( ; i + 4 <= iN ; i += 4)
+            {
+                __m256d dForward = _mm256_loadu_pd(pForwards + i), dStrike = _mm256_loadu_pd(pStrikes + i), dStdDev = _mm256_loadu_pd(pStdDevs + i);
+                //  Degenerate lanes (zero strike or zero standard deviation) are computed on harmless values and replaced at the end
+                __m256d dZeroStrike = _mm256_cmp_pd(_mm256_andnot_pd(dSign, dStrike), dEpsilon, _CMP_LT_OQ);
+                __m256d dZeroStdDev = _mm256_andnot_pd(dZeroStrike, _mm256_cmp_pd(_mm256_andnot_pd(dSign, dStdDev), dEpsilon, _CMP_LT_OQ));
+                __m256d dDegenerate = _mm256_or_pd(dZeroStrike, dZeroStdDev);
+                __m256d dSafeStrike = _mm256_blendv_pd(dStrike, dForward, dDegenerate), dSafeStdDev = _mm256_blendv_pd(dStdDev, dOne, dDegenerate);
+                
+                __m256d d1 = _mm256_add_pd(_mm256_div_pd(LogAVX2(_mm256_div_pd(dForward, dSafeStrike)), dSafeStdDev), _mm256_mul_pd(_mm256_set1_pd(0.5), dSafeStdDev));
+                __m256d d2 = _mm256_sub_pd(d1, dSafeStdDev);
+                __m256d dExp1, dExp2;
+                __m256d dN1 = AccCumNormAVX2(_mm256_mul_pd(dPhis, d1), dExp1), dN2 = AccCumNormAVX2(_mm256_mul_pd(dPhis, d2), dExp2);
+                __m256d dPrice = _mm256_mul_pd(dPhis, _mm256_sub_pd(_mm256_mul_pd(dForward, dN1), _mm256_mul_pd(dSafeStrike, dN2)));
+                
+                __m256d dIntrinsic = _mm256_max_pd(_mm256_mul_pd(dPhis, _mm256_sub_pd(dForward, dStrike)), dZero);
+                dPrice = _mm256_blendv_pd(dPrice, dIntrinsic, dZeroStdDev);
+                dPrice = _mm256_blendv_pd(dPrice, _mm256_mul_pd(dCallOne, dForward), dZeroStrike);
+                _mm256_storeu_pd(pPrices + i, dPrice);
+                
+                if (pDeltas)
+                {
+                    __m256d dDensity = _mm256_mul_pd(dExp1, _mm256_set1_pd(INVSQRT2PI));
+                    __m256d dDelta = _mm256_mul_pd(dPhis, dN1);
+                    dDelta = _mm256_blendv_pd(dDelta, _mm256_and_pd(_mm256_cmp_pd(dIntrinsic, dZero, _CMP_GT_OQ), dPhis), dZeroStdDev);
+                    dDelta = _mm256_blendv_pd(dDelta, dCallOne, dZeroStrike);
+                    _mm256_storeu_pd(pDeltas + i, dDelta);
+                    _mm256_storeu_pd(pVegas + i, _mm256_blendv_pd(_mm256_mul_pd(dForward, dDensity), dZero, dDegenerate));
+                    _mm256_storeu_pd(pGammas + i, _mm256_blendv_pd(_mm256_div_pd(dDensity, _mm256_mul_pd(dForward, dSafeStdDev)), dZero, dDegenerate));
+                }
+            }
+            return i;
+        }
+        
+        //  Zero-masked forms with a full mask (_mm512_maskz_...) in the AVX-512 kernels : gcc implements the unmasked ones on an undefined
+        //  source register
+        SEMINAIRE_TARGET("avx512f")
+        inline __m512d ExpAVX512(__m512d x)
+        {
+            x = _mm512_maskz_min_pd(0xFF, _mm512_maskz_max_pd(0xFF, x, _mm512_set1_pd(-708.0)), _mm512_set1_pd(709.0));
+            __m512d k = _mm512_maskz_roundscale_pd(0xFF, _mm512_mul_pd(x, _mm512_set1_pd(EXP_LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m512d r = _mm512_sub_pd(_mm512_sub_pd(x, _mm512_mul_pd(k, _mm512_set1_pd(EXP_LN2_HI))), _mm512_mul_pd(k, _mm512_set1_pd(EXP_LN2_LO)));
+            
+            __m512d p = _mm512_set1_pd(1.0 / 6227020800.0);
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 479001600.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 39916800.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 3628800.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 362880.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 40320.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 5040.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 720.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 120.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 24.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0 / 6.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(0.5));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(1.0));
+            
+            __m512i iScale = _mm512_maskz_slli_epi64(0xFF, _mm512_castpd_si512(_mm512_add_pd(_mm512_add_pd(k, _mm512_set1_pd(1023.0)), _mm512_set1_pd(EXP_MAGIC))), 52);
+            return _mm512_mul_pd(p, _mm512_castsi512_pd(iScale));
+        }
+        
+        SEMINAIRE_TARGET("avx512f")
+        inline __m512d LogAVX512(__m512d x)
+        {
+            const __m512d dTwo52 = _mm512_set1_pd(4503599627370496.0), dOne = _mm512_set1_pd(1.0);
+            __m512i iBits = _mm512_castpd_si512(x);
+            __m512d e = _mm512_sub_pd(_mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_maskz_srli_epi64(0xFF, iBits, 52), _mm512_castpd_si512(dTwo52))), dTwo52), _mm512_set1_pd(1023.0));
+            __m512d m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(iBits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL)), _mm512_castpd_si512(dOne)));
+            __mmask8 iAbove = _mm512_cmp_pd_mask(m, _mm512_set1_pd(LOG_SQRT2), _CMP_GT_OQ);
+            m = _mm512_mask_mul_pd(m, iAbove, m, _mm512_set1_pd(0.5));
+            e = _mm512_mask_add_pd(e, iAbove, e, dOne);
+            
+            __m512d dS = _mm512_div_pd(_mm512_sub_pd(m, dOne), _mm512_add_pd(m, dOne)), dS2 = _mm512_mul_pd(dS, dS);
+            __m512d p = _mm512_set1_pd(1.0 / 23.0);
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 21.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 19.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 17.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 15.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 13.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 11.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 9.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 7.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 5.0));
+            p = _mm512_add_pd(_mm512_mul_pd(p, dS2), _mm512_set1_pd(1.0 / 3.0));
+            __m512d dLogM = _mm512_mul_pd(_mm512_add_pd(dS, dS), _mm512_add_pd(_mm512_mul_pd(p, dS2), dOne));
+            return _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(EXP_LN2_HI)), _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(EXP_LN2_LO)), dLogM));
+        }
+        
+        SEMINAIRE_TARGET("avx512f")
+        inline __m512d AccCumNormAVX512(__m512d x, __m512d & dExp)
+        {
+            const __m512d dZero = _mm512_setzero_pd();
+            __m512d a = _mm512_abs_pd(x);
+            __mmask8 iInside = _mm512_cmp_pd_mask(a, _mm512_set1_pd(WEST_CUTOFF), _CMP_LE_OQ);
+            dExp = _mm512_maskz_mov_pd(iInside, ExpAVX512(_mm512_mul_pd(_mm512_mul_pd(_mm512_sub_pd(dZero, a), a), _mm512_set1_pd(0.5))));
+            
+            __m512d dBuild = _mm512_add_pd(_mm512_mul_pd(_mm512_set1_pd(3.52624965998911E-02), a), _mm512_set1_pd(0.700383064443688));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(6.37396220353165));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(33.912866078383));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(112.079291497871));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(221.213596169931));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(220.206867912376));
+            __m512d dRes = _mm512_mul_pd(dExp, dBuild);
+            
+            dBuild = _mm512_add_pd(_mm512_mul_pd(_mm512_set1_pd(8.83883476483184E-02), a), _mm512_set1_pd(1.75566716318264));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(16.064177579207));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(86.7807322029461));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(296.564248779674));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(637.333633378831));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(793.826512519948));
+            dBuild = _mm512_add_pd(_mm512_mul_pd(dBuild, a), _mm512_set1_pd(440.413735824752));
+            dRes = _mm512_div_pd(dRes, dBuild);
+            
+            __mmask8 iTail = _mm512_cmp_pd_mask(a, _mm512_set1_pd(WEST_TAIL), _CMP_GE_OQ);
+            if (iTail != 0)
+            {
+                dBuild = _mm512_add_pd(a, _mm512_set1_pd(0.65));
+                dBuild = _mm512_add_pd(a, _mm512_div_pd(_mm512_set1_pd(4.0), dBuild));
+                dBuild = _mm512_add_pd(a, _mm512_div_pd(_mm512_set1_pd(3.0), dBuild));
+                dBuild = _mm512_add_pd(a, _mm512_div_pd(_mm512_set1_pd(2.0), dBuild));
+                dBuild = _mm512_add_pd(a, _mm512_div_pd(_mm512_set1_pd(1.0), dBuild));
+                dRes = _mm512_mask_mov_pd(dRes, iTail, _mm512_div_pd(_mm512_div_pd(dExp, dBuild), _mm512_set1_pd(WEST_SQRT2PI)));
+            }
+            dRes = _mm512_maskz_mov_pd(iInside, dRes);
+            return _mm512_mask_sub_pd(dRes, _mm512_cmp_pd_mask(x, dZero, _CMP_GT_OQ), _mm512_set1_pd(1.0), dRes);
+        }
+        
+        SEMINAIRE_TARGET("avx512f")
+        std::size_t AccCumNormAVX512(const double * x, double * y, std::size_t iN)
+        {
+            std::size_t i = 0;
+            __m512d dExp;
+            for ( ; i + 8 <= iN ; i += 8)
+            {
+                _mm512_storeu_pd(y + i, AccCumNormAVX512(_mm512_loadu_pd(x + i), dExp));
+            }
+            return i;
+        }
+        
+        SEMINAIRE_TARGET("avx512f")
+        std::size_t BlackScholesAVX512(const double * pForwards, const double * pStrikes, const double * pStdDevs, double dPhi, double * pPrices,
+                                       double * pDeltas, double * pVegas, double * pGammas, std::size_t iN)
+        {
+            const __m512d dZero = _mm512_setzero_pd(), dOne = _mm512_set1_pd(1.0), dEpsilon = _mm512_set1_pd(1e-10);
+            const __m512d dPhis = _mm512_set1_pd(dPhi), dCallOne = _mm512_set1_pd(dPhi > 0.0 ? 1.0 : 0.0);
+            std::size_t i = 0;
+            for ( ; i + 8 <= iN ; i += 8)
+            {
+                __m512d dForward = _mm512_loadu_pd(pForwards + i), dStrike = _mm512_loadu_pd(pStrikes + i), dStdDev = _mm512_loadu_pd(pStdDevs + i);
+                __mmask8 iZeroStrike = _mm512_cmp_pd_mask(_mm512_abs_pd(dStrike), dEpsilon, _CMP_LT_OQ);
+                __mmask8 iZeroStdDev = ~iZeroStrike & _mm512_cmp_pd_mask(_mm512_abs_pd(dStdDev), dEpsilon, _CMP_LT_OQ);
+                __mmask8 iDegenerate = iZeroStrike | iZeroStdDev;
+                __m512d dSafeStrike = _mm512_mask_mov_pd(dStrike, iDegenerate, dForward), dSafeStdDev = _mm512_mask_mov_pd(dStdDev, iDegenerate, dOne);
+                
+                __m512d d1 = _mm512_add_pd(_mm512_div_pd(LogAVX512(_mm512_div_pd(dForward, dSafeStrike)), dSafeStdDev), _mm512_mul_pd(_mm512_set1_pd(0.5), dSafeStdDev));
+                __m512d d2 = _mm512_sub_pd(d1, dSafeStdDev);
+                __m512d dExp1, dExp2;
+                __m512d dN1 = AccCumNormAVX512(_mm512_mul_pd(dPhis, d1), dExp1), dN2 = AccCumNormAVX512(_mm512_mul_pd(dPhis, d2), dExp2);
+                __m512d dPrice = _mm512_mul_pd(dPhis, _mm512_sub_pd(_mm512_mul_pd(dForward, dN1), _mm512_mul_pd(dSafeStrike, dN2)));
+                
+                __m512d dIntrinsic = _mm512_maskz_max_pd(0xFF, _mm512_mul_pd(dPhis, _mm512_sub_pd(dForward, dStrike)), dZero);
+                dPrice = _mm512_mask_mov_pd(dPrice, iZeroStdDev, dIntrinsic);
+                dPrice = _mm512_mask_mov_pd(dPrice, iZeroStrike, _mm512_mul_pd(dCallOne, dForward));
+                _mm512_storeu_pd(pPrices + i, dPrice);
+                
+                if (pDeltas)
+                {
+                    __m512d dDensity = _mm512_mul_pd(dExp1, _mm512_set1_pd(INVSQRT2PI));
+                    __m512d dDelta = _mm512_mul_pd(dPhis, dN1);
+                    dDelta = _mm512_mask_mov_pd(dDelta, iZeroStdDev, _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(dIntrinsic, dZero, _CMP_GT_OQ), dPhis));
+                    dDelta = _mm512_mask_mov_pd(dDelta, iZeroStrike, dCallOne);
+                    _mm512_storeu_pd(pDeltas + i, dDelta);
+                    _mm512_storeu_pd(pVegas + i, _mm512_maskz_mov_pd(~iDegenerate, _mm512_mul_pd(dForward, dDensity)));
+                    _mm512_storeu_pd(pGammas + i, _mm512_maskz_mov_pd(~iDegenerate, _mm512_div_pd(dDensity, _mm512_mul_pd(dForward, dSafeStdDev))));
+                }
+            }
+            return i;
+        }
+#endif
+    }
+    
+    void InvCumNorm(Utilities::ArrayView<const double> dProbabilities, Utilities::ArrayView<double> dResults)
+    {
+        Utilities::require(dProbabilities.size() == dResults.size(), "InvCumNorm : input and output sizes are not the same");
+        const double * p = dProbabilities.data();
+        double * x = dResults.data();
+        std::size_t iN = dProbabilities.size(), iDone = 0;
+        
+#ifdef SEMINAIRE_X86_SIMD
+        switch (Utilities::GetSIMDLevel())
+        {
+            case Utilities::SIMD_AVX512:
+                iDone = InvCumNormAVX512(p, x, iN);
+                break;
+            case Utilities::SIMD_AVX2:
+                iDone = InvCumNormAVX2(p, x, iN);
+                break;
+            default:
+                break;
+        }
+#endif
+        //  Remaining elements (and everything when no SIMD is available)
+        InvCumNormScalar(p + iDone, x + iDone, iN - iDone);
+    }
+    
+    void AccCumNorm(Utilities::ArrayView<const double> dX, Utilities::ArrayView<double> dResults)
+    {
+        Utilities::require(dX.size() == dResults.size(), "AccCumNorm : input and output sizes are not the same");
+        const double * x = dX.data();
+        double * y = dResults.data();
+        std::size_t iN = dX.size(), iDone = 0;
+        
+#ifdef SEMINAIRE_X86_SIMD
+        switch (Utilities::GetSIMDLevel())
+        {
+            case Utilities::SIMD_AVX512:
+                iDone = AccCumNormAVX512(x, y, iN);
+                break;
+            case Utilities::SIMD_AVX2:
+                iDone = AccCumNormAVX2(x, y, iN);
+                break;
+            default:
+                break;
+        }
+#endif
+        AccCumNormScalar(x + iDone, y + iDone, iN - iDone);
+    }
+    
+    namespace {
+        
+        void BlackScholes(const double * pForwards, const double * pStrikes, const double * pStdDevs, Finance::OptionType eOptionType, double * pPrices,
+                          double * pDeltas, double * pVegas, double * pGammas, std::size_t iN)
+        {
+            Utilities::require((eOptionType == Finance::CALL) || (eOptionType == Finance::PUT));
+            for (std::size_t i = 0 ; i < iN ; ++i)
+            {
+                Utilities::require(pForwards[i] > 0.0, "BlackScholes : non positive forward");
+            }
+            double dPhi = eOptionType == Finance::CALL ? 1.0 : -1.0;
+            std::size_t iDone = 0;
+            
+#ifdef SEMINAIRE_X86_SIMD
+            switch (Utilities::GetSIMDLevel())
+            {
+                case Utilities::SIMD_AVX512:
+                    iDone = BlackScholesAVX512(pForwards, pStrikes, pStdDevs, dPhi, pPrices, pDeltas, pVegas, pGammas, iN);
+                    break;
+                case Utilities::SIMD_AVX2:
+                    iDone = BlackScholesAVX2(pForwards, pStrikes, pStdDevs, dPhi, pPrices, pDeltas, pVegas, pGammas, iN);
+                    break;
+                default:
+                    break;
+            }
+#endif
+            BlackScholesScalar(pForwards + iDone, pStrikes + iDone, pStdDevs + iDone, dPhi, pPrices + iDone,
+                               pDeltas ? pDeltas + iDone : 0, pVegas ? pVegas + iDone : 0, pGammas ? pGammas + iDone : 0, iN - iDone);
+        }
+    }
+    
+    void BlackScholes(Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes, Utilities::ArrayView<const double> dStdDevs,
+                      Finance::OptionType eOptionType, Utilities::ArrayView<double> dPrices)
+    {
+        std::size_t iN = dForwards.size();
+        Utilities::require(dStrikes.size() == iN && dStdDevs.size() == iN && dPrices.size() == iN, "BlackScholes : input and output sizes are not the same");
+        BlackScholes(dForwards.data(), dStrikes.data(), dStdDevs.data(), eOptionType, dPrices.data(), 0, 0, 0, iN);
+    }
+    
+    void BlackScholes(Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes, Utilities::ArrayView<const double> dStdDevs,
+                      Finance::OptionType eOptionType, Utilities::ArrayView<double> dPrices, Utilities::ArrayView<double> dDeltas,
+                      Utilities::ArrayView<double> dVegas, Utilities::ArrayView<double> dGammas)
+    {
+        std::size_t iN = dForwards.size();
+        Utilities::require(dStrikes.size() == iN && dStdDevs.size() == iN && dPrices.size() == iN, "BlackScholes : input and output sizes are not the same");
+        Utilities::require(dDeltas.size() == iN && dVegas.size() == iN && dGammas.size() == iN, "BlackScholes : input and output sizes are not the same");
+        BlackScholes(dForwards.data(), dStrikes.data(), dStdDevs.data(), eOptionType, dPrices.data(), dDeltas.data(), dVegas.data(), dGammas.data(), iN);
+    }
+}
@@ -0,0 +1,39 @@
+//
+//  BatchMathFunctions.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_BatchMathFunctions_h
+#define Seminaire_BatchMathFunctions_h
+
+#include "ArrayView.h"
+#include "Option.h"
+
+//  Batched versions of the functions of MathFunctions.h
+//  Each function fills a caller-provided buffer (which may be the input buffer) with the same values as the scalar 
+//  function, using AVX2 / AVX-512 kernels when the CPU supports them (see CPUFeatures.h)
+//  The kernels of the functions built on exp and log use vectorized versions of them (reduction by ln 2 and polynomial), which may differ
+//  from the C library by an ulp : their results match the scalar functions to 1e-15
+
+namespace MathFunctions {
+    
+    //  Acklam's inverse normal cumulative distribution (central region vectorized, tails in scalar)
+    void InvCumNorm(Utilities::ArrayView<const double> dProbabilities, Utilities::ArrayView<double> dResults);
+    
+    //  West's cumulative normal distribution AccCumNorm
+    void AccCumNorm(Utilities::ArrayView<const double> dX, Utilities::ArrayView<double> dResults);
+    
+    //  Undiscounted Black-Scholes prices BlackScholes(dForwards[i], dStrikes[i], dStdDevs[i], eOptionType)
+    void BlackScholes(Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes, Utilities::ArrayView<const double> dStdDevs,
+                      Finance::OptionType eOptionType, Utilities::ArrayView<double> dPrices);
+    
+    //  Same prices and their sensitivities, computed on the same d1 and gaussian density : delta dP/dF, vega dP/dStdDev and gamma d2P/dF2
+    void BlackScholes(Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes, Utilities::ArrayView<const double> dStdDevs,
+                      Finance::OptionType eOptionType, Utilities::ArrayView<double> dPrices, Utilities::ArrayView<double> dDeltas,
+                      Utilities::ArrayView<double> dVegas, Utilities::ArrayView<double> dGammas);
+}
+
+#endif
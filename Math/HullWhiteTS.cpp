@@ -7,8 +7,10 @@
 //
 
 #include <iostream>
+#include <algorithm>
 #include "HullWhiteTS.h"
 #include "MathFunctions.h" // for BETAOUTHRESHOLD
+#include "Require.h"
 
 namespace Maths {
     HullWhiteTS::HullWhiteTS(const Finance::TermStructure<double,double> & sTermStructure, double dLambda) : TermStructureIntegral(sTermStructure), dLambda_(dLambda)
@@ -28,4 +30,23 @@ namespace Maths {
             return (exp(-dLambda_ * dA) - exp(-dLambda_ * dB)) / dLambda_;
         }
     }
+    
+    double HullWhiteTS::IteratedIntegral(double dt, double dT1, double dT2) const
+    {
+        Utilities::require(dt <= dT1 && dT1 <= dT2, "HullWhiteTS::IteratedIntegral : boundaries are not sorted");
+        //  Beyond T1 the weight is the constant T1 - t
+        double dResult = dT1 < dT2 ? (dT1 - dt) * Integral(dT1, dT2) : 0.0;
+        
+        //  Before T1, \int \sigma(u) exp(-lambda u) (u - t) du on each interval of constant sigma
+        double dLambda = dLambda_ < BETAOUTHRESHOLD ? 0.0 : -dLambda_;
+        const std::vector<double> & dTSVariables = GetVariables(), & dTSValues = GetValues();
+        std::size_t iTS = std::upper_bound(dTSVariables.begin(), dTSVariables.end(), dt) - dTSVariables.begin();
+        for (double dStart = dt ; dStart < dT1 ; ++iTS)
+        {
+            double dEnd = iTS < dTSVariables.size() ? std::min(dTSVariables[iTS], dT1) : dT1;
+            dResult += dTSValues[iTS > 0 ? iTS - 1 : 0] * MathFunctions::SumLinearExp(dLambda, dt, dStart, dEnd);
+            dStart = dEnd;
+        }
+        return dResult;
+    }
 }
\ No newline at end of file
@@ -22,6 +22,9 @@ namespace Maths {
         
         //  primitive of function f() define in the above integral
 		virtual double SubIntegral(double dA, double dB) const;
+        
+        //  \int_{t}^{T1} Integral(m, T2) dm = \int_{t}^{T2} \sigma(u) exp(-lambda u) (min(u, T1) - t) du for t <= T1 <= T2 (closed form on the pillars)
+        double IteratedIntegral(double dt, double dT1, double dT2) const;
     };
 }
 
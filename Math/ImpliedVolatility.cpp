@@ -0,0 +1,287 @@
+//
+//  ImpliedVolatility.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "ImpliedVolatility.h"
+#include "Constants.h"
+#include "MathFunctions.h"
+#include "BatchMathFunctions.h"
+#include "Require.h"
+
+namespace MathFunctions {
+
+    namespace {
+
+        //  Gaussian density
+        double Density(double x)
+        {
+            return exp(-0.5 * x * x) / sqrtpi(2.0);
+        }
+
+        //  Normalised out-of-the-money call b(x, s) = exp(x / 2) N(x / s + s / 2) - exp(- x / 2) N(x / s - s / 2) for x <= 0, and its
+        //  derivative in s exp(x / 2) phi(x / s + s / 2)
+        double NormalisedBlack(double x, double s)
+        {
+            return exp(0.5 * x) * AccCumNorm(x / s + 0.5 * s) - exp(-0.5 * x) * AccCumNorm(x / s - 0.5 * s);
+        }
+
+        double NormalisedVega(double x, double s)
+        {
+            return exp(0.5 * x) * Density(x / s + 0.5 * s);
+        }
+
+        //  Cubic Hermite interpolation of s(b) between (b0, s0) and (b1, s1) with the derivatives ds/db dSlope0 and dSlope1
+        double HermiteInterpolation(double b, double b0, double s0, double dSlope0, double b1, double s1, double dSlope1)
+        {
+            double h = b1 - b0, t = (b - b0) / h, t2 = t * t, t3 = t2 * t;
+            return (2.0 * t3 - 3.0 * t2 + 1.0) * s0 + (t3 - 2.0 * t2 + t) * h * dSlope0 + (3.0 * t2 - 2.0 * t3) * s1 + (t3 - t2) * h * dSlope1;
+        }
+
+        //  Initial guess of s such that b(x, s) = dBeta, for x <= 0 and 0 < dBeta < exp(x / 2)
+        //  The tangent of b at the inflection point s_c = sqrt(2 |x|) crosses 0 at s_l and b_max = exp(x / 2) at s_u :
+        //      below b(s_l) : lower asymptotic form b ~ 2 pi |x| / (3 sqrt(3)) N(- |x| / (sqrt(3) s))^3
+        //      between b(s_l) and b(s_u) : cubic interpolation of s(b) on [s_l, s_c] and [s_c, s_u]
+        //      above b(s_u) : upper asymptotic form b ~ b_max (1 - 2 N(- s / 2))
+        //  bLower : the target is below b(s_c)
+        double BlackInitialGuess(double x, double dBeta, bool & bLower)
+        {
+            double dMaxPrice = exp(0.5 * x);
+            if (x == 0.0)
+            {
+                bLower = false;
+                return -2.0 * InvCumNorm(0.5 * (dMaxPrice - dBeta) / dMaxPrice);
+            }
+
+            double dSC = sqrt(-2.0 * x), dBC = 0.5 * dMaxPrice - exp(-0.5 * x) * AccCumNorm(-dSC), dVegaC = dMaxPrice / sqrtpi(2.0);
+            double dSL = dSC - dBC / dVegaC, dSU = dSC + (dMaxPrice - dBC) / dVegaC;
+            double dBL = dSL > 0.0 ? NormalisedBlack(x, dSL) : 0.0, dBU = NormalisedBlack(x, dSU);
+            bLower = dBeta < dBC;
+            if (dBeta < dBL)
+            {
+                double q = pow(3.0 * sqrt(3.0) * dBeta / (-2.0 * PI * x), 1.0 / 3.0);
+                return q < 0.5 ? std::min(x / (sqrt(3.0) * InvCumNorm(q)), dSL) : dSL;
+            }
+            else if (dBeta < dBC)
+            {
+                double dSlopeL = dSL > 0.0 ? 1.0 / NormalisedVega(x, dSL) : 0.0;
+                return std::min(std::max(HermiteInterpolation(dBeta, dBL, dSL, dSlopeL, dBC, dSC, 1.0 / dVegaC), dSL), dSC);
+            }
+            else if (dBeta < dBU)
+            {
+                return std::min(std::max(HermiteInterpolation(dBeta, dBC, dSC, 1.0 / dVegaC, dBU, dSU, 1.0 / NormalisedVega(x, dSU)), dSC), dSU);
+            }
+            return -2.0 * InvCumNorm(0.5 * (dMaxPrice - dBeta) / dMaxPrice);
+        }
+
+        //  Normalised quote : x = - |log(F / K)| and the normalised out-of-the-money price dBeta (returned), checked against the bounds
+        double BlackNormalisedQuote(double dPrice, double dForward, double dStrike, double dPhi, double & x)
+        {
+            Utilities::require(dForward > 0.0 && dStrike > 0.0, "BlackScholesImpliedStdDev : non positive forward or strike");
+            x = -std::abs(log(dForward / dStrike));
+            double dIntrinsic = std::max(dPhi * (dForward - dStrike), 0.0), dBeta = (dPrice - dIntrinsic) / sqrt(dForward * dStrike);
+            Utilities::require(dPrice - dIntrinsic >= -IMPLIEDVOLINTRINSICTOLERANCE * dIntrinsic, "BlackScholesImpliedStdDev : price below the intrinsic value");
+            Utilities::require(dBeta < exp(0.5 * x), "BlackScholesImpliedStdDev : price above the forward (call) or the strike (put)");
+            return dBeta;
+        }
+
+        //  Householder step of order 4 on g(s) = log(v(s)) - log(target) with v = b or b_max - b = exp(x / 2) N(- d1) + exp(- x / 2) N(d2)
+        //  (no cancellation in the upper tail) : v'' / v' = x^2 / s^3 - s / 4 and v''' / v' = (v'' / v')^2 - 3 x^2 / s^4 - 1 / 4 as for b
+        //  dSign : -1 for b, 1 for b_max - b ; dCumulative1 = N(- dSign d1) and dCumulative2 = N(d1 - s)
+        double BlackHouseholderStep(double s, double x, double dExpHalfX, double dSign, double dLogTarget, double dCumulative1, double dCumulative2)
+        {
+            double d1 = x / s + 0.5 * s, v = dExpHalfX * dCumulative1 + dSign / dExpHalfX * dCumulative2;
+            if (v <= 0.0)
+            {
+                //  b(s) underflows : s is far too low
+                return s;
+            }
+            double dRatio = -dSign * dExpHalfX * Density(d1) / v;
+            double dX2S3 = x * x / (s * s * s), dH2 = dX2S3 - 0.25 * s, dH3 = dH2 * dH2 - 3.0 * dX2S3 / s - 0.25;
+            double dG2 = dH2 - dRatio, dG3 = dH3 - 3.0 * dH2 * dRatio + 2.0 * dRatio * dRatio;
+            double dNewton = -(log(v) - dLogTarget) / dRatio;
+            double dStep = dNewton * (1.0 + 0.5 * dG2 * dNewton) / (1.0 + dNewton * (dG2 + dG3 * dNewton / 6.0));
+            return std::max(dStep, -0.5 * s);
+        }
+
+        //  Rational approximation z~ of the inverse of the normalised out-of-the-money Bachelier price phi~* = N(z) + phi(z) / z < 0
+        double BachelierInitialGuess(double dPhiStar)
+        {
+            if (dPhiStar < -0.001882039271)
+            {
+                double g = 1.0 / (dPhiStar - 0.5), g2 = g * g;
+                double dXi = (0.032114372355 - g2 * (0.016969777977 - g2 * (2.6207332461e-3 - 9.6066952861e-5 * g2))) / (1.0 - g2 * (0.6635646938 - g2 * (0.14528712196 - 0.010472855461 * g2)));
+                return g * (1.0 / sqrtpi(2.0) + dXi * g2);
+            }
+            double h = sqrt(-log(-dPhiStar));
+            return (9.4883409779 - h * (9.6320903635 - h * (0.58556997323 + 2.1464093351 * h))) / (1.0 - h * (0.65174820867 + h * (1.5120247828 + 6.6437847132e-5 * h)));
+        }
+
+        //  One Householder iteration of order 4 on z, given dCumulative = N(z)
+        double BachelierHouseholder(double z, double dCumulative, double dPhiStar)
+        {
+            double z2 = z * z, dDensity = Density(z);
+            //  N(z) + phi(z) / z cancels in the tail : continued fraction of Bachelier
+            double dPhiTilde = z > -BACHELIERCONTINUEDFRACTIONTHRESHOLD ? dCumulative + dDensity / z : Bachelier(0.0, -z, 1.0, Finance::CALL) / z;
+            double q = (dPhiTilde - dPhiStar) / dDensity;
+            return z + 3.0 * q * z2 * (2.0 - q * z * (2.0 + z2)) / (6.0 + q * z * (-12.0 + z * (6.0 * q + z * (-6.0 + q * z * (3.0 + z2)))));
+        }
+    }
+
+    void BlackScholesImpliedStdDev(Utilities::ArrayView<const double> dPrices, Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes,
+                                   Finance::OptionType eOptionType, Utilities::ArrayView<double> dStdDevs)
+    {
+        Utilities::require((eOptionType == Finance::CALL) || (eOptionType == Finance::PUT));
+        std::size_t iN = dPrices.size();
+        Utilities::require(dForwards.size() == iN && dStrikes.size() == iN && dStdDevs.size() == iN, "BlackScholesImpliedStdDev : input and output sizes are not the same");
+        double dPhi = eOptionType == Finance::CALL ? 1.0 : -1.0;
+
+        //  Normalised quotes : x = - |log(F / K)|, exp(x / 2), log of the target of the objective (b or b_max - b) and sign of the second term
+        //  of the objective (-1 : b, 1 : b_max - b) ; the standard deviations are iterated in place
+        std::vector<double> dX(iN), dExpHalfX(iN), dLogTargets(iN), dSigns(iN);
+        std::vector<std::size_t> iActive;
+        iActive.reserve(iN);
+        for (std::size_t i = 0 ; i < iN ; ++i)
+        {
+            double x = 0.0, dBeta = BlackNormalisedQuote(dPrices[i], dForwards[i], dStrikes[i], dPhi, x);
+            if (dBeta <= 0.0)
+            {
+                dStdDevs[i] = 0.0;
+                continue;
+            }
+
+            bool bLower = true;
+            dStdDevs[i] = BlackInitialGuess(x, dBeta, bLower);
+            dX[i] = x;
+            dExpHalfX[i] = exp(0.5 * x);
+            dLogTargets[i] = log(bLower ? dBeta : dExpHalfX[i] - dBeta);
+            dSigns[i] = bLower ? -1.0 : 1.0;
+            iActive.push_back(i);
+        }
+
+        //  Householder iterations on the quotes not converged yet, with one batch of normal distributions per iteration
+        std::vector<double> dArguments, dCumulatives;
+        for (std::size_t iIteration = 0 ; iIteration < IMPLIEDVOLMAXITERATIONS && !iActive.empty() ; ++iIteration)
+        {
+            std::size_t iNActive = iActive.size();
+            dArguments.resize(2 * iNActive);
+            dCumulatives.resize(2 * iNActive);
+            for (std::size_t j = 0 ; j < iNActive ; ++j)
+            {
+                std::size_t i = iActive[j];
+                double s = dStdDevs[i], d1 = dX[i] / s + 0.5 * s;
+                dArguments[2 * j] = -dSigns[i] * d1;
+                dArguments[2 * j + 1] = d1 - s;
+            }
+            AccCumNorm(Utilities::ArrayView<const double>(&dArguments[0], 2 * iNActive), Utilities::ArrayView<double>(&dCumulatives[0], 2 * iNActive));
+
+            std::size_t iNNotConverged = 0;
+            for (std::size_t j = 0 ; j < iNActive ; ++j)
+            {
+                std::size_t i = iActive[j];
+                double dStep = BlackHouseholderStep(dStdDevs[i], dX[i], dExpHalfX[i], dSigns[i], dLogTargets[i], dCumulatives[2 * j], dCumulatives[2 * j + 1]);
+                dStdDevs[i] += dStep;
+                if (std::abs(dStep) > IMPLIEDVOLTOLERANCE * dStdDevs[i])
+                {
+                    iActive[iNNotConverged++] = i;
+                }
+            }
+            iActive.resize(iNNotConverged);
+        }
+        Utilities::require(iActive.empty(), "BlackScholesImpliedStdDev : no convergence");
+    }
+
+    void BachelierImpliedStdDev(Utilities::ArrayView<const double> dPrices, Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes,
+                                Finance::OptionType eOptionType, Utilities::ArrayView<double> dStdDevs)
+    {
+        Utilities::require((eOptionType == Finance::CALL) || (eOptionType == Finance::PUT));
+        std::size_t iN = dPrices.size();
+        Utilities::require(dForwards.size() == iN && dStrikes.size() == iN && dStdDevs.size() == iN, "BachelierImpliedStdDev : input and output sizes are not the same");
+        double dPhi = eOptionType == Finance::CALL ? 1.0 : -1.0;
+
+        //  Normalised out-of-the-money price phi~* = - beta / |x| = N(z) + phi(z) / z < 0 of z = - |x| / s, and the rational approximation
+        //  z~ of its inverse
+        std::vector<double> dMoneyness(iN), dNormalisedPrices(iN), dApproximations, dCumulatives;
+        std::vector<std::size_t> iQuotes;
+        dApproximations.reserve(iN);
+        iQuotes.reserve(iN);
+        for (std::size_t i = 0 ; i < iN ; ++i)
+        {
+            double x = dPhi * (dForwards[i] - dStrikes[i]), dIntrinsic = std::max(x, 0.0), dBeta = dPrices[i] - dIntrinsic;
+            Utilities::require(dBeta >= -IMPLIEDVOLINTRINSICTOLERANCE * dIntrinsic, "BachelierImpliedStdDev : price below the intrinsic value");
+            if (x == 0.0 || dBeta <= 0.0)
+            {
+                //  At-the-money price s phi(0)
+                dStdDevs[i] = std::max(dBeta, 0.0) * sqrtpi(2.0);
+                continue;
+            }
+
+            double dPhiStar = -dBeta / std::abs(x), z = BachelierInitialGuess(dPhiStar);
+            dMoneyness[i] = x;
+            dNormalisedPrices[i] = dPhiStar;
+            dApproximations.push_back(z);
+            iQuotes.push_back(i);
+        }
+        if (iQuotes.empty())
+        {
+            return;
+        }
+
+        //  One Householder iteration of order 4 on z
+        std::size_t iNQuotes = iQuotes.size();
+        dCumulatives.resize(iNQuotes);
+        AccCumNorm(Utilities::ArrayView<const double>(&dApproximations[0], iNQuotes), Utilities::ArrayView<double>(&dCumulatives[0], iNQuotes));
+        for (std::size_t j = 0 ; j < iNQuotes ; ++j)
+        {
+            std::size_t i = iQuotes[j];
+            dStdDevs[i] = -std::abs(dMoneyness[i]) / BachelierHouseholder(dApproximations[j], dCumulatives[j], dNormalisedPrices[i]);
+        }
+    }
+
+    double BlackScholesImpliedStdDev(double dPrice, double dForward, double dStrike, Finance::OptionType eOptionType)
+    {
+        Utilities::require((eOptionType == Finance::CALL) || (eOptionType == Finance::PUT));
+        double x = 0.0, dBeta = BlackNormalisedQuote(dPrice, dForward, dStrike, eOptionType == Finance::CALL ? 1.0 : -1.0, x);
+        if (dBeta <= 0.0)
+        {
+            return 0.0;
+        }
+
+        bool bLower = true;
+        double s = BlackInitialGuess(x, dBeta, bLower), dExpHalfX = exp(0.5 * x), dSign = bLower ? -1.0 : 1.0;
+        double dLogTarget = log(bLower ? dBeta : dExpHalfX - dBeta);
+        for (std::size_t iIteration = 0 ; iIteration < IMPLIEDVOLMAXITERATIONS ; ++iIteration)
+        {
+            double d1 = x / s + 0.5 * s;
+            double dStep = BlackHouseholderStep(s, x, dExpHalfX, dSign, dLogTarget, AccCumNorm(-dSign * d1), AccCumNorm(d1 - s));
+            s += dStep;
+            if (std::abs(dStep) <= IMPLIEDVOLTOLERANCE * s)
+            {
+                return s;
+            }
+        }
+        Utilities::require(false, "BlackScholesImpliedStdDev : no convergence");
+        return s;
+    }
+
+    double BachelierImpliedStdDev(double dPrice, double dForward, double dStrike, Finance::OptionType eOptionType)
+    {
+        Utilities::require((eOptionType == Finance::CALL) || (eOptionType == Finance::PUT));
+        double x = (eOptionType == Finance::CALL ? 1.0 : -1.0) * (dForward - dStrike), dIntrinsic = std::max(x, 0.0), dBeta = dPrice - dIntrinsic;
+        Utilities::require(dBeta >= -IMPLIEDVOLINTRINSICTOLERANCE * dIntrinsic, "BachelierImpliedStdDev : price below the intrinsic value");
+        if (x == 0.0 || dBeta <= 0.0)
+        {
+            //  At-the-money price s phi(0)
+            return std::max(dBeta, 0.0) * sqrtpi(2.0);
+        }
+
+        double dPhiStar = -dBeta / std::abs(x), z = BachelierInitialGuess(dPhiStar);
+        return -std::abs(x) / BachelierHouseholder(z, AccCumNorm(z), dPhiStar);
+    }
+}
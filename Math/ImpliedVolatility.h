@@ -0,0 +1,54 @@
+//
+//  ImpliedVolatility.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_ImpliedVolatility_h
+#define Seminaire_ImpliedVolatility_h
+
+#include "ArrayView.h"
+#include "Option.h"
+
+//  Maximum number of Householder iterations of the Black-Scholes implied standard deviation
+#define IMPLIEDVOLMAXITERATIONS 10
+
+//  Relative Householder step below which the Black-Scholes implied standard deviation is converged : the iterations are of order 4, so
+//  that the error after a step of 1e-7 is at the level of the rounding errors
+#define IMPLIEDVOLTOLERANCE 1e-7
+
+//  Relative tolerance on the intrinsic value : the prices of deep in-the-money options may be below it by rounding errors, their implied
+//  standard deviation is 0
+#define IMPLIEDVOLINTRINSICTOLERANCE 1e-12
+
+namespace MathFunctions {
+
+    //  Implied standard deviations (volatility * sqrt(expiry)) of undiscounted option prices, inverses of BlackScholes and Bachelier
+    //  The price has to be above the intrinsic value (the implied standard deviation of the intrinsic value is 0, up to
+    //  IMPLIEDVOLINTRINSICTOLERANCE) and, for Black-Scholes, below the forward for a call and the strike for a put
+    //
+    //  Black-Scholes (after Jaeckel, "Let's be rational") : the price is normalised into the out-of-the-money call b(x, s) on sqrt(F K) with
+    //  x = - |log(F / K)| <= 0. The initial guess inverts the asymptotic forms of b for small and large s, and a cubic interpolation around
+    //  the inflection point s_c = sqrt(2 |x|). It is refined by Householder iterations of order 4 on log(b) below b(s_c) and on
+    //  log(b_max - b) above, so that both tails are well conditioned : 2 iterations reach the machine precision for most quotes
+    //  The Black-Scholes price of a far out-of-the-money option is a difference of close terms, only accurate to about 1e-12 : its implied
+    //  standard deviation is accurate to about 1e-13 (and meaningless when AccCumNorm underflows, normalised prices below 1e-300)
+    //
+    //  Bachelier (Jaeckel, "Implied normal volatility") : rational approximation of the inverse of the normalised out-of-the-money price,
+    //  and one Householder iteration of order 4 (no loop)
+    double BlackScholesImpliedStdDev(double dPrice, double dForward, double dStrike, Finance::OptionType eOptionType);
+    double BachelierImpliedStdDev(double dPrice, double dForward, double dStrike, Finance::OptionType eOptionType);
+
+    //  Batched versions for many quotes : same iterations as the scalar functions, but each one evaluates the normal distribution of all
+    //  the quotes not converged yet with the batched AccCumNorm (see BatchMathFunctions.h) ; the results match the scalar functions to 1e-15,
+    //  and to the accuracy above (about 1e-13) for far out-of-the-money Black-Scholes quotes. The rest of the iterations is scalar code : 
+    //  they run at the speed of the scalar functions (menu 109)
+    void BlackScholesImpliedStdDev(Utilities::ArrayView<const double> dPrices, Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes,
+                                   Finance::OptionType eOptionType, Utilities::ArrayView<double> dStdDevs);
+    void BachelierImpliedStdDev(Utilities::ArrayView<const double> dPrices, Utilities::ArrayView<const double> dForwards, Utilities::ArrayView<const double> dStrikes,
+                                Finance::OptionType eOptionType, Utilities::ArrayView<double> dStdDevs);
+}
+
+#endif
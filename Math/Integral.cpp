@@ -7,52 +7,111 @@
 //
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include "Integral.h"
 #include "Require.h"
 
+namespace {
+    //  \int_{A}^{B} exp(kappa u) du = exp(kappa A) (B - A) (exp(x) - 1) / x with x = kappa (B - A)
+    double ExpSegment(double dKappa, double dA, double dB)
+    {
+        double dLength = dB - dA, dKappaLength = dKappa * dLength;
+        return exp(dKappa * dA) * dLength * (dKappaLength != 0.0 ? expm1(dKappaLength) / dKappaLength : 1.0);
+    }
+    
+    //  Index of the interval of dT : last pillar lower or equal to dT, 0 before the first pillar
+    std::size_t Locate(const std::vector<double> & dVariables, double dT)
+    {
+        std::size_t i = std::upper_bound(dVariables.begin(), dVariables.end(), dT) - dVariables.begin();
+        return i > 0 ? i - 1 : 0;
+    }
+}
+
 namespace Maths {
-	TermStructureIntegral::TermStructureIntegral() {}
+	TermStructureIntegral::TermStructureIntegral() : lTablesVersion_(GetVersion()), bCumulatedIntegrals_(false) {}
 	
-	TermStructureIntegral::TermStructureIntegral(const Finance::TermStructure<double,double> & sTermStructure) {
+	TermStructureIntegral::TermStructureIntegral(const Finance::TermStructure<double,double> & sTermStructure) : lTablesVersion_(GetVersion()), bCumulatedIntegrals_(false) {
 		SetValues(sTermStructure.GetValues());
 		SetVariables(sTermStructure.GetVariables());
 	}
 	
 	TermStructureIntegral::~TermStructureIntegral() {}
+    
+    void TermStructureIntegral::CheckTables() const {
+        if (lTablesVersion_ != GetVersion()) {
+            bCumulatedIntegrals_ = false;
+            dCumulatedIntegrals_.clear();
+            dExpTables_.clear();
+            lTablesVersion_ = GetVersion();
+        }
+    }
 	
 	// computes the integral of TermStructure * f on [dT1, dT2]
 	double TermStructureIntegral::Integral(double dT1, double dT2) const {
-		std::vector<double> dTSVariables = GetVariables(), dTSValues = GetValues();
 		Utilities::require(dT1 < dT2, "First boundary must be smaller than second boundary.");
-		std::size_t iSize = dTSValues.size();
 		
-		if (iSize == 1) {
-			return dTSValues[0] * SubIntegral(dT1, dT2);
+		if (UValues_.size() == 1) {
+			return UValues_[0] * SubIntegral(dT1, dT2);
 		}
 		else {
-			double dInf = 0.0, dSup = 0.0, dIntegral = 0.0 ;
-			
-			// beginning
-			if (dT1 < dTSVariables[0]) {
-				dIntegral += dTSValues[0] * SubIntegral(dT1, std::min(dTSVariables[0], dT2));
-			}
-			
-			// middle
-			for (std::size_t iTS = 1; iTS < iSize; ++iTS) {
-				dInf = std::max(dTSVariables[iTS-1], dT1);
-				dSup = std::min(dTSVariables[iTS], dT2);
-				if (dInf < dSup) {
-					dIntegral += dTSValues[iTS-1] * SubIntegral(std::max(dTSVariables[iTS-1], dT1), std::min(dTSVariables[iTS], dT2));
-				}
-			}
-			
-			// end
-			if (dT2 > dTSVariables[iSize - 1]) {
-				dIntegral += dTSValues[iSize - 1] * SubIntegral(std::max(dTSVariables[iSize - 1], dT1), dT2);
-                
-			}
-			
-			return dIntegral;
+			return Primitive(dT2) - Primitive(dT1);
 		}
 	}
-}
\ No newline at end of file
+    
+    void TermStructureIntegral::Integral(Utilities::ArrayView<const double> dT1, Utilities::ArrayView<const double> dT2, Utilities::ArrayView<double> dResults) const {
+        Utilities::require(dT1.size() == dT2.size() && dT1.size() == dResults.size(), "TermStructureIntegral::Integral : sizes of the boundaries and of the results are not the same");
+        for (std::size_t i = 0 ; i < dResults.size() ; ++i) {
+            dResults[i] = Integral(dT1[i], dT2[i]);
+        }
+    }
+    
+    double TermStructureIntegral::Primitive(double dT) const {
+        const std::vector<double> & dTSVariables = TVariables_, & dTSValues = UValues_;
+        CheckTables();
+        if (!bCumulatedIntegrals_) {
+            dCumulatedIntegrals_.assign(dTSVariables.size(), 0.0);
+            for (std::size_t iTS = 1 ; iTS < dTSVariables.size() ; ++iTS) {
+                dCumulatedIntegrals_[iTS] = dCumulatedIntegrals_[iTS - 1] + dTSValues[iTS - 1] * SubIntegral(dTSVariables[iTS - 1], dTSVariables[iTS]);
+            }
+            bCumulatedIntegrals_ = true;
+        }
+        std::size_t iTS = Locate(dTSVariables, dT);
+        return dCumulatedIntegrals_[iTS] + dTSValues[iTS] * SubIntegral(dTSVariables[iTS], dT);
+    }
+    
+    double TermStructureIntegral::ExpIntegral(double dKappa, double dT1, double dT2) const {
+        if (UValues_.size() == 1) {
+            return UValues_[0] * ExpSegment(dKappa, dT1, dT2);
+        }
+        else {
+            const std::vector<double> & dTable = GetExpTable(dKappa);
+            return ExpPrimitive(dTable, dKappa, dT2) - ExpPrimitive(dTable, dKappa, dT1);
+        }
+    }
+    
+    double TermStructureIntegral::ExpPrimitive(const std::vector<double> & dTable, double dKappa, double dT) const {
+        std::size_t iTS = Locate(TVariables_, dT);
+        return dTable[iTS] + UValues_[iTS] * ExpSegment(dKappa, TVariables_[iTS], dT);
+    }
+    
+    const std::vector<double> & TermStructureIntegral::GetExpTable(double dKappa) const {
+        CheckTables();
+        for (std::size_t iTable = 0 ; iTable < dExpTables_.size() ; ++iTable) {
+            if (dExpTables_[iTable].first == dKappa) {
+                return dExpTables_[iTable].second;
+            }
+        }
+        if (dExpTables_.size() >= TERMSTRUCTUREINTEGRALMAXEXPTABLES) {
+            dExpTables_.erase(dExpTables_.begin());
+        }
+        
+        std::vector<double> dTable(TVariables_.size(), 0.0);
+        for (std::size_t iTS = 1 ; iTS < TVariables_.size() ; ++iTS) {
+            dTable[iTS] = dTable[iTS - 1] + UValues_[iTS - 1] * ExpSegment(dKappa, TVariables_[iTS - 1], TVariables_[iTS]);
+        }
+        dExpTables_.push_back(std::make_pair(dKappa, std::vector<double>()));
+        dExpTables_.back().second.swap(dTable);
+        return dExpTables_.back().second;
+    }
+}
@@ -10,7 +10,12 @@
 #ifndef Seminaire_Integral_h
 #define Seminaire_Integral_h
 
+#include <vector>
 #include "TermStructure.h"
+#include "ArrayView.h"
+
+//  Maximum number of tables of \int \sigma(u) exp(kappa u) du kept by a TermStructureIntegral (one per kappa, the oldest is dropped)
+#define TERMSTRUCTUREINTEGRALMAXEXPTABLES 8
 
 namespace Maths {
 	class TermStructureIntegral: public Finance::TermStructure<double,double> {
@@ -24,11 +29,33 @@ namespace Maths {
 		virtual ~TermStructureIntegral();
         
         // compute \int_{T1}{T2} \sigma(u) f(u) du
+        //  Two lookups in the table of the cumulative integrals on the pillars (built at the first call) : O(log n)
 		virtual double Integral(double dT1, double dT2) const;
+        //  dResults[i] = Integral(dT1[i], dT2[i])
+        void Integral(Utilities::ArrayView<const double> dT1, Utilities::ArrayView<const double> dT2, Utilities::ArrayView<double> dResults) const;
         
         //  primitive of function f() define in the above integral
 		virtual double SubIntegral(double dA, double dB) const = 0;
         
+        //  \int_{T1}^{T2} \sigma(u) exp(kappa u) du on the cumulative table of kappa (built at the first call with kappa) : O(log n)
+        double ExpIntegral(double dKappa, double dT1, double dT2) const;
+        
+    private:
+        //  The cumulative tables are valid for the version lTablesVersion_ of the term structure : any change of the term structure 
+        //  (Set..., MergeTermStructure, assignments and compound operators) renews its version, and the tables are rebuilt at the next call
+        mutable unsigned long lTablesVersion_;
+        //  dCumulatedIntegrals_[i] = \int_{T_0}^{T_i} \sigma(u) f(u) du
+        mutable std::vector<double> dCumulatedIntegrals_;
+        mutable bool bCumulatedIntegrals_;
+        //  (kappa, \int_{T_0}^{T_i} \sigma(u) exp(kappa u) du)
+        mutable std::vector<std::pair<double, std::vector<double> > > dExpTables_;
+        
+        //  \int_{T_0}^{T} : cumulative integral at the pillar of T and integral from the pillar to T (integral back to T_0 before the first pillar)
+        double Primitive(double dT) const;
+        double ExpPrimitive(const std::vector<double> & dTable, double dKappa, double dT) const;
+        const std::vector<double> & GetExpTable(double dKappa) const;
+        //  Clear the tables if the term structure changed since they were built
+        void CheckTables() const;
 	};
 }
 #endif
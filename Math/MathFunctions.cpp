@@ -165,12 +165,12 @@ namespace MathFunctions {
 
     double InvCumNorm(double p)
     {
-        Utilities::require(0.0 <= p <= 1.0);
+        Utilities::require(0.0 <= p && p <= 1.0);
         // Implementation comes from http://home.online.no/~pjacklam/notes/invnorm/
 
         //Coefficients in rational approximations.
 
-        double a[] = {0.0, -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00},
+        static const double a[] = {0.0, -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00},
         b[] = {0.0, -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01},
         c[] = {0.0, -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00,  4.374664141464968e+00, 2.938163982698783e+00},
         d[] = {0.0, 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
@@ -201,7 +201,7 @@ namespace MathFunctions {
         else if (p_high < p && p < 1)
         {
             q = sqrt(-2*log(1-p));
-            x = -(((((c[1]*q+c[2])*q+c[3])*q+c[4])*q+c[5])*q+c[6]) / ((((d[1]*q+d[2]*q+d[3])*q+d[4])*q+1));
+            x = -(((((c[1]*q+c[2])*q+c[3])*q+c[4])*q+c[5])*q+c[6]) / ((((d[1]*q+d[2])*q+d[3])*q+d[4])*q+1);
         }
 
         return x;
@@ -216,7 +216,8 @@ namespace MathFunctions {
         }
         else
         {
-            return x - 0.5 * x * dt + 1 / 6.0 * x * x * dt - 1 / 24.0 * x * x * x * dt;
+            //  t (1 - x / 2 + x^2 / 6 - x^3 / 24)
+            return dt * (1.0 + x * (-0.5 + x * (1 / 6.0 - 1 / 24.0 * x)));
         }
     }
     
@@ -225,6 +226,27 @@ namespace MathFunctions {
     {
 		return (exp(dLambda*dt2) - exp(dLambda*dt1)) / dLambda;
     }
+    
+    // returns sum((u - dt) * exp(dLambda * u)du, u=dt1..dt2)
+    double SumLinearExp(double dLambda, double dt, double dt1, double dt2)
+    {
+        //  exp(dLambda dt1) ((dt1 - dt) L phi1(z) + L^2 psi(z)) with L = dt2 - dt1, z = dLambda L, 
+        //  phi1(z) = \int_{0}^{1} exp(z s) ds and psi(z) = \int_{0}^{1} s exp(z s) ds
+        double dLength = dt2 - dt1, z = dLambda * dLength, dPhi1 = 1.0, dPsi = 0.5;
+        if (fabs(z) < 0.05)
+        {
+            //  series sum z^k / (k! (k + 1)) and sum z^k / (k! (k + 2)), truncation below 1e-16
+            dPhi1 = 1.0 + z * (1 / 2.0 + z * (1 / 6.0 + z * (1 / 24.0 + z * (1 / 120.0 + z * (1 / 720.0 + z * (1 / 5040.0 + z * (1 / 40320.0)))))));
+            dPsi = 1 / 2.0 + z * (1 / 3.0 + z * (1 / 8.0 + z * (1 / 30.0 + z * (1 / 144.0 + z * (1 / 840.0 + z * (1 / 5760.0 + z * (1 / 45360.0)))))));
+        }
+        else
+        {
+            double dExpM1 = expm1(z);
+            dPhi1 = dExpM1 / z;
+            dPsi = (z * (dExpM1 + 1.0) - dExpM1) / (z * z);
+        }
+        return exp(dLambda * dt1) * dLength * ((dt1 - dt) * dPhi1 + dLength * dPsi);
+    }
 	
     double BlackScholes(double dForward, double dStrike, double dStdDev, Finance::OptionType eOptionType)
     {
@@ -235,15 +257,40 @@ namespace MathFunctions {
         {
             return eOptionType == Finance::CALL ? dForward : 0.0;
         }
+        
+        int iPhi = eOptionType == Finance::CALL ? 1 : -1;
         if (std::abs(dStdDev) < 1e-10)
         {
-            return std::max(dForward - dStrike, 0.0);
+            return std::max(iPhi * (dForward - dStrike), 0.0);
         }
         
-        int iPhi = eOptionType == Finance::CALL ? 1 : -1;
         double d1 = log(dForward / dStrike) / dStdDev + 0.5 * dStdDev, d2 = d1 - dStdDev;
         
         return iPhi * (dForward * AccCumNorm(iPhi * d1) - dStrike * AccCumNorm(iPhi * d2));
     }
+    
+    double Bachelier(double dForward, double dStrike, double dStdDev, Finance::OptionType eOptionType)
+    {
+        Utilities::require((eOptionType == Finance::CALL) || (eOptionType == Finance::PUT));
+        double dMoneyness = (eOptionType == Finance::CALL ? 1.0 : -1.0) * (dForward - dStrike), dIntrinsic = std::max(dMoneyness, 0.0);
+        if (std::abs(dStdDev) < 1e-10)
+        {
+            return dIntrinsic;
+        }
+        
+        //  Intrinsic value plus the out-of-the-money option dStdDev (phi(a) - a N(-a)) with a = |dMoneyness| / dStdDev, computed in the tail as
+        //  phi(a) / (1 + a T(a)), T(a) = a + 2 / (a + 3 / (a + 4 / ...)), without cancellation
+        double a = std::abs(dMoneyness) / dStdDev, dDensity = exp(-0.5 * a * a) / sqrtpi(2.0);
+        if (a < BACHELIERCONTINUEDFRACTIONTHRESHOLD)
+        {
+            return dIntrinsic + dStdDev * (dDensity - a * AccCumNorm(-a));
+        }
+        double dFraction = a;
+        for (std::size_t k = BACHELIERCONTINUEDFRACTIONDEPTH ; k >= 2 ; --k)
+        {
+            dFraction = a + k / dFraction;
+        }
+        return dIntrinsic + dStdDev * dDensity / (1.0 + a * dFraction);
+    }
 
 }
@@ -35,8 +35,20 @@ namespace MathFunctions {
     //  Function to compute sum(exp(dLambda * u)du, u=dt1..dt2)
     double SumExp(double dLambda, double dt1, double dt2) ;
     
+    //  Function to compute sum((u - dt) * exp(dLambda * u)du, u=dt1..dt2) (stable when dLambda * (dt2 - dt1) is small, exact for dLambda = 0)
+    double SumLinearExp(double dLambda, double dt, double dt1, double dt2) ;
+    
 	    // Black-Scholes Function
     double BlackScholes(double dForward, double dStrike, double dStdDev, Finance::OptionType eOptionType);
+    
+    //  Bachelier (normal model) undiscounted price : dStdDev is the standard deviation of the forward at the expiry
+    //  Threshold on |F - K| / dStdDev above which the out-of-the-money value is computed by a continued fraction, and its depth
+#ifndef BACHELIERCONTINUEDFRACTIONTHRESHOLD
+#define BACHELIERCONTINUEDFRACTIONTHRESHOLD 2.25
+#define BACHELIERCONTINUEDFRACTIONDEPTH 100
+#endif
+    
+    double Bachelier(double dForward, double dStrike, double dStdDev, Finance::OptionType eOptionType);
 
 
 }
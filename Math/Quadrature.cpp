@@ -0,0 +1,146 @@
+//
+//  Quadrature.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include "Quadrature.h"
+#include "Constants.h"
+
+//  Maximum number of Newton iterations on a node of a Gauss rule
+#define GAUSSRULEMAXITERATIONS 100
+
+namespace Maths {
+
+    //  Abscissae and weights of the 15-point Kronrod rule and of the embedded 7-point Gauss rule (QUADPACK qk15)
+    const double GaussKronrod::dKronrodNodes_[8] = {
+        0.991455371120812639206854697526329,
+        0.949107912342758524526189684047851,
+        0.864864423359769072789712788640926,
+        0.741531185599394439863864773280788,
+        0.586087235467691130294144845693013,
+        0.405845151377397166906606412076961,
+        0.207784955007898467600689403773245,
+        0.000000000000000000000000000000000
+    };
+
+    const double GaussKronrod::dKronrodWeights_[8] = {
+        0.022935322010529224963732008058970,
+        0.063092092629978553290700663189204,
+        0.104790010322250183839876322541518,
+        0.140653259715525918745189590510238,
+        0.169004726639267902826583426598550,
+        0.190350578064785409913256402421014,
+        0.204432940075298892414161999234649,
+        0.209482141084727828012999174891714
+    };
+
+    const double GaussKronrod::dGaussWeights_[4] = {
+        0.129484966168869693270611432679082,
+        0.279705391489276667901467771423780,
+        0.381830050505118944950369775488975,
+        0.417959183673469387755102040816327
+    };
+
+    GaussKronrod::GaussKronrod(double dRelativeTolerance, double dAbsoluteTolerance, std::size_t iMaxIntervals) : dRelativeTolerance_(dRelativeTolerance), dAbsoluteTolerance_(dAbsoluteTolerance), iMaxIntervals_(iMaxIntervals), dError_(0.0), iNEvaluations_(0)
+    {
+        Utilities::require(iMaxIntervals > 0, "GaussKronrod : no interval");
+    }
+
+    GaussKronrod::~GaussKronrod()
+    {}
+
+    void GaussLegendreRule(std::size_t iNNodes, std::vector<double> & dNodes, std::vector<double> & dWeights)
+    {
+        Utilities::require(iNNodes > 0, "GaussLegendreRule : no node");
+        dNodes.resize(iNNodes);
+        dWeights.resize(iNNodes);
+        double dN = static_cast<double>(iNNodes);
+        //  The nodes are symmetric : Newton's method on the (n + 1) / 2 positive ones, from the asymptotic approximation cos(pi (i + 3/4) / (n + 1/2))
+        for (std::size_t i = 0 ; i < (iNNodes + 1) / 2 ; ++i)
+        {
+            double dX = cos(PI * (i + 0.75) / (dN + 0.5)), dDerivative = 0.0;
+            for (std::size_t iIteration = 0 ; iIteration < GAUSSRULEMAXITERATIONS ; ++iIteration)
+            {
+                //  (k + 1) P_{k+1} = (2k + 1) x P_k - k P_{k-1}
+                double dP = 1.0, dPPrevious = 0.0;
+                for (std::size_t k = 0 ; k < iNNodes ; ++k)
+                {
+                    double dPNext = ((2.0 * k + 1.0) * dX * dP - k * dPPrevious) / (k + 1.0);
+                    dPPrevious = dP;
+                    dP = dPNext;
+                }
+                dDerivative = dN * (dX * dP - dPPrevious) / (dX * dX - 1.0);
+                double dStep = dP / dDerivative;
+                dX -= dStep;
+                if (std::abs(dStep) <= 1e-15)
+                {
+                    break;
+                }
+            }
+            dNodes[i] = -dX;
+            dNodes[iNNodes - 1 - i] = dX;
+            dWeights[i] = dWeights[iNNodes - 1 - i] = 2.0 / ((1.0 - dX * dX) * dDerivative * dDerivative);
+        }
+    }
+
+    void GaussHermiteRule(std::size_t iNNodes, std::vector<double> & dNodes, std::vector<double> & dWeights)
+    {
+        Utilities::require(iNNodes > 0 && iNNodes <= GAUSSHERMITERULEMAXNODES, "GaussHermiteRule : number of nodes out of range");
+        dNodes.resize(iNNodes);
+        dWeights.resize(iNNodes);
+        //  Rule of the weight exp(- x^2) with the orthonormal Hermite polynomials (no overflow for many nodes) :
+        //  p_{k+1} = x sqrt(2 / (k + 1)) p_k - sqrt(k / (k + 1)) p_{k-1}, p_0 = pi^{-1/4}
+        //  The nodes are found from the largest one, each initial guess extrapolated from the previous nodes (Numerical Recipes, gauher)
+        double dN = static_cast<double>(iNNodes), dPiQuarter = pow(PI, -0.25), dX = 0.0;
+        std::vector<double> dRoots((iNNodes + 1) / 2);
+        for (std::size_t i = 0 ; i < dRoots.size() ; ++i)
+        {
+            if (i == 0)
+            {
+                dX = sqrt(2.0 * dN + 1.0) - 1.85575 * pow(2.0 * dN + 1.0, -1.0 / 6.0);
+            }
+            else if (i == 1)
+            {
+                dX -= 1.14 * pow(dN, 0.426) / dX;
+            }
+            else if (i == 2)
+            {
+                dX = 1.86 * dX - 0.86 * dRoots[0];
+            }
+            else if (i == 3)
+            {
+                dX = 1.91 * dX - 0.91 * dRoots[1];
+            }
+            else
+            {
+                dX = 2.0 * dX - dRoots[i - 2];
+            }
+            double dDerivative = 0.0;
+            for (std::size_t iIteration = 0 ; iIteration < GAUSSRULEMAXITERATIONS ; ++iIteration)
+            {
+                double dP = dPiQuarter, dPPrevious = 0.0;
+                for (std::size_t k = 0 ; k < iNNodes ; ++k)
+                {
+                    double dPNext = dX * sqrt(2.0 / (k + 1.0)) * dP - sqrt(k / (k + 1.0)) * dPPrevious;
+                    dPPrevious = dP;
+                    dP = dPNext;
+                }
+                dDerivative = sqrt(2.0 * dN) * dPPrevious;
+                double dStep = dP / dDerivative;
+                dX -= dStep;
+                if (std::abs(dStep) <= 1e-15 * std::max(1.0, std::abs(dX)))
+                {
+                    break;
+                }
+            }
+            dRoots[i] = dX;
+            //  Change of variable z = sqrt(2) x to the standard gaussian density : the weights are divided by sqrt(pi)
+            dNodes[i] = -sqrt(2.0) * dX;
+            dNodes[iNNodes - 1 - i] = sqrt(2.0) * dX;
+            dWeights[i] = dWeights[iNNodes - 1 - i] = 2.0 / (dDerivative * dDerivative) / sqrt(PI);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+//
+//  Quadrature.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_Quadrature_h
+#define Seminaire_Quadrature_h
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Require.h"
+
+//  Default tolerances and maximum number of intervals of the adaptive Gauss-Kronrod quadrature
+#define GAUSSKRONRODRELATIVETOLERANCE 1e-12
+#define GAUSSKRONRODABSOLUTETOLERANCE 1e-15
+#define GAUSSKRONRODMAXINTERVALS 200
+
+//  Largest Gauss-Hermite rule (the initial guesses of the nodes of larger rules are not reliable)
+#define GAUSSHERMITERULEMAXNODES 128
+
+namespace Maths {
+
+    //  Gauss rules of iNNodes nodes, computed by Newton's method on the three-term recurrence of the orthogonal polynomials
+    //  Legendre : \int_{-1}^{1} f(x) dx ~ sum_i dWeights[i] f(dNodes[i])
+    //  Hermite : \int f(z) phi(z) dz ~ sum_i dWeights[i] f(dNodes[i]) for the standard gaussian density phi (the weights sum to 1), at most
+    //  GAUSSHERMITERULEMAXNODES nodes
+    //  The nodes are sorted in increasing order
+    void GaussLegendreRule(std::size_t iNNodes, std::vector<double> & dNodes, std::vector<double> & dWeights);
+    void GaussHermiteRule(std::size_t iNNodes, std::vector<double> & dNodes, std::vector<double> & dWeights);
+
+    //  Adaptive Gauss-Kronrod quadrature (7-point Gauss, 15-point Kronrod) of \int_{A}^{B} f(x) dx
+    //  The interval is first split at the breakpoints (kinks of the integrand, such as the pillars of a piecewise constant volatility),
+    //  so that the rule only sees smooth pieces; the interval of largest error estimate |K15 - G7| is then bisected until the total error
+    //  is below max(absolute tolerance, relative tolerance * |integral|) or the maximum number of intervals is reached
+    //  Functor : any class with double operator () (double x) const
+    class GaussKronrod
+    {
+    public:
+        GaussKronrod(double dRelativeTolerance = GAUSSKRONRODRELATIVETOLERANCE, double dAbsoluteTolerance = GAUSSKRONRODABSOLUTETOLERANCE, std::size_t iMaxIntervals = GAUSSKRONRODMAXINTERVALS);
+        virtual ~GaussKronrod();
+
+        template<class Functor>
+        double Integrate(const Functor & sFunctor, double dA, double dB, const std::vector<double> & dBreakpoints = std::vector<double>());
+
+        //  Error estimate and number of evaluations of the integrand of the last integration
+        double GetError() const
+        {
+            return dError_;
+        }
+
+        std::size_t GetNbEvaluations() const
+        {
+            return iNEvaluations_;
+        }
+
+    private:
+        double dRelativeTolerance_, dAbsoluteTolerance_;
+        std::size_t iMaxIntervals_;
+        double dError_;
+        std::size_t iNEvaluations_;
+
+        //  Nodes of the Kronrod rule on [-1, 1] (the odd ones are the Gauss nodes) and weights
+        static const double dKronrodNodes_[8];
+        static const double dKronrodWeights_[8];
+        static const double dGaussWeights_[4];
+
+        //  One interval with its Kronrod integral and its error estimate
+        struct Interval
+        {
+            double dA_, dB_, dIntegral_, dError_;
+        };
+
+        template<class Functor>
+        Interval Rule(const Functor & sFunctor, double dA, double dB);
+    };
+
+    template<class Functor>
+    GaussKronrod::Interval GaussKronrod::Rule(const Functor & sFunctor, double dA, double dB)
+    {
+        double dCenter = 0.5 * (dA + dB), dHalfLength = 0.5 * (dB - dA);
+        double dCenterValue = sFunctor(dCenter);
+        double dKronrod = dKronrodWeights_[7] * dCenterValue, dGauss = dGaussWeights_[3] * dCenterValue;
+        for (std::size_t i = 0 ; i < 7 ; ++i)
+        {
+            double dShift = dHalfLength * dKronrodNodes_[i];
+            double dValues = sFunctor(dCenter - dShift) + sFunctor(dCenter + dShift);
+            dKronrod += dKronrodWeights_[i] * dValues;
+            if (i % 2 == 1)
+            {
+                dGauss += dGaussWeights_[i / 2] * dValues;
+            }
+        }
+        iNEvaluations_ += 15;
+
+        Interval sInterval;
+        sInterval.dA_ = dA;
+        sInterval.dB_ = dB;
+        sInterval.dIntegral_ = dKronrod * dHalfLength;
+        sInterval.dError_ = std::abs((dKronrod - dGauss) * dHalfLength);
+        return sInterval;
+    }
+
+    template<class Functor>
+    double GaussKronrod::Integrate(const Functor & sFunctor, double dA, double dB, const std::vector<double> & dBreakpoints)
+    {
+        Utilities::require(dA <= dB, "GaussKronrod : lower bound above upper bound");
+        dError_ = 0.0;
+        iNEvaluations_ = 0;
+        if (dA == dB)
+        {
+            return 0.0;
+        }
+
+        //  Smooth pieces between the breakpoints inside ]A, B[
+        std::vector<double> dBounds(1, dA);
+        std::vector<double> dSortedBreakpoints(dBreakpoints);
+        std::sort(dSortedBreakpoints.begin(), dSortedBreakpoints.end());
+        for (std::size_t i = 0 ; i < dSortedBreakpoints.size() ; ++i)
+        {
+            if (dSortedBreakpoints[i] > dBounds.back() && dSortedBreakpoints[i] < dB)
+            {
+                dBounds.push_back(dSortedBreakpoints[i]);
+            }
+        }
+        dBounds.push_back(dB);
+
+        std::vector<Interval> sIntervals;
+        sIntervals.reserve(std::max(iMaxIntervals_, dBounds.size()));
+        double dIntegral = 0.0;
+        for (std::size_t i = 0 ; i + 1 < dBounds.size() ; ++i)
+        {
+            sIntervals.push_back(Rule(sFunctor, dBounds[i], dBounds[i + 1]));
+            dIntegral += sIntervals.back().dIntegral_;
+            dError_ += sIntervals.back().dError_;
+        }
+
+        //  Bisection of the interval of largest error
+        while (dError_ > std::max(dAbsoluteTolerance_, dRelativeTolerance_ * std::abs(dIntegral)) && sIntervals.size() < iMaxIntervals_)
+        {
+            std::size_t iWorst = 0;
+            for (std::size_t i = 1 ; i < sIntervals.size() ; ++i)
+            {
+                if (sIntervals[i].dError_ > sIntervals[iWorst].dError_)
+                {
+                    iWorst = i;
+                }
+            }
+            Interval sWorst = sIntervals[iWorst];
+            double dMiddle = 0.5 * (sWorst.dA_ + sWorst.dB_);
+            sIntervals[iWorst] = Rule(sFunctor, sWorst.dA_, dMiddle);
+            sIntervals.push_back(Rule(sFunctor, dMiddle, sWorst.dB_));
+            dIntegral += sIntervals[iWorst].dIntegral_ + sIntervals.back().dIntegral_ - sWorst.dIntegral_;
+            dError_ += sIntervals[iWorst].dError_ + sIntervals.back().dError_ - sWorst.dError_;
+        }
+        return dIntegral;
+    }
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <iostream>
 #include "Statistics.h"
 #include <cmath>
+#include <algorithm>
 
 namespace Stats {
     
@@ -31,23 +32,23 @@ namespace Stats {
     
     double Statistics::Median(const std::vector<double> &dData) const
     {
-        std::size_t n = dData.size();
-        std::vector<double> dDataCopy = dData;
-        std::sort(dDataCopy.begin(), dDataCopy.end());
-        
-        return n % 2 == 1 ? dDataCopy[n / 2] : 0.5 * (dDataCopy[n/2 - 1] + dDataCopy[n/2]);
+        return Quantile(0.5, dData);
     }
     
     double Statistics::Variance(const std::vector<double> &dData) const
     {
-        double dVariance = 0.0, dMean = 0.0;
-        for (std::size_t i = 0 ; i < dData.size() ; ++i)
+        //  Two-pass algorithm : the sum of squares minus the squared mean cancels catastrophically when the mean is large
+        std::size_t n = dData.size();
+        if (n == 0)
         {
-            dMean += dData[i];
-            dVariance += dData[i] * dData[i];
+            return 0.0;
         }
-        dMean /= dData.size();
-        return dVariance / dData.size() - dMean * dMean;
+        double dMean = Mean(dData), dVariance = 0.0;
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            dVariance += (dData[i] - dMean) * (dData[i] - dMean);
+        }
+        return dVariance / n;
     }
     
     double Statistics::StandardDeviation(const std::vector<double> &dData) const
@@ -57,23 +58,24 @@ namespace Stats {
     
     double Statistics::Quantile(double dQuantile, const std::vector<double> &dData) const
     {
-        std::vector<double> dDataCopy = dData;
-        std::sort(dDataCopy.begin(), dDataCopy.end());
-        if (dQuantile < 0.0 || dQuantile > 1.0)
+        //  Linear interpolation between the order statistics around dQuantile * (n - 1), selected without sorting the whole data
+        std::size_t iNElmts = dData.size();
+        if (iNElmts == 0 || dQuantile < 0.0 || dQuantile > 1.0)
         {
-            if (dQuantile == 1.0 || dQuantile == 0.0)
-            {
-                return dQuantile == 0.0 ? dDataCopy[0] : dDataCopy.back();
-            }
-            std::size_t iNElmts = dDataCopy.size(), iElmtQuantile = (std::size_t)floor(dQuantile * iNElmts);
-            double dElmtQuantile = dQuantile * iNElmts - iElmtQuantile;
-            
-            return dElmtQuantile * dDataCopy[iElmtQuantile] + (1 - dElmtQuantile) * dDataCopy[iElmtQuantile + 1];
+            return 0.0;
         }
-        else
+        std::vector<double> dDataCopy = dData;
+        double dPosition = dQuantile * (iNElmts - 1);
+        std::size_t iElmtQuantile = std::min(static_cast<std::size_t>(floor(dPosition)), iNElmts - 1);
+        std::nth_element(dDataCopy.begin(), dDataCopy.begin() + iElmtQuantile, dDataCopy.end());
+        double dLower = dDataCopy[iElmtQuantile], dWeight = dPosition - iElmtQuantile;
+        if (dWeight == 0.0 || iElmtQuantile + 1 == iNElmts)
         {
-            return 0.0;
+            return dLower;
         }
+        //  The next order statistic is the smallest element of the upper part
+        double dUpper = *std::min_element(dDataCopy.begin() + iElmtQuantile + 1, dDataCopy.end());
+        return dLower + dWeight * (dUpper - dLower);
     }
     
     std::vector<std::pair<double, std::size_t> > Statistics::EmpiricalDistribution(const std::vector<double> &dData, const std::size_t iNBuckets) const
@@ -27,10 +27,11 @@ namespace Stats {
         //  Method to compute the standard deviation of data
         virtual double StandardDeviation(const std::vector<double> & dData) const;
         
-        //  Method to compute the variance of data
+        //  Method to compute the variance of data (divided by the number of data)
         virtual double Variance(const std::vector<double> & dData) const;
         
-        //  Method to compute the Quantile of data
+        //  Method to compute the Quantile of data (dQuantile in [0,1], linear interpolation between order statistics)
+        //  See Accumulators.h for the streaming versions of these statistics
         virtual double Quantile(double dQuantile, const std::vector<double> & dData) const;
         
         //  Method to compute the empirical distribution of the Data given a fixed number of buckets
@@ -0,0 +1,140 @@
+//
+//  SwapVariance.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include "SwapVariance.h"
+#include "MathFunctions.h" // for BETAOUTHRESHOLD
+#include "Require.h"
+
+namespace Maths {
+
+    SwapVariance::SwapVariance(const Finance::TermStructure<double, double> & sSigma1, const Finance::TermStructure<double, double> & sSigma2, double dLambda1, double dLambda2) : sIntegral_(sSigma1, sSigma2), dLambda1_(dLambda1), dLambda2_(dLambda2)
+    {}
+
+    SwapVariance::~SwapVariance()
+    {}
+
+    bool SwapVariance::IsSeparable() const
+    {
+        //  Same branch as TwoDimHullWhiteTS::Integral
+        return dLambda1_ + dLambda2_ >= BETAOUTHRESHOLD;
+    }
+
+    void SwapVariance::Moments(double dT1, double dT2, double dMoments[4]) const
+    {
+        dMoments[0] = sIntegral_.ExpIntegral(0.0, dT1, dT2);
+        dMoments[1] = sIntegral_.ExpIntegral(dLambda1_, dT1, dT2);
+        dMoments[2] = sIntegral_.ExpIntegral(dLambda2_, dT1, dT2);
+        dMoments[3] = sIntegral_.ExpIntegral(dLambda1_ + dLambda2_, dT1, dT2);
+    }
+
+    double SwapVariance::Covariance(double dWeightSum1, double dExpWeightSum1, double dWeightSum2, double dExpWeightSum2, const double dMoments[4]) const
+    {
+        //  Leg_k(u) = (\sum_j w_j - exp(lambda_k u) \sum_j w_j exp(-lambda_k S_j)) / lambda_k
+        return (dWeightSum1 * dWeightSum2 * dMoments[0]
+                - dExpWeightSum1 * dWeightSum2 * dMoments[1]
+                - dWeightSum1 * dExpWeightSum2 * dMoments[2]
+                + dExpWeightSum1 * dExpWeightSum2 * dMoments[3]) / (dLambda1_ * dLambda2_);
+    }
+
+    double SwapVariance::WeightedIntegral(double dT1, double dT2,
+                                          Utilities::ArrayView<const double> dWeights1, Utilities::ArrayView<const double> dS1,
+                                          Utilities::ArrayView<const double> dWeights2, Utilities::ArrayView<const double> dS2) const
+    {
+        Utilities::require(dWeights1.size() == dS1.size() && dWeights2.size() == dS2.size(), "SwapVariance : sizes of weights and dates are not the same");
+        if (!IsSeparable())
+        {
+            double dResult = 0.0;
+            for (std::size_t j = 0 ; j < dS1.size() ; ++j)
+            {
+                for (std::size_t k = 0 ; k < dS2.size() ; ++k)
+                {
+                    dResult += dWeights1[j] * dWeights2[k] * sIntegral_.Integral(dT1, dT2, dS1[j], dS2[k], dLambda1_, dLambda2_);
+                }
+            }
+            return dResult;
+        }
+
+        //  Same conventions as TwoDimHullWhiteTS::Integral
+        if (std::abs(dT1 - dT2) < 1e-07)
+        {
+            return 0.0;
+        }
+        Utilities::require(dT1 < dT2, "First boundary must be smaller than second boundary.");
+
+        double dMoments[4];
+        Moments(dT1, dT2, dMoments);
+        double dWeightSum1 = 0.0, dExpWeightSum1 = 0.0, dWeightSum2 = 0.0, dExpWeightSum2 = 0.0;
+        for (std::size_t j = 0 ; j < dS1.size() ; ++j)
+        {
+            dWeightSum1 += dWeights1[j];
+            dExpWeightSum1 += dWeights1[j] * exp(-dLambda1_ * dS1[j]);
+        }
+        for (std::size_t k = 0 ; k < dS2.size() ; ++k)
+        {
+            dWeightSum2 += dWeights2[k];
+            dExpWeightSum2 += dWeights2[k] * exp(-dLambda2_ * dS2[k]);
+        }
+        return Covariance(dWeightSum1, dExpWeightSum1, dWeightSum2, dExpWeightSum2, dMoments);
+    }
+
+    void SwapVariance::Covariances(double dT1, double dT2,
+                                   Utilities::ArrayView<const double> dWeights1, Utilities::ArrayView<const double> dS1,
+                                   Utilities::ArrayView<const double> dWeights2, Utilities::ArrayView<const double> dS2,
+                                   double dStart, double dEnd, double dCovariances[SWAPLEG_NLEGS][SWAPLEG_NLEGS]) const
+    {
+        //  Legs as (weights, dates) : the start and the end are one date of weight 1
+        double dOne = 1.0, dDates[2] = {dStart, dEnd};
+        Utilities::ArrayView<const double> dWeights[2][SWAPLEG_NLEGS] = {
+            {dWeights1, Utilities::ArrayView<const double>(&dOne, 1), Utilities::ArrayView<const double>(&dOne, 1)},
+            {dWeights2, Utilities::ArrayView<const double>(&dOne, 1), Utilities::ArrayView<const double>(&dOne, 1)}};
+        Utilities::ArrayView<const double> dS[2][SWAPLEG_NLEGS] = {
+            {dS1, Utilities::ArrayView<const double>(&dDates[0], 1), Utilities::ArrayView<const double>(&dDates[1], 1)},
+            {dS2, Utilities::ArrayView<const double>(&dDates[0], 1), Utilities::ArrayView<const double>(&dDates[1], 1)}};
+
+        if (!IsSeparable() || std::abs(dT1 - dT2) < 1e-07)
+        {
+            for (std::size_t i = 0 ; i < SWAPLEG_NLEGS ; ++i)
+            {
+                for (std::size_t j = 0 ; j < SWAPLEG_NLEGS ; ++j)
+                {
+                    dCovariances[i][j] = WeightedIntegral(dT1, dT2, dWeights[0][i], dS[0][i], dWeights[1][j], dS[1][j]);
+                }
+            }
+            return;
+        }
+        Utilities::require(dT1 < dT2, "First boundary must be smaller than second boundary.");
+        Utilities::require(dWeights1.size() == dS1.size() && dWeights2.size() == dS2.size(), "SwapVariance : sizes of weights and dates are not the same");
+
+        //  Sums of each leg, then the moments once for the nine covariances
+        double dWeightSums[2][SWAPLEG_NLEGS], dExpWeightSums[2][SWAPLEG_NLEGS];
+        double dLambdas[2] = {dLambda1_, dLambda2_};
+        for (std::size_t iFactor = 0 ; iFactor < 2 ; ++iFactor)
+        {
+            for (std::size_t iLeg = 0 ; iLeg < SWAPLEG_NLEGS ; ++iLeg)
+            {
+                dWeightSums[iFactor][iLeg] = 0.0;
+                dExpWeightSums[iFactor][iLeg] = 0.0;
+                for (std::size_t j = 0 ; j < dS[iFactor][iLeg].size() ; ++j)
+                {
+                    dWeightSums[iFactor][iLeg] += dWeights[iFactor][iLeg][j];
+                    dExpWeightSums[iFactor][iLeg] += dWeights[iFactor][iLeg][j] * exp(-dLambdas[iFactor] * dS[iFactor][iLeg][j]);
+                }
+            }
+        }
+        double dMoments[4];
+        Moments(dT1, dT2, dMoments);
+        for (std::size_t i = 0 ; i < SWAPLEG_NLEGS ; ++i)
+        {
+            for (std::size_t j = 0 ; j < SWAPLEG_NLEGS ; ++j)
+            {
+                dCovariances[i][j] = Covariance(dWeightSums[0][i], dExpWeightSums[0][i], dWeightSums[1][j], dExpWeightSums[1][j], dMoments);
+            }
+        }
+    }
+}
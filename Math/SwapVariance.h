@@ -0,0 +1,62 @@
+//
+//  SwapVariance.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_SwapVariance_h
+#define Seminaire_SwapVariance_h
+
+#include "2DHullWhiteTS.h"
+#include "ArrayView.h"
+
+namespace Maths {
+
+    //  Legs of the volatility of a swap in a Hull-White factor, with Gamma(u, S) = (1 - exp(-lambda (S - u))) / lambda :
+    //  annuity \sum_j w_j Gamma(u, S_j), start Gamma(u, T_0) and end Gamma(u, T_n)
+    enum SwapLeg
+    {
+        SWAPLEG_ANNUITY,
+        SWAPLEG_START,
+        SWAPLEG_END,
+        SWAPLEG_NLEGS
+    };
+
+    //  Covariances of the legs of two Hull-White factors of volatilities sigma_1 and sigma_2 :
+    //  \int_{T1}^{T2} \sigma_1(u) \sigma_2(u) Leg_1(u) Leg_2(u) du
+    //  The kernel Gamma_1(u, S_1) Gamma_2(u, S_2) is separable in S_1 and S_2 : a leg is summed into \sum_j w_j and \sum_j w_j exp(-lambda S_j),
+    //  and the weighted double sums of TwoDimHullWhiteTS::Integral collapse to four exponential moments of sigma_1 sigma_2, in O(n) instead
+    //  of O(n^2) integrals (double sums when lambda_1 + lambda_2 < BETAOUTHRESHOLD, as TwoDimHullWhiteTS)
+    class SwapVariance
+    {
+    public:
+        SwapVariance(const Finance::TermStructure<double, double> & sSigma1, const Finance::TermStructure<double, double> & sSigma2, double dLambda1, double dLambda2);
+        virtual ~SwapVariance();
+
+        //  \sum_j \sum_k w1_j w2_k \int_{T1}^{T2} \sigma_1(u) \sigma_2(u) Gamma_1(u, S1_j) Gamma_2(u, S2_k) du
+        double WeightedIntegral(double dT1, double dT2,
+                                Utilities::ArrayView<const double> dWeights1, Utilities::ArrayView<const double> dS1,
+                                Utilities::ArrayView<const double> dWeights2, Utilities::ArrayView<const double> dS2) const;
+
+        //  dCovariances[i][j] : covariance of the leg i of the first factor and of the leg j of the second factor (SwapLeg), both legs
+        //  having the annuity weights dWeightsk on the dates dSk, the start dStart and the end dEnd
+        void Covariances(double dT1, double dT2,
+                         Utilities::ArrayView<const double> dWeights1, Utilities::ArrayView<const double> dS1,
+                         Utilities::ArrayView<const double> dWeights2, Utilities::ArrayView<const double> dS2,
+                         double dStart, double dEnd, double dCovariances[SWAPLEG_NLEGS][SWAPLEG_NLEGS]) const;
+
+    private:
+        TwoDimHullWhiteTS sIntegral_;
+        double dLambda1_, dLambda2_;
+
+        bool IsSeparable() const;
+        //  \int_{T1}^{T2} \sigma_1 \sigma_2 exp(kappa u) du for kappa = 0, lambda_1, lambda_2 and lambda_1 + lambda_2
+        void Moments(double dT1, double dT2, double dMoments[4]) const;
+        //  Covariance of two legs from their sums and the moments
+        double Covariance(double dWeightSum1, double dExpWeightSum1, double dWeightSum2, double dExpWeightSum2, const double dMoments[4]) const;
+    };
+}
+
+#endif
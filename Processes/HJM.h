@@ -46,6 +46,12 @@ namespace Processes {
         RISK_NEUTRAL
     };
     
+    enum SimulationScheme
+    {
+        PSEUDO_RANDOM,      //  Counter-based pseudo-random numbers
+        QUASI_RANDOM        //  Sobol sequence with a brownian bridge along the simulation tenors
+    };
+    
     enum CurveName
     {
         DISCOUNT,
@@ -66,14 +72,20 @@ namespace Processes {
         
         // Added to call the YieldCurve
         // 09.01.2013 change GetYieldCurve to HeathJarrowMorton class from LGM Class
-		virtual Finance::YieldCurve GetDiscountYieldCurve() const
+		virtual const Finance::YieldCurve & GetDiscountYieldCurve() const
         {
             return sDiscountCurve_;
         }
-		virtual Finance::YieldCurve GetForwardYieldCurve() const
+		virtual const Finance::YieldCurve & GetForwardYieldCurve() const
         {
             return sForwardCurve_;
         }
+        
+        //  Select the initial curve without copying it
+        const Finance::YieldCurve & GetYieldCurve(const CurveName & eCurveName) const
+        {
+            return eCurveName == DISCOUNT ? sDiscountCurve_ : sForwardCurve_;
+        }
 
         virtual void Simulate(std::size_t iNRealisations,
                               const std::vector<double> & dSimulationTenors,
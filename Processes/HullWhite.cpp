@@ -6,85 +6,186 @@
 //  Copyright (c) 2012 __MyCompanyName__. All rights reserved.
 //
 
+#include <cmath>
+#include <algorithm>
 #include "HullWhite.h"
 #include "Require.h"
-#include "Gaussian.h"
 #include "MathFunctions.h"
+#include "ThreadPool.h"
+#include "Philox.h"
 
 namespace Processes {
     
-    LinearGaussianMarkov::LinearGaussianMarkov()
-    {}
+    LinearGaussianMarkov::LinearGaussianMarkov() : dLambda_(0.0), iNThreads_(1), lSeed_(0), eSimulationScheme_(PSEUDO_RANDOM), eScrambling_(RandomNumbers::LINEAR_SCRAMBLING)
+    {
+        ComputeIntegralTables();
+    }
     
-    LinearGaussianMarkov::LinearGaussianMarkov(const Finance::YieldCurve & sDiscountCurve, double dLambda, const Finance::TermStructure<double, double> & dSigma) : dLambda_(dLambda)
+    LinearGaussianMarkov::LinearGaussianMarkov(const Finance::YieldCurve & sDiscountCurve, double dLambda, const Finance::TermStructure<double, double> & dSigma) : dLambda_(dLambda), iNThreads_(1), lSeed_(0), eSimulationScheme_(PSEUDO_RANDOM), eScrambling_(RandomNumbers::LINEAR_SCRAMBLING)
     {
         sDiscountCurve_ = sDiscountCurve;
         sForwardCurve_ = sDiscountCurve;
 
         dSigma_ = dSigma;
+        ComputeIntegralTables();
     }
     
-    LinearGaussianMarkov::LinearGaussianMarkov(const Finance::YieldCurve & sDiscountCurve, const Finance::YieldCurve & sForwardCurve, double dLambda, const Finance::TermStructure<double, double> & dSigma) : dLambda_(dLambda), dSigma_(dSigma)
+    LinearGaussianMarkov::LinearGaussianMarkov(const Finance::YieldCurve & sDiscountCurve, const Finance::YieldCurve & sForwardCurve, double dLambda, const Finance::TermStructure<double, double> & dSigma) : dLambda_(dLambda), dSigma_(dSigma), iNThreads_(1), lSeed_(0), eSimulationScheme_(PSEUDO_RANDOM), eScrambling_(RandomNumbers::LINEAR_SCRAMBLING)
     {
         sDiscountCurve_ = sDiscountCurve;
         sForwardCurve_ = sForwardCurve;
+        ComputeIntegralTables();
     }
     
     LinearGaussianMarkov::~LinearGaussianMarkov()
     {}
     
-    void LinearGaussianMarkov::Simulate(std::size_t iNRealisations,
-                                        const std::vector<double> & dSimulationTenors,
-                                        Finance::SimulationData & sSimulationData,
-                                        bool bIsStepByStepMC) const
+    LGMPathGenerator::LGMPathGenerator(const LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, bool bIsStepByStepMC) :
+    dStdDev_(sModel.SimulationStdDev(dSimulationTenors, bIsStepByStepMC)),
+    lSeed_(sModel.lSeed_),
+    pSequence_(0),
+    pBridge_(0)
     {
-        Utilities::require(!dSimulationTenors.empty(), "Simulation Times is empty");
-        Utilities::require(iNRealisations > 0, "Number of paths has to be positive");
-        
-        sSimulationData.SetDates(dSimulationTenors);
-        
-        std::vector<double> dSimulationTenorsCopy;
-        dSimulationTenorsCopy.insert(dSimulationTenorsCopy.begin(), 0.0);
-        dSimulationTenorsCopy.insert(dSimulationTenorsCopy.end(), dSimulationTenors.begin(), dSimulationTenors.end());
-        
-        //  In this function, we will simulate the factor \int_{s}^{t} a(u) dW^Q_u for s,t in the simulation tenors vector
-        std::size_t iNTenors = dSimulationTenorsCopy.size();
-        RandomNumbers::Gaussian1D sGaussian(0.0, 1.0, iNRealisations * iNTenors, 0);
-        sGaussian.GenerateGaussian();
-        std::vector<double> dGaussianRealisations = sGaussian.GetRealisations();
+        if (sModel.eSimulationScheme_ == QUASI_RANDOM)
+        {
+            //  One dimension of the Sobol sequence per simulation tenor, mapped by the brownian bridge on the variance of the factor
+            std::vector<double> dVariances(dStdDev_.size());
+            for (std::size_t i = 0 ; i < dStdDev_.size() ; ++i)
+            {
+                dVariances[i] = dStdDev_[i] * dStdDev_[i];
+            }
+            pSequence_ = new RandomNumbers::Sobol(dStdDev_.size(), sModel.eScrambling_, lSeed_);
+            pBridge_ = new RandomNumbers::BrownianBridge(dVariances);
+        }
+        else
+        {
+            //  Standard deviations of the independent increments of the factor between consecutive simulation tenors
+            dIncrementStdDev_.resize(dStdDev_.size());
+            double dPreviousVariance = 0.0;
+            for (std::size_t i = 0 ; i < dStdDev_.size() ; ++i)
+            {
+                double dVariance = dStdDev_[i] * dStdDev_[i];
+                Utilities::require(dVariance >= dPreviousVariance, "LGMPathGenerator : the variance of the factor has to be non decreasing with the simulation tenors");
+                dIncrementStdDev_[i] = sqrt(dVariance - dPreviousVariance);
+                dPreviousVariance = dVariance;
+            }
+        }
+    }
+    
+    LGMPathGenerator::~LGMPathGenerator()
+    {
+        delete pSequence_;
+        delete pBridge_;
+    }
+    
+    void LGMPathGenerator::Generate(std::size_t iFirstPath, Utilities::MatrixView<double> dPaths) const
+    {
+        std::size_t iNTenors = dStdDev_.size(), iNPaths = dPaths.columns();
+        Utilities::require(dPaths.rows() == iNTenors, "LGMPathGenerator : one row per simulation tenor");
+        if (iNPaths == 0)
+        {
+            return;
+        }
         
-        if (bIsStepByStepMC)
+        if (pSequence_)
         {
-            //  Step by Step Monte Carlo
-            for (std::size_t iSimulationTenor = 0 ; iSimulationTenor < iNTenors - 1 ; ++iSimulationTenor)
+            //  The path iPath is built from the point iPath of the Sobol sequence by the brownian bridge
+            std::vector<double> dGaussians(iNTenors * iNPaths);
+            Utilities::MatrixView<double> dGaussiansView(&dGaussians[0], iNTenors, iNPaths, iNPaths);
+            pSequence_->Gaussians(pSequence_->GetFirstIndex() + iFirstPath, dGaussiansView);
+            pBridge_->Transform(dGaussiansView, dPaths);
+        }
+        else
+        {
+            //  The increment of the path iPath between the simulation tenors i - 1 and i is the gaussian iPath of the substream i of the 
+            //  generator : a range of paths is a contiguous range of counters (batched generation in place), and the paths are the 
+            //  cumulated increments (same process as the brownian bridge of the quasi-random scheme)
+            for (std::size_t iSimulationTenor = 0 ; iSimulationTenor < iNTenors ; ++iSimulationTenor)
             {
-                double dVariance = 0.0;
-                if (!dSigma_.IsTermStructure())
+                Utilities::ArrayView<double> dTenorPaths = dPaths[iSimulationTenor];
+                RandomNumbers::Philox sGenerator(lSeed_, iSimulationTenor);
+                sGenerator.Gaussians(iFirstPath, dTenorPaths);
+                
+                double dIncrementStdDev = dIncrementStdDev_[iSimulationTenor];
+                if (iSimulationTenor == 0)
                 {
-                    dVariance= dSigma_.GetValues()[0] * dSigma_.GetValues()[0] * MathFunctions::Beta_OU(-2.0 * dLambda_, dSimulationTenorsCopy[iSimulationTenor + 1]);
+                    for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                    {
+                        dTenorPaths[iPath] *= dIncrementStdDev;
+                    }
                 }
                 else
                 {
-                    std::cout<<"Not yet implemented"<<std::endl;
+                    Utilities::ArrayView<double> dPreviousTenorPaths = dPaths[iSimulationTenor - 1];
+                    for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                    {
+                        dTenorPaths[iPath] = dPreviousTenorPaths[iPath] + dIncrementStdDev * dTenorPaths[iPath];
+                    }
                 }
+            }
+        }
+    }
+    
+    namespace {
+        
+        //  Simulation of a block of paths : the paths are a pure function of their index, so that they depend neither on the number 
+        //  of threads nor on the order in which the blocks are simulated
+        class SimulationBlockTask : public Utilities::ParallelTask
+        {
+        public:
+            SimulationBlockTask(const LGMPathGenerator & sGenerator, std::size_t iNRealisations, std::size_t iBlockSize, Finance::SimulationData & sSimulationData) :
+            sGenerator_(sGenerator),
+            iNRealisations_(iNRealisations),
+            iBlockSize_(iBlockSize),
+            sSimulationData_(sSimulationData)
+            {}
+            
+            virtual void Run(std::size_t iBlock)
+            {
+                std::size_t iFirstPath = iBlock * iBlockSize_, iNPaths = std::min(iBlockSize_, iNRealisations_ - iFirstPath);
+                
+                //  Each block writes in its own slice of paths
+                Finance::SimulationData::FactorDatesView dFactor = sSimulationData_.GetFactorDatesPaths(0);
+                Finance::SimulationData::FactorDatesView dPaths = dFactor.SliceColumns(iFirstPath, iNPaths), dAntitheticPaths = dFactor.SliceColumns(iNRealisations_ + iFirstPath, iNPaths);
+                sGenerator_.Generate(iFirstPath, dPaths);
                 
-                for (std::size_t iPath = 0 ; iPath < iNRealisations ; ++iPath)
+                for (std::size_t iSimulationTenor = 0 ; iSimulationTenor < dPaths.rows() ; ++iSimulationTenor)
                 {
-                    double dCurrentValue = dGaussianRealisations[iPath + iNRealisations * iSimulationTenor] * sqrt(dVariance);
-                    sSimulationData.Put(iSimulationTenor, iPath, std::vector<double>(1, dCurrentValue));
-                    if (1) // Antithetic variables
+                    Utilities::ArrayView<double> dTenorPaths = dPaths[iSimulationTenor], dTenorAntitheticPaths = dAntitheticPaths[iSimulationTenor];
+                    for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
                     {
-                        sSimulationData.Put(iSimulationTenor, iNRealisations + iPath, std::vector<double>(1, -dCurrentValue));
+                        //  Antithetic variables
+                        dTenorAntitheticPaths[iPath] = - dTenorPaths[iPath];
                     }
                 }
             }
+            
+        private:
+            const LGMPathGenerator & sGenerator_;
+            std::size_t iNRealisations_, iBlockSize_;
+            Finance::SimulationData & sSimulationData_;
+        };
+    }
+    
+    std::vector<double> LinearGaussianMarkov::SimulationStdDev(const std::vector<double> & dSimulationTenors, bool bIsStepByStepMC) const
+    {
+        //  In this function, we will simulate the factor \int_{s}^{t} a(u) dW^Q_u for s,t in the simulation tenors vector
+        std::size_t iNTenors = dSimulationTenors.size();
+        
+        //  Compute the standard deviation
+        std::vector<double> dStdDev(iNTenors, 0.0);
+        if (bIsStepByStepMC)
+        {
+            //  Step by Step Monte Carlo
+            FactorVariance(Utilities::ArrayView<const double>(&dSimulationTenors[0], iNTenors), Utilities::ArrayView<double>(&dStdDev[0], iNTenors));
+            for (std::size_t iSimulationTenor = 0 ; iSimulationTenor < iNTenors ; ++iSimulationTenor)
+            {
+                dStdDev[iSimulationTenor] = sqrt(dStdDev[iSimulationTenor]);
+            }
         }
         else
         {
             //  Path by Path Monte Carlo
-            
-            //  Compute the standard deviation
-            std::vector<double> dStdDev(iNTenors - 1, 0.0);
             if (!dSigma_.IsTermStructure())
             {
                 std::cout << "LinearGaussianMarkov::Simulate : Simulation with no Term-structure" << std::endl;
@@ -96,23 +197,39 @@ namespace Processes {
                 
                 std::cout<<"Not yet implemented"<<std::endl;
             }
-            //  Begin the simulation
-            for (std::size_t iPath = 0 ; iPath < iNRealisations ; ++iPath)
-            {
-                //  We simulate the wanted factor
-                double dCurrentValue = 0.0;
-                for (std::size_t iSimulationTenor = 0 ; iSimulationTenor < iNTenors - 1; ++iSimulationTenor)
-                {
-                    dCurrentValue = dGaussianRealisations[iPath + iSimulationTenor * iNRealisations] * dStdDev[iSimulationTenor];
-                    sSimulationData.Put(iSimulationTenor, iPath, std::vector<double>(1,dCurrentValue));
-                    if (1) // Antithetic variables
-                    {
-                        sSimulationData.Put(iSimulationTenor, iPath + iNRealisations, std::vector<double>(1,- dCurrentValue));
-                    }
-                }
-                
-            }
         }
+        return dStdDev;
+    }
+    
+    void LinearGaussianMarkov::Simulate(std::size_t iNRealisations,
+                                        const std::vector<double> & dSimulationTenors,
+                                        Finance::SimulationData & sSimulationData,
+                                        bool bIsStepByStepMC) const
+    {
+        Utilities::require(!dSimulationTenors.empty(), "Simulation Times is empty");
+        Utilities::require(iNRealisations > 0, "Number of paths has to be positive");
+        
+        sSimulationData.SetDates(dSimulationTenors);
+        
+        LGMPathGenerator sGenerator(*this, dSimulationTenors, bIsStepByStepMC);
+        
+        //  One factor, iNRealisations paths and their antithetic paths
+        sSimulationData.Allocate(dSimulationTenors.size(), 1, 2 * iNRealisations);
+        
+        //  Begin the simulation : the paths are split in blocks which are simulated in parallel
+        SimulationBlockTask sTask(sGenerator, iNRealisations, SIMULATIONBLOCKSIZE, sSimulationData);
+        Utilities::ThreadPool::GetThreadPool(iNThreads_).ParallelFor((iNRealisations + SIMULATIONBLOCKSIZE - 1) / SIMULATIONBLOCKSIZE, sTask);
+    }
+    
+    void LinearGaussianMarkov::SimulatePath(std::size_t iPath,
+                                            const std::vector<double> & dSimulationTenors,
+                                            std::vector<double> & dPath,
+                                            bool bIsStepByStepMC) const
+    {
+        //  Same draws as the ones used by Simulate for this path
+        LGMPathGenerator sGenerator(*this, dSimulationTenors, bIsStepByStepMC);
+        dPath.resize(dSimulationTenors.size());
+        sGenerator.Generate(iPath, Utilities::MatrixView<double>(&dPath[0], dPath.size(), 1, 1));
     }
     
     void LinearGaussianMarkov::ChangeOfProbability(double dT, 
@@ -122,25 +239,26 @@ namespace Processes {
         //  Create a new simulated data object w.r.t. the T-forward neutral probability
         //  The results factors sSimulationDataTForward are martingales under the T-forward neutral probability and the input factors sSimulationDataRiskNeutral are martingales under the risk neutral probability
         
-        sSimulationDataTForward.SetDates(sSimulationDataRiskNeutral.GetDateList());
+        const std::vector<long> & lDates = sSimulationDataRiskNeutral.GetDateList();
+        sSimulationDataTForward.SetDates(lDates);
 		
-        std::vector<long> lDates = sSimulationDataRiskNeutral.GetDateList();
-        Finance::SimulationData::Data sDataRiskNeutral = sSimulationDataRiskNeutral.GetData();
+        std::size_t iNFactors = sSimulationDataRiskNeutral.GetNbFactors(), iNPaths = sSimulationDataRiskNeutral.GetNbPaths();
+        sSimulationDataTForward.Allocate(sSimulationDataRiskNeutral.GetNbDates(), iNFactors, iNPaths);
 		
-        for (std::size_t iDate = 0 ; iDate < lDates.size() ; ++iDate)
+        for (std::size_t iDate = 0 ; iDate < sSimulationDataRiskNeutral.GetNbDates() ; ++iDate)
         {
             double dDate = lDates[iDate] / 365.0;
             
             double dBracket = BracketChangeOfProbability(dDate, dT); //  Bracket of the factor X_t and dB(t,T) / B(t,T)
             
-            for (std::size_t iPath =  0 ; iPath < sDataRiskNeutral.second[iDate].size() ; ++iPath)
+            for (std::size_t iVar = 0 ; iVar < iNFactors ; ++iVar)
             {
-                std::vector<double> dTForwardValues;
-                for (std::size_t iVar = 0 ; iVar < sDataRiskNeutral.second[iDate][iPath].size() ; ++iVar)
+                Finance::SimulationData::ConstFactorView dRiskNeutral = sSimulationDataRiskNeutral.GetFactorPaths(iDate, iVar);
+                Finance::SimulationData::FactorView dTForward = sSimulationDataTForward.GetFactorPaths(iDate, iVar);
+                for (std::size_t iPath =  0 ; iPath < iNPaths ; ++iPath)
                 {
-                    dTForwardValues.push_back(sDataRiskNeutral.second[iDate][iPath][iVar] - dBracket);
+                    dTForward[iPath] = dRiskNeutral[iPath] - dBracket;
                 }
-                sSimulationDataTForward.Put(iDate, iPath, dTForwardValues);
             }
 			
         }
@@ -148,203 +266,293 @@ namespace Processes {
 		std::cout << "Shift to " << dT << "Y-Forward Probability, done." << std::endl;
     }
     
-    double LinearGaussianMarkov::BracketChangeOfProbability(double dt, double dT) const
+    void LinearGaussianMarkov::ComputeIntegralTables()
     {
-        if (dSigma_.IsTermStructure())
+        //  Sigma is càdlàg : sigma_0 on [0, T_1[ (whatever T_0), sigma_i on [T_i, T_{i+1}[, flat after the last pillar
+        const std::vector<double> & dTis = dSigma_.GetVariables(), & dSigmaTis = dSigma_.GetValues();
+        Utilities::require(!dSigmaTis.empty(), "LinearGaussianMarkov : empty volatility");
+        dPillars_.assign(1, 0.0);
+        dSquaredSigmas_.assign(1, dSigmaTis[0] * dSigmaTis[0]);
+        for (std::size_t i = 1 ; i < dTis.size() ; ++i)
         {
-            if (std::abs(dLambda_) > BETAOUTHRESHOLD)
+            Utilities::require(dTis[i] >= dTis[i - 1], "LinearGaussianMarkov : volatility pillars are not sorted");
+            if (dTis[i] <= dPillars_.back())
             {
-                std::size_t i = 1;
-                std::vector<double> dTis = dSigma_.GetVariables(), dSigmaTis = dSigma_.GetValues();
-                double dBracket = 0.0;
-                
-                //  First part in case first time in term structure of volatility is not 0
-                
-                dBracket += dSigmaTis[0] * dSigmaTis[0] / (dLambda_ * dLambda_) * (exp(dLambda_ * dTis[0]) - 1.0 - 0.5 * exp(-dLambda_ * dT) * (exp(2.0 * dLambda_ * dTis[0]) - 1.0));
-                
-                //  Loop over the time in the term structure of volatility
-                
-                while (dTis[i] < dt && i < dTis.size())
-                {
-                    //  Sigma is supposed to be càdlàg
-                    dBracket += dSigmaTis[i - 1] * dSigmaTis[i - 1] / (dLambda_ * dLambda_) * (exp(dLambda_ * dTis[i]) - exp(dLambda_ * dTis[i - 1]) - exp(-dLambda_ * dT) * 0.5 * (exp(2.0 * dLambda_ * dTis[i]) - exp(-2.0 * dLambda_ * dTis[i - 1])));
-                    i++;
-                }
-                
-                //  Last term in the term structure
-                //  
-                //  Test if t is after the last date in the term-structure
-                if (i == dTis.size())
-                {
-                    i--;
-                }
-                dBracket += dSigmaTis[i] * dSigmaTis[i] / (dLambda_ * dLambda_) * (exp(dLambda_ * dt) - exp(dLambda_ * dTis[i]) - 0.5 * exp(-dLambda_ * dT) * (exp(2.0 * dLambda_ * dt) - exp(2.0 * dLambda_ * dTis[i])));
-                
-                return dBracket;
+                dSquaredSigmas_.back() = dSigmaTis[i] * dSigmaTis[i];
             }
             else
             {
-                std::size_t i = 1;
-                std::vector<double> dTis = dSigma_.GetVariables(), dSigmaTis = dSigma_.GetValues();
-                double dBracket = 0.0;
-                
-                //  First part in case first time in term structure of volatility is not 0
-                
-                dBracket += dSigmaTis[0] * dSigmaTis[0] * dTis[0] * (dT - dTis[0] * 0.5);
-                
-                //  Loop over the time in the term structure of volatility
-                
-                while (dTis[i] < dt && i < dTis.size())
-                {
-                    //  Sigma is supposed to be càdlàg
-                    dBracket += dSigmaTis[i - 1] * dSigmaTis[i - 1] * (dTis[i] - dTis[i - 1]) * (dT - (dTis[i] + dTis[i - 1]) * 0.5);
-                    i++;
-                }
-                
-                //  Last term in the term structure
-                //  
-                //  Test if t is after the last date in the term-structure
-                if (i == dTis.size())
-                {
-                    i--;
-                }
-                dBracket += dSigmaTis[i] * dSigmaTis[i] * (dt - dTis[i]) * (dT - (dt + dTis[i]) * 0.5);
-                
-                return dBracket;
+                dPillars_.push_back(dTis[i]);
+                dSquaredSigmas_.push_back(dSigmaTis[i] * dSigmaTis[i]);
             }
         }
+        
+        //  With g(s) = (exp(lambda s) - 1) / lambda : a(s)^2 = sigma^2 g'(s)^2 and a(s)^2 \beta(s) = sigma^2 g(s) g'(s), so that on [u,v]
+        //  \int a^2 = sigma^2 exp(2 lambda u) (v - u) (exp(2 lambda (v - u)) - 1) / (2 lambda (v - u)) and \int a^2 \beta = sigma^2 (g(v)^2 - g(u)^2) / 2
+        std::size_t iNPillars = dPillars_.size();
+        dExpPillars_.assign(iNPillars, 1.0);
+        dGPillars_.assign(iNPillars, 0.0);
+        dVarianceTable_.assign(iNPillars, 0.0);
+        dBetaVarianceTable_.assign(iNPillars, 0.0);
+        for (std::size_t i = 1 ; i < iNPillars ; ++i)
+        {
+            double dLength = dPillars_[i] - dPillars_[i - 1], dExpStart = dExpPillars_[i - 1];
+            double dGDelta = dExpStart * dLength * GenericMeanReversion::Phi(dLambda_ * dLength);
+            dExpPillars_[i] = exp(dLambda_ * dPillars_[i]);
+            dGPillars_[i] = dGPillars_[i - 1] + dGDelta;
+            dVarianceTable_[i] = dVarianceTable_[i - 1] + dSquaredSigmas_[i - 1] * dExpStart * dExpStart * dLength * GenericMeanReversion::Phi(2.0 * dLambda_ * dLength);
+            dBetaVarianceTable_[i] = dBetaVarianceTable_[i - 1] + dSquaredSigmas_[i - 1] * 0.5 * dGDelta * (dGPillars_[i] + dGPillars_[i - 1]);
+        }
+        
+        //  Kernel of the model : the parameters are only tested here
+        bool bIsSmallLambda = std::abs(dLambda_) < BETAOUTHRESHOLD;
+        if (iNPillars == 1)
+        {
+            eKernelType_ = bIsSmallLambda ? LGM_FLAT_SIGMA_SMALL_LAMBDA : LGM_FLAT_SIGMA;
+            pBondFactors_ = bIsSmallLambda ? &FlatSigmaBondFactors<SmallMeanReversion> : &FlatSigmaBondFactors<GenericMeanReversion>;
+        }
         else
         {
-            double dSigma = dSigma_.GetValues()[0];
-            if (std::abs(dLambda_) > BETAOUTHRESHOLD)
-            {
-                return dSigma * dSigma / (dLambda_ * dLambda_) * (exp(dLambda_ * dt) - 1.0 - 0.5 * exp(-dLambda_ * dT) * (-1.0 + exp(2.0 * dLambda_ * dt)));
-            }
-            else
-            {
-                return dSigma * dSigma * dt * (dT - dt * 0.5);
-            }
+            eKernelType_ = bIsSmallLambda ? LGM_PIECEWISE_SIGMA_SMALL_LAMBDA : LGM_PIECEWISE_SIGMA;
+            pBondFactors_ = bIsSmallLambda ? &PiecewiseSigmaBondFactors<SmallMeanReversion> : &PiecewiseSigmaBondFactors<GenericMeanReversion>;
         }
     }
     
-    double LinearGaussianMarkov::A(double t) const
+    template<class MeanReversion>
+    void LinearGaussianMarkov::FlatSigmaBondFactors(const LinearGaussianMarkov & sModel, double dt, double dT, double & dBetaDifference, double & dHalfDeterministPart)
     {
-        return dSigma_.Interpolate(t) * exp(dLambda_ * t);
+        FlatSigmaKernel<MeanReversion> sKernel(sModel.dLambda_, sModel.dSquaredSigmas_[0]);
+        dBetaDifference = sKernel.Beta(dT) - sKernel.Beta(dt);
+        dHalfDeterministPart = -0.5 * KernelDeterministPart(sKernel, dt, dT);
     }
     
-    double LinearGaussianMarkov::B(double t) const
+    template<class MeanReversion>
+    void LinearGaussianMarkov::PiecewiseSigmaBondFactors(const LinearGaussianMarkov & sModel, double dt, double dT, double & dBetaDifference, double & dHalfDeterministPart)
     {
-        return exp(-dLambda_ * t);
+        PiecewiseSigmaKernel<MeanReversion> sKernel(sModel.dLambda_, sModel.dPillars_, sModel.dSquaredSigmas_, sModel.dExpPillars_, sModel.dGPillars_,
+                                                    sModel.dVarianceTable_, sModel.dBetaVarianceTable_);
+        dBetaDifference = sKernel.Beta(dT) - sKernel.Beta(dt);
+        dHalfDeterministPart = -0.5 * KernelDeterministPart(sKernel, dt, dT);
     }
     
-    double LinearGaussianMarkov::DeterministPart(double dt, double dT) const
+    template<class Functor>
+    void LinearGaussianMarkov::ApplyKernel(Functor & sFunctor) const
     {
-        //  Compute the integral \int_{0}^{t} a(s)^2 (\beta(t) + \beta(T) - 2\beta(s))ds
-        if (dSigma_.IsTermStructure())
+        switch (eKernelType_)
+        {
+            case LGM_FLAT_SIGMA:
+                sFunctor(FlatSigmaKernel<GenericMeanReversion>(dLambda_, dSquaredSigmas_[0]));
+                break;
+            case LGM_FLAT_SIGMA_SMALL_LAMBDA:
+                sFunctor(FlatSigmaKernel<SmallMeanReversion>(dLambda_, dSquaredSigmas_[0]));
+                break;
+            case LGM_PIECEWISE_SIGMA:
+                sFunctor(PiecewiseSigmaKernel<GenericMeanReversion>(dLambda_, dPillars_, dSquaredSigmas_, dExpPillars_, dGPillars_, dVarianceTable_, dBetaVarianceTable_));
+                break;
+            case LGM_PIECEWISE_SIGMA_SMALL_LAMBDA:
+                sFunctor(PiecewiseSigmaKernel<SmallMeanReversion>(dLambda_, dPillars_, dSquaredSigmas_, dExpPillars_, dGPillars_, dVarianceTable_, dBetaVarianceTable_));
+                break;
+        }
+    }
+    
+    namespace {
+        
+        //  Functors applied to the kernel of the model : one dispatch for all the times of a batch
+        class IntegralsFunctor
         {
-            if (std::abs(dLambda_) > BETAOUTHRESHOLD)
+        public:
+            IntegralsFunctor(double dt) : dt_(dt), dVariance_(0.0), dBetaVariance_(0.0), dBeta_(0.0)
+            {}
+            
+            template<class Kernel>
+            void operator()(const Kernel & sKernel)
             {
-                std::size_t i = 1;
-                std::vector<double> dTis = dSigma_.GetVariables(), dSigmaTis = dSigma_.GetValues();
-                double dDeterministPart = 0.0;
-                
-                //  First part in case first time in term structure of volatility is not 0
-                
-                dDeterministPart += dSigmaTis[0] * dSigmaTis[0] / (dLambda_ * dLambda_) * (4.0 - (exp(-dLambda_ * dT) + exp(-dLambda_ * dt)) * (exp(dLambda_ * dTis[0]) + 1.0)) * (exp(dLambda_ * dTis[0]) - 1.0);
-                
-                //  Loop over the time in the term structure of volatility
-                
-                while (dTis[i] < dt && i < dTis.size())
-                {
-                    //  Sigma is supposed to be càdlàg
-                    dDeterministPart += dSigmaTis[i-1] * dSigmaTis[i-1] / (dLambda_ * dLambda_) * (4.0 - (exp(-dLambda_ * dT) + exp(-dLambda_ * dt)) * (exp(dLambda_ * dTis[i]) + exp(dLambda_ * dTis[i-1]))) * (exp(dLambda_ * dTis[i]) - exp(dLambda_ * dTis[i-1]));
-                    i++;
-                }
-                
-                //  Last term in the term structure
-                //  
-                //  Test if t is after the last date in the term-structure
-                if (i == dTis.size())
-                {
-                    i--;
-                }
-                dDeterministPart += dSigmaTis[i] * dSigmaTis[i] / (dLambda_ * dLambda_) * (4.0 - (exp(-dLambda_ * dT) + exp(-dLambda_ * dt)) * (dt + exp(dLambda_ * dTis[i]))) * (exp(dLambda_ * dt) - exp(dLambda_ * dTis[i]));;
-                
-                return 0.5 * dDeterministPart;
+                sKernel.Integrals(dt_, dVariance_, dBetaVariance_, dBeta_);
             }
-            else
+            
+            double dt_, dVariance_, dBetaVariance_, dBeta_;
+        };
+        
+        class BetaFunctor
+        {
+        public:
+            BetaFunctor(double dt) : dt_(dt), dBeta_(0.0)
+            {}
+            
+            template<class Kernel>
+            void operator()(const Kernel & sKernel)
             {
-                std::size_t i = 1;
-                std::vector<double> dTis = dSigma_.GetVariables(), dSigmaTis = dSigma_.GetValues();
-                double dDeterministPart = 0.0;
-                
-                //  First part in case first time in term structure of volatility is not 0
-                
-                dDeterministPart += dSigmaTis[0] * dSigmaTis[0] * dTis[0] * (dTis[0] - (dT + dt));
-                
-                //  Loop over the time in the term structure of volatility
-                
-                while (dTis[i] < dt && i < dTis.size())
-                {
-                    //  Sigma is supposed to be càdlàg
-                    dDeterministPart += dSigmaTis[i-1] * dSigmaTis[i-1] * (dTis[i] - dTis[i-1]) * (dTis[i] + dTis[i-1] - (dT + dt));
-                    i++;
-                }
-                
-                //  Last term in the term structure
-                //  
-                //  Test if t is after the last date in the term-structure
-                if (i == dTis.size())
-                {
-                    i--;
-                }
-                dDeterministPart += dSigmaTis[i] * dSigmaTis[i] * (dt - dTis[i]) * (dt + dTis[i] - (dT + dt));
-                
-                return 0.5 * dDeterministPart;
+                dBeta_ = sKernel.Beta(dt_);
             }
-        }
-        else
+            
+            double dt_, dBeta_;
+        };
+        
+        class DeterministPartFunctor
         {
-            double dSigma = dSigma_.GetValues()[0];
-            if (std::abs(dLambda_) > BETAOUTHRESHOLD)
+        public:
+            DeterministPartFunctor(double dt, double dT) : dt_(dt), dT_(dT), dDeterministPart_(0.0)
+            {}
+            
+            template<class Kernel>
+            void operator()(const Kernel & sKernel)
             {
-  				return 0.5 * dSigma * dSigma / (dLambda_ * dLambda_) * (4.0 * (exp(dLambda_ * dt) - 1.0) - (exp(-dLambda_ * dt) + exp(-dLambda_ * dT)) *(exp(2.0 * dLambda_ * dt) - 1.0));
+                dDeterministPart_ = KernelDeterministPart(sKernel, dt_, dT_);
             }
-            else
+            
+            double dt_, dT_, dDeterministPart_;
+        };
+        
+        class BracketFunctor
+        {
+        public:
+            BracketFunctor(Utilities::ArrayView<const double> dt, double dT, Utilities::ArrayView<double> dBrackets) : dt_(dt), dT_(dT), dBrackets_(dBrackets)
+            {}
+            
+            template<class Kernel>
+            void operator()(const Kernel & sKernel)
             {
-                return -0.5 * dSigma * dSigma * dt * dt * dT;
+                for (std::size_t i = 0 ; i < dt_.size() ; ++i)
+                {
+                    dBrackets_[i] = KernelBracket(sKernel, dt_[i], dT_);
+                }
             }
-        }
+            
+        private:
+            Utilities::ArrayView<const double> dt_;
+            double dT_;
+            Utilities::ArrayView<double> dBrackets_;
+        };
+        
+        class FactorVarianceFunctor
+        {
+        public:
+            FactorVarianceFunctor(Utilities::ArrayView<const double> dt, Utilities::ArrayView<double> dVariances) : dt_(dt), dVariances_(dVariances)
+            {}
+            
+            template<class Kernel>
+            void operator()(const Kernel & sKernel)
+            {
+                for (std::size_t i = 0 ; i < dt_.size() ; ++i)
+                {
+                    dVariances_[i] = KernelFactorVariance(sKernel, dt_[i]);
+                }
+            }
+            
+        private:
+            Utilities::ArrayView<const double> dt_;
+            Utilities::ArrayView<double> dVariances_;
+        };
+    }
+    
+    void LinearGaussianMarkov::Integrals(double dt, double & dVariance, double & dBetaVariance, double & dBeta) const
+    {
+        IntegralsFunctor sFunctor(dt);
+        ApplyKernel(sFunctor);
+        dVariance = sFunctor.dVariance_;
+        dBetaVariance = sFunctor.dBetaVariance_;
+        dBeta = sFunctor.dBeta_;
+    }
+    
+    double LinearGaussianMarkov::BracketChangeOfProbability(double dt, double dT) const
+    {
+        double dBracket = 0.0;
+        BracketChangeOfProbability(Utilities::ArrayView<const double>(&dt, 1), dT, Utilities::ArrayView<double>(&dBracket, 1));
+        return dBracket;
+    }
+    
+    void LinearGaussianMarkov::BracketChangeOfProbability(Utilities::ArrayView<const double> dt, double dT, Utilities::ArrayView<double> dBrackets) const
+    {
+        Utilities::require(dt.size() == dBrackets.size(), "LinearGaussianMarkov::BracketChangeOfProbability : input and output sizes are not the same");
+        BracketFunctor sFunctor(dt, dT, dBrackets);
+        ApplyKernel(sFunctor);
+    }
+    
+    double LinearGaussianMarkov::FactorVariance(double dt) const
+    {
+        double dVariance = 0.0;
+        FactorVariance(Utilities::ArrayView<const double>(&dt, 1), Utilities::ArrayView<double>(&dVariance, 1));
+        return dVariance;
+    }
+    
+    void LinearGaussianMarkov::FactorVariance(Utilities::ArrayView<const double> dt, Utilities::ArrayView<double> dVariances) const
+    {
+        Utilities::require(dt.size() == dVariances.size(), "LinearGaussianMarkov::FactorVariance : input and output sizes are not the same");
+        FactorVarianceFunctor sFunctor(dt, dVariances);
+        ApplyKernel(sFunctor);
+    }
+    
+    double LinearGaussianMarkov::A(double t) const
+    {
+        return dSigma_.Interpolate(t) * exp(dLambda_ * t);
+    }
+    
+    double LinearGaussianMarkov::B(double t) const
+    {
+        return exp(-dLambda_ * t);
+    }
+    
+    double LinearGaussianMarkov::Beta(double t) const
+    {
+        BetaFunctor sFunctor(t);
+        ApplyKernel(sFunctor);
+        return sFunctor.dBeta_;
+    }
+    
+    double LinearGaussianMarkov::DeterministPart(double dt, double dT) const
+    {
+        //  Compute the integral \int_{0}^{t} a(s)^2 (\beta(t) + \beta(T) - 2\beta(s))ds
+        DeterministPartFunctor sFunctor(dt, dT);
+        ApplyKernel(sFunctor);
+        return sFunctor.dDeterministPart_;
     }
     
     double LinearGaussianMarkov::BondPrice(double dt, double dT, double dX, const CurveName & eCurveName) const
     {
         Utilities::require(dt <= dT);
-        Finance::YieldCurve sYieldCurve;
-        if (eCurveName == DISCOUNT)
-        {
-            sYieldCurve = sDiscountCurve_;
-        }
-        else 
-        {
-            sYieldCurve = sForwardCurve_;
-        }
-        if (dt < dT)
-        {
-            return exp(-sYieldCurve.YC(dT) * dT) / exp(-sYieldCurve.YC(dt) * dt) * exp((MathFunctions::Beta_OU(dLambda_, dT) - MathFunctions::Beta_OU(dLambda_, dt)) * ( -0.5 * DeterministPart(dt, dT) - dX));
-        }
-        else 
+        return KernelBondPrice(dt, dT, dX, GetYieldCurve(eCurveName));
+    }
+    
+    void LinearGaussianMarkov::BondPrice(double dt, double dT, Utilities::ArrayView<const double> dX, Utilities::ArrayView<double> dPrices, const CurveName & eCurveName) const
+    {
+        Utilities::require(dt <= dT);
+        Utilities::require(dX.size() == dPrices.size(), "LinearGaussianMarkov::BondPrice : input and output sizes are not the same");
+        //  P(t,T,X) = P(0,T) / P(0,t) exp(- (\beta(T) - \beta(t)) (X + DeterministPart(t,T) / 2))
+        const Finance::YieldCurve & sYieldCurve = GetYieldCurve(eCurveName);
+        double dBetaDifference, dHalfDeterministPart;
+        pBondFactors_(*this, dt, dT, dBetaDifference, dHalfDeterministPart);
+        double dForwardBondPrice = exp(-sYieldCurve.YC(dT) * dT) / exp(-sYieldCurve.YC(dt) * dt);
+        for (std::size_t iPath = 0 ; iPath < dX.size() ; ++iPath)
         {
-            //  dt = dT
-            return 1.0;
+            dPrices[iPath] = dForwardBondPrice * exp(dBetaDifference * (dHalfDeterministPart - dX[iPath]));
         }
     }
     
     double LinearGaussianMarkov::Libor(double dt, double dStart, double dEnd, double dX, const CurveName & eCurveName, double dQA) const
     {
         //  Must change coverage to take into account real basis
-        double dDFStart = BondPrice(dt, dStart, dX, eCurveName);
-        double dDFEnd = BondPrice(dt, dEnd, dX, eCurveName);
+        const Finance::YieldCurve & sYieldCurve = GetYieldCurve(eCurveName);
+        double dDFStart = KernelBondPrice(dt, dStart, dX, sYieldCurve);
+        double dDFEnd = KernelBondPrice(dt, dEnd, dX, sYieldCurve);
         return 1.0 / (dEnd - dStart) * (dDFStart / dDFEnd * dQA - 1.0);
     }
-}
\ No newline at end of file
+    
+    void LinearGaussianMarkov::Libor(double dt, double dStart, double dEnd, Utilities::ArrayView<const double> dX, Utilities::ArrayView<double> dLibors, const CurveName & eCurveName, double dQA) const
+    {
+        //  Must change coverage to take into account real basis
+        Utilities::require(dt <= dStart && dt <= dEnd);
+        Utilities::require(dX.size() == dLibors.size(), "LinearGaussianMarkov::Libor : input and output sizes are not the same");
+        //  P(t,S,X) / P(t,E,X) = P(0,S) / P(0,E) exp((\beta(E) - \beta(S)) X + ...) : one exponential per path, no buffer
+        const Finance::YieldCurve & sYieldCurve = GetYieldCurve(eCurveName);
+        double dBetaDifferenceStart, dHalfDeterministPartStart, dBetaDifferenceEnd, dHalfDeterministPartEnd;
+        pBondFactors_(*this, dt, dStart, dBetaDifferenceStart, dHalfDeterministPartStart);
+        pBondFactors_(*this, dt, dEnd, dBetaDifferenceEnd, dHalfDeterministPartEnd);
+        double dForwardRatio = exp(-sYieldCurve.YC(dStart) * dStart) / exp(-sYieldCurve.YC(dEnd) * dEnd) * dQA;
+        double dDeterministExponent = dBetaDifferenceStart * dHalfDeterministPartStart - dBetaDifferenceEnd * dHalfDeterministPartEnd;
+        double dBetaSpread = dBetaDifferenceEnd - dBetaDifferenceStart, dCoverage = dEnd - dStart;
+        for (std::size_t iPath = 0 ; iPath < dX.size() ; ++iPath)
+        {
+            dLibors[iPath] = 1.0 / dCoverage * (dForwardRatio * exp(dDeterministExponent + dBetaSpread * dX[iPath]) - 1.0);
+        }
+    }
+}
@@ -11,9 +11,26 @@
 
 #include <iostream> 
 #include "HJM.h"
+#include "Sobol.h"
+#include "BrownianBridge.h"
+#include "ArrayView.h"
+#include "LGMKernels.h"
+
+//  Number of paths simulated with the same random stream (one task of the thread pool)
+#define SIMULATIONBLOCKSIZE 4096
 
 namespace Processes {
 
+    //  Kernel of the integrals of LinearGaussianMarkov (LGMKernels.h) : flat or piecewise constant sigma, generic lambda or |lambda| below
+    //  BETAOUTHRESHOLD
+    enum LGMKernelType
+    {
+        LGM_FLAT_SIGMA,
+        LGM_FLAT_SIGMA_SMALL_LAMBDA,
+        LGM_PIECEWISE_SIGMA,
+        LGM_PIECEWISE_SIGMA_SMALL_LAMBDA
+    };
+
     class LinearGaussianMarkov : public HeathJarrowMorton
     {
     protected:
@@ -21,6 +38,23 @@ namespace Processes {
         double dLambda_;
         Finance::TermStructure<double, double> dSigma_;
         
+        //  Cumulative integrals on the intervals of constant sigma, built once for each (lambda, sigma) by ComputeIntegralTables
+        //  dPillars_[i] : start of the i-th interval (dPillars_[0] = 0), dSquaredSigmas_[i] : sigma^2 on it
+        //  dExpPillars_[i] = exp(lambda T_i), dGPillars_[i] = (exp(lambda T_i) - 1) / lambda
+        //  dVarianceTable_[i] = \int_{0}^{T_i} a(s)^2 ds, dBetaVarianceTable_[i] = \int_{0}^{T_i} a(s)^2 \beta(s) ds
+        std::vector<double> dPillars_, dSquaredSigmas_, dExpPillars_, dGPillars_, dVarianceTable_, dBetaVarianceTable_;
+        //  Kernel selected by ComputeIntegralTables
+        LGMKernelType eKernelType_;
+        //  \beta(T) - \beta(t) and - DeterministPart(t,T) / 2 on the kernel of eKernelType_, selected by ComputeIntegralTables with it
+        typedef void (*BondFactorsFunction)(const LinearGaussianMarkov & sModel, double dt, double dT, double & dBetaDifference, double & dHalfDeterministPart);
+        BondFactorsFunction pBondFactors_;
+        
+        //  Parameters of the simulation
+        std::size_t iNThreads_;
+        unsigned long lSeed_;
+        SimulationScheme eSimulationScheme_;
+        RandomNumbers::SobolScrambling eScrambling_;
+        
     public:
 		
         LinearGaussianMarkov();
@@ -34,7 +68,7 @@ namespace Processes {
             return dLambda_;
         }
         
-        virtual Finance::TermStructure<double, double> GetSigma() const
+        virtual const Finance::TermStructure<double, double> & GetSigma() const
         {
             return dSigma_;
         }
@@ -42,21 +76,126 @@ namespace Processes {
         virtual void SetSigma(const Finance::TermStructure<double, double> & sSigmaTS)
         {
             dSigma_ = sSigmaTS;
+            ComputeIntegralTables();
+        }
+        
+        virtual LGMKernelType GetKernelType() const
+        {
+            return eKernelType_;
+        }
+        
+        //  Number of threads used by Simulate (the simulated paths do not depend on it)
+        virtual void SetNbThreads(std::size_t iNThreads)
+        {
+            iNThreads_ = iNThreads;
+        }
+        
+        virtual std::size_t GetNbThreads() const
+        {
+            return iNThreads_;
+        }
+        
+        //  Seed of the counter-based generator used by Simulate (0 by default) : same seed, same paths
+        virtual void SetSeed(unsigned long lSeed)
+        {
+            lSeed_ = lSeed;
+        }
+        
+        //  Random numbers used by Simulate : with QUASI_RANDOM, the dimensions of the Sobol sequence are mapped on the simulation tenors 
+        //  by a brownian bridge on the variance of the factor, and the scrambling is randomized by the seed
+        virtual void SetSimulationScheme(SimulationScheme eSimulationScheme, RandomNumbers::SobolScrambling eScrambling = RandomNumbers::LINEAR_SCRAMBLING)
+        {
+            eSimulationScheme_ = eSimulationScheme;
+            eScrambling_ = eScrambling;
         }
         
         virtual double BondPrice(double dt, double dT, double dX, const CurveName & eCurveName) const;
         virtual double Libor(double dt, double dStart, double dEnd, double dX, const CurveName & eCurveName, double dQA = 1.0) const;
+        //  Batched versions on the factors dX of many paths : the deterministic part is computed once, and each path only costs one 
+        //  exponential (dPrices / dLibors may be dX)
+        virtual void BondPrice(double dt, double dT, Utilities::ArrayView<const double> dX, Utilities::ArrayView<double> dPrices, const CurveName & eCurveName) const;
+        virtual void Libor(double dt, double dStart, double dEnd, Utilities::ArrayView<const double> dX, Utilities::ArrayView<double> dLibors, const CurveName & eCurveName, double dQA = 1.0) const;
         virtual void Simulate(std::size_t iNRealisations,
                               const std::vector<double> & dSimulationTenors,
                               Finance::SimulationData & sSimulationData,
                               bool bIsStepByStepMC) const;
+        //  Regenerate the single path iPath of Simulate (its antithetic path is the opposite)
+        virtual void SimulatePath(std::size_t iPath,
+                                  const std::vector<double> & dSimulationTenors,
+                                  std::vector<double> & dPath,
+                                  bool bIsStepByStepMC) const;
+        //  Bracket of the factor X_t and dB(t,T) / B(t,T) : \int_{0}^{t} a(s)^2 (\beta(T) - \beta(s)) ds
         virtual double BracketChangeOfProbability(double dt, double dT) const;
+        //  Variance of the factor X_t (the same under the risk neutral and the T-forward neutral probabilities)
+        virtual double FactorVariance(double dt) const;
+        //  Batched versions on many times : the kernel is selected once for all the times (dResults may be dt)
+        virtual void BracketChangeOfProbability(Utilities::ArrayView<const double> dt, double dT, Utilities::ArrayView<double> dBrackets) const;
+        virtual void FactorVariance(Utilities::ArrayView<const double> dt, Utilities::ArrayView<double> dVariances) const;
         virtual void ChangeOfProbability(double dT, const Finance::SimulationData & sSimulationDataRiskNeutral,
                                          Finance::SimulationData & sSimulationDataTForward) const;
         
         virtual double DeterministPart(double dt, double dT) const;
         virtual double A(double t) const;
         virtual double B(double t) const;
+        //  \beta(t) = (1 - exp(- lambda t)) / lambda
+        virtual double Beta(double t) const;
+        
+    protected:
+        //  Build the cumulative integral tables (to call whenever lambda or sigma change)
+        void ComputeIntegralTables();
+        //  \int_{0}^{t} a(s)^2 ds, \int_{0}^{t} a(s)^2 \beta(s) ds and \beta(t) with the kernel of the model
+        void Integrals(double dt, double & dVariance, double & dBetaVariance, double & dBeta) const;
+        //  Calls sFunctor(sKernel) with the kernel of eKernelType_
+        template<class Functor>
+        void ApplyKernel(Functor & sFunctor) const;
+        template<class MeanReversion>
+        static void FlatSigmaBondFactors(const LinearGaussianMarkov & sModel, double dt, double dT, double & dBetaDifference, double & dHalfDeterministPart);
+        template<class MeanReversion>
+        static void PiecewiseSigmaBondFactors(const LinearGaussianMarkov & sModel, double dt, double dT, double & dBetaDifference, double & dHalfDeterministPart);
+        
+        //  P(t,T,X) = P(0,T) / P(0,t) exp(- (\beta(T) - \beta(t)) (X + DeterministPart(t,T) / 2)) on the kernel of the model, without 
+        //  virtual call nor switch on the kernel type (for t = T, the bond price is exactly 1)
+        double KernelBondPrice(double dt, double dT, double dX, const Finance::YieldCurve & sYieldCurve) const
+        {
+            double dBetaDifference, dHalfDeterministPart;
+            pBondFactors_(*this, dt, dT, dBetaDifference, dHalfDeterministPart);
+            return exp(-sYieldCurve.YC(dT) * dT) / exp(-sYieldCurve.YC(dt) * dt) * exp(dBetaDifference * (dHalfDeterministPart - dX));
+        }
+        
+        //  Standard deviation of the simulated factor at each simulation tenor
+        std::vector<double> SimulationStdDev(const std::vector<double> & dSimulationTenors, bool bIsStepByStepMC) const;
+        
+        friend class LGMPathGenerator;
+    };
+    
+    //  Generator of the paths of LinearGaussianMarkov::Simulate block by block, set up once for a grid of simulation tenors
+    //  Any range of paths can be generated without the other ones (same values as Simulate, without the antithetic paths)
+    class LGMPathGenerator
+    {
+    public:
+        LGMPathGenerator(const LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, bool bIsStepByStepMC);
+        virtual ~LGMPathGenerator();
+        
+        std::size_t GetNbTenors() const
+        {
+            return dStdDev_.size();
+        }
+        
+        //  Paths iFirstPath, ..., iFirstPath + dPaths.columns() - 1 : dPaths[iSimulationTenor][iPath]
+        void Generate(std::size_t iFirstPath, Utilities::MatrixView<double> dPaths) const;
+        
+    private:
+        std::vector<double> dStdDev_;
+        unsigned long lSeed_;
+        //  Only for the pseudo-random scheme
+        std::vector<double> dIncrementStdDev_;
+        //  Only for the quasi-random scheme
+        RandomNumbers::Sobol * pSequence_;
+        RandomNumbers::BrownianBridge * pBridge_;
+        
+        //  Not copyable
+        LGMPathGenerator(const LGMPathGenerator &);
+        LGMPathGenerator & operator = (const LGMPathGenerator &);
     };
 }
 
@@ -0,0 +1,148 @@
+//
+//  LGMKernels.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_LGMKernels_h
+#define Seminaire_LGMKernels_h
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//  Kernels of the integrals of the LinearGaussianMarkov model, specialised at compile time on the volatility (flat or piecewise constant)
+//  and on the mean reversion (generic or close to 0) : LinearGaussianMarkov selects one of the four kernels when lambda or sigma change,
+//  and the loops over times or paths run on it without virtual call nor test of the parameters
+//  With g(s) = (exp(lambda s) - 1) / lambda and a(s) = sigma(s) g'(s) :
+//  V(t) = \int_{0}^{t} a(s)^2 ds, BV(t) = \int_{0}^{t} a(s)^2 \beta(s) ds and \beta(t) = (1 - exp(- lambda t)) / lambda
+
+namespace Processes {
+
+    //  Mean reversion policies : phi(x) = (exp(x) - 1) / x
+    struct GenericMeanReversion
+    {
+        static double Phi(double x)
+        {
+            return x != 0.0 ? expm1(x) / x : 1.0;
+        }
+    };
+
+    //  |lambda| below BETAOUTHRESHOLD : x = lambda t is tiny for any maturity, and the series of phi is exact in double precision
+    struct SmallMeanReversion
+    {
+        static double Phi(double x)
+        {
+            return 1.0 + x * (0.5 + x * (1.0 / 6.0 + x * (1.0 / 24.0)));
+        }
+    };
+
+    //  Integrals shared by the kernels, from the integrals at the start dStart of the interval of constant sigma containing t
+    template<class MeanReversion>
+    inline void IntegralsFromPillar(double dLambda, double dSquaredSigma, double dt, double dStart, double dExpStart, double dGStart,
+                                    double dVarianceStart, double dBetaVarianceStart, double & dVariance, double & dBetaVariance, double & dBeta)
+    {
+        //  From the start of the interval to t : only one exponential, (exp(2x) - 1) / (2x) = phi(x) (x phi(x) + 2) / 2
+        double dLength = dt - dStart, dLambdaLength = dLambda * dLength;
+        double dPhi = MeanReversion::Phi(dLambdaLength);
+        double dGDelta = dExpStart * dLength * dPhi, dG = dGStart + dGDelta;
+        double dPhi2 = dPhi * (dLambdaLength * dPhi + 2.0) * 0.5;
+
+        dVariance = dVarianceStart + dSquaredSigma * dExpStart * dExpStart * dLength * dPhi2;
+        dBetaVariance = dBetaVarianceStart + dSquaredSigma * 0.5 * dGDelta * (dG + dGStart);
+        //  \beta(t) = g(t) exp(- lambda t)
+        dBeta = dG / (dExpStart * (1.0 + dLambdaLength * dPhi));
+    }
+
+    //  Flat sigma : closed forms from 0, no table
+    template<class MeanReversion>
+    class FlatSigmaKernel
+    {
+    public:
+        FlatSigmaKernel(double dLambda, double dSquaredSigma) : dLambda_(dLambda), dSquaredSigma_(dSquaredSigma)
+        {}
+
+        void Integrals(double dt, double & dVariance, double & dBetaVariance, double & dBeta) const
+        {
+            IntegralsFromPillar<MeanReversion>(dLambda_, dSquaredSigma_, dt, 0.0, 1.0, 0.0, 0.0, 0.0, dVariance, dBetaVariance, dBeta);
+        }
+
+        double Beta(double dt) const
+        {
+            return dt * MeanReversion::Phi(-dLambda_ * dt);
+        }
+
+    private:
+        double dLambda_, dSquaredSigma_;
+    };
+
+    //  Piecewise constant sigma : integrals read on the cumulative tables of LinearGaussianMarkov at the interval of t (binary search)
+    template<class MeanReversion>
+    class PiecewiseSigmaKernel
+    {
+    public:
+        PiecewiseSigmaKernel(double dLambda,
+                             const std::vector<double> & dPillars,
+                             const std::vector<double> & dSquaredSigmas,
+                             const std::vector<double> & dExpPillars,
+                             const std::vector<double> & dGPillars,
+                             const std::vector<double> & dVarianceTable,
+                             const std::vector<double> & dBetaVarianceTable) :
+        dLambda_(dLambda),
+        dPillars_(dPillars),
+        dSquaredSigmas_(dSquaredSigmas),
+        dExpPillars_(dExpPillars),
+        dGPillars_(dGPillars),
+        dVarianceTable_(dVarianceTable),
+        dBetaVarianceTable_(dBetaVarianceTable)
+        {}
+
+        void Integrals(double dt, double & dVariance, double & dBetaVariance, double & dBeta) const
+        {
+            std::size_t i = std::upper_bound(dPillars_.begin(), dPillars_.end(), dt) - dPillars_.begin();
+            i = i > 0 ? i - 1 : 0;
+            IntegralsFromPillar<MeanReversion>(dLambda_, dSquaredSigmas_[i], dt, dPillars_[i], dExpPillars_[i], dGPillars_[i],
+                                               dVarianceTable_[i], dBetaVarianceTable_[i], dVariance, dBetaVariance, dBeta);
+        }
+
+        double Beta(double dt) const
+        {
+            return dt * MeanReversion::Phi(-dLambda_ * dt);
+        }
+
+    private:
+        double dLambda_;
+        const std::vector<double> & dPillars_, & dSquaredSigmas_, & dExpPillars_, & dGPillars_, & dVarianceTable_, & dBetaVarianceTable_;
+    };
+
+    //  Quantities of the model built on the integrals of a kernel
+    template<class Kernel>
+    inline double KernelFactorVariance(const Kernel & sKernel, double dt)
+    {
+        double dVariance, dBetaVariance, dBeta;
+        sKernel.Integrals(dt, dVariance, dBetaVariance, dBeta);
+        return dVariance;
+    }
+
+    //  \int_{0}^{t} a(s)^2 (\beta(T) - \beta(s)) ds
+    template<class Kernel>
+    inline double KernelBracket(const Kernel & sKernel, double dt, double dT)
+    {
+        double dVariance, dBetaVariance, dBeta;
+        sKernel.Integrals(dt, dVariance, dBetaVariance, dBeta);
+        return sKernel.Beta(dT) * dVariance - dBetaVariance;
+    }
+
+    //  \int_{0}^{t} a(s)^2 (\beta(t) + \beta(T) - 2\beta(s)) ds
+    template<class Kernel>
+    inline double KernelDeterministPart(const Kernel & sKernel, double dt, double dT)
+    {
+        double dVariance, dBetaVariance, dBeta;
+        sKernel.Integrals(dt, dVariance, dBetaVariance, dBeta);
+        return (dBeta + sKernel.Beta(dT)) * dVariance - 2.0 * dBetaVariance;
+    }
+}
+
+#endif
@@ -12,8 +12,30 @@
 #include "Require.h"
 #include "HullWhiteTSCorrection.h"
 #include "HullWhiteTS.h"
+#include "SwapVariance.h"
 #include "Weights.h"
 
+namespace {
+    //  Integrand of the multiplicative quanto adjustment of a Libor fixing at T1 and paid at T2 :
+    //  m -> (Gamma_Collat(m, T2) - Gamma_Collat(m, T1)) (rho Gamma_OIS(m, T2) - Gamma_Collat(m, T2))
+    class LiborQuantoIntegrand
+    {
+    public:
+        LiborQuantoIntegrand(const Maths::HullWhiteTS & sCollatHWTS, const Maths::HullWhiteTS & sOISHWTS, double dRhoCollatOIS, double dT1, double dT2) : sCollatHWTS_(sCollatHWTS), sOISHWTS_(sOISHWTS), dRhoCollatOIS_(dRhoCollatOIS), dT1_(dT1), dT2_(dT2)
+        {}
+        
+        double operator () (double dm) const
+        {
+            double dCollatT2 = sCollatHWTS_.Integral(dm, dT2_);
+            return (dCollatT2 - sCollatHWTS_.Integral(dm, dT1_)) * (dRhoCollatOIS_ * sOISHWTS_.Integral(dm, dT2_) - dCollatT2);
+        }
+        
+    private:
+        const Maths::HullWhiteTS & sCollatHWTS_, & sOISHWTS_;
+        double dRhoCollatOIS_, dT1_, dT2_;
+    };
+}
+
 namespace Processes {
     StochasticBasisSpread::StochasticBasisSpread()
     {}
@@ -58,19 +80,67 @@ namespace Processes {
     {
         //  numeric integration for now (may need exact computation)
         double dResult = 0;
+        Utilities::require(iNIntervals > 0, "LiborQuantoAdjustmentMultiplicative : no interval");
         
 		Maths::HullWhiteTS sCollatHWTS(sSigmaCollatTS, dLambdaCollat), sOISHWTS(sSigmaOISTS, dLambdaOIS);
+        
+        //  Middle of each small interval, and the integrals from the middles in three batches
+        std::vector<double> dMiddles(iNIntervals), dT1s(iNIntervals, dT1), dT2s(iNIntervals, dT2);
+        std::vector<double> dCollatT1(iNIntervals), dCollatT2(iNIntervals), dOIST2(iNIntervals);
         for (std::size_t iInterval = 0 ; iInterval < iNIntervals ; ++iInterval)
         {
-            //  Middle of each small interval
-            double dMiddle = dt + (iInterval + 0.5) * (dT1 - dt) / iNIntervals;
-            double df = (sCollatHWTS.Integral(dMiddle, dT2) - sCollatHWTS.Integral(dMiddle, dT1)) * (dRhoCollatOIS * sOISHWTS.Integral(dMiddle, dT2) - sCollatHWTS.Integral(dMiddle, dT2));
+            dMiddles[iInterval] = dt + (iInterval + 0.5) * (dT1 - dt) / iNIntervals;
+        }
+        Utilities::ArrayView<const double> sMiddles(&dMiddles[0], iNIntervals);
+        sCollatHWTS.Integral(sMiddles, Utilities::ArrayView<const double>(&dT1s[0], iNIntervals), Utilities::ArrayView<double>(&dCollatT1[0], iNIntervals));
+        sCollatHWTS.Integral(sMiddles, Utilities::ArrayView<const double>(&dT2s[0], iNIntervals), Utilities::ArrayView<double>(&dCollatT2[0], iNIntervals));
+        sOISHWTS.Integral(sMiddles, Utilities::ArrayView<const double>(&dT2s[0], iNIntervals), Utilities::ArrayView<double>(&dOIST2[0], iNIntervals));
+        
+        for (std::size_t iInterval = 0 ; iInterval < iNIntervals ; ++iInterval)
+        {
+            double df = (dCollatT2[iInterval] - dCollatT1[iInterval]) * (dRhoCollatOIS * dOIST2[iInterval] - dCollatT2[iInterval]);
             dResult += df * (dT1 - dt);
         }
         dResult /= iNIntervals;
         return exp(-dResult);
     }
     
+    double StochasticBasisSpread::LiborQuantoAdjustmentMultiplicative(const Finance::TermStructure<double, double> & sSigmaOISTS, 
+                                                                      const Finance::TermStructure<double, double> & sSigmaCollatTS, 
+                                                                      double dLambdaOIS, 
+                                                                      double dLambdaCollat, 
+                                                                      double dRhoCollatOIS,
+                                                                      double dt,
+                                                                      double dT1,
+                                                                      double dT2) const
+    {
+        //  For m < T1, Gamma_Collat(m, T2) - Gamma_Collat(m, T1) = Gamma_Collat(T1, T2) : the integral of the integrand is 
+        //  Gamma_Collat(T1, T2) (rho \int Gamma_OIS(m, T2) dm - \int Gamma_Collat(m, T2) dm), both iterated integrals in closed form
+        Maths::HullWhiteTS sCollatHWTS(sSigmaCollatTS, dLambdaCollat), sOISHWTS(sSigmaOISTS, dLambdaOIS);
+        double dResult = sCollatHWTS.Integral(dT1, dT2) * (dRhoCollatOIS * sOISHWTS.IteratedIntegral(dt, dT1, dT2) - sCollatHWTS.IteratedIntegral(dt, dT1, dT2));
+        return exp(-dResult);
+    }
+    
+    double StochasticBasisSpread::LiborQuantoAdjustmentMultiplicative(const Finance::TermStructure<double, double> & sSigmaOISTS, 
+                                                                      const Finance::TermStructure<double, double> & sSigmaCollatTS, 
+                                                                      double dLambdaOIS, 
+                                                                      double dLambdaCollat, 
+                                                                      double dRhoCollatOIS,
+                                                                      double dt,
+                                                                      double dT1,
+                                                                      double dT2,
+                                                                      Maths::GaussKronrod & sQuadrature) const
+    {
+        Maths::HullWhiteTS sCollatHWTS(sSigmaCollatTS, dLambdaCollat), sOISHWTS(sSigmaOISTS, dLambdaOIS);
+        
+        //  The integrand has kinks at the pillars of both volatilities
+        std::vector<double> dBreakpoints(sSigmaCollatTS.GetVariables());
+        dBreakpoints.insert(dBreakpoints.end(), sSigmaOISTS.GetVariables().begin(), sSigmaOISTS.GetVariables().end());
+        
+        double dResult = sQuadrature.Integrate(LiborQuantoIntegrand(sCollatHWTS, sOISHWTS, dRhoCollatOIS, dT1, dT2), dt, dT1, dBreakpoints);
+        return exp(-dResult);
+    }
+    
     double StochasticBasisSpread::SwapQuantoAdjustmentMultiplicative( const Finance::TermStructure<double, double> & sSigmaOISTS, 
 																	  const Finance::TermStructure<double, double> & sSigmaCollatTS,
                                                                       double dLambdaOIS,
@@ -79,16 +149,17 @@ namespace Processes {
 																	  const Finance::YieldCurve & sYieldCurveOIS,
 																	  const Finance::YieldCurve & sYieldCurveCollat,
                                                                       double dt,
-																	  const std::vector <double> dS,
-																	  const std::vector <double> dT) const
+																	  const std::vector <double> & dS,
+																	  const std::vector <double> & dT) const
     {
 		Finance::Weights sWeightsOIS(sYieldCurveOIS, dS) ;
 		Finance::Weights sWeightsCollat(sYieldCurveCollat, dS) ;
-		std::vector <double> dWeightsOIS = sWeightsOIS.GetWeights() ;
-		std::vector <double> dWeightsCollat = sWeightsCollat.GetWeights() ;
+		const std::vector <double> & dWeightsOIS = sWeightsOIS.GetWeights() ;
+		const std::vector <double> & dWeightsCollat = sWeightsCollat.GetWeights() ;
 		
 		std::size_t iSizeT = dT.size() ;
 		std::size_t iSizeS = dS.size() ;
+		Utilities::require(iSizeS > 1, "SwapQuantoAdjustmentMultiplicative : the swap has no payment date");
 		
 		double dT_0 = dT[0], dT_n = dT[iSizeT-1], dResult = 0.0 ;
 		Finance::DF sDFCollat(sYieldCurveCollat) ;
@@ -97,41 +168,31 @@ namespace Processes {
 		double dDFratio_1 = dDF_0 / (dDF_0 - dDF_n) ;
 		double dDFratio_2 = dDF_n / (dDF_0 - dDF_n) ;
 		
-		Maths::TwoDimHullWhiteTS sTwoDimHullWhiteTSdf(sSigmaOISTS, sSigmaCollatTS), sTwoDimHullWhiteTSff(sSigmaCollatTS, sSigmaCollatTS) ;
+		//  Covariances of the legs of the swap (annuity on the payment dates, start and end) : OIS against Collat and Collat against Collat,
+		//  each in O(n) since the kernel is separable in the two payment dates
+		Utilities::ArrayView<const double> sPaymentDates(&dS[1], iSizeS - 1);
+		Maths::SwapVariance sSwapVariancedf(sSigmaOISTS, sSigmaCollatTS, dLambdaOIS, dLambdaCollat), sSwapVarianceff(sSigmaCollatTS, sSigmaCollatTS, dLambdaCollat, dLambdaCollat) ;
+		double dCovariancesdf[Maths::SWAPLEG_NLEGS][Maths::SWAPLEG_NLEGS], dCovariancesff[Maths::SWAPLEG_NLEGS][Maths::SWAPLEG_NLEGS];
+		sSwapVariancedf.Covariances(dt, dT_0, Utilities::ArrayView<const double>(&dWeightsOIS[0], iSizeS - 1), sPaymentDates, Utilities::ArrayView<const double>(&dWeightsCollat[0], iSizeS - 1), sPaymentDates, dT_0, dT_n, dCovariancesdf);
+		sSwapVarianceff.Covariances(dt, dT_0, Utilities::ArrayView<const double>(&dWeightsCollat[0], iSizeS - 1), sPaymentDates, Utilities::ArrayView<const double>(&dWeightsCollat[0], iSizeS - 1), sPaymentDates, dT_0, dT_n, dCovariancesff);
 		
 		// first term, cf. report
-		for (std::size_t iOIS = 0; iOIS < iSizeS - 1; ++iOIS) {
-			for (std::size_t iCollat = 0; iCollat < iSizeS - 1; ++iCollat) {
-				dResult -=  dRhoCollatOIS * dWeightsOIS[iOIS] * dWeightsCollat[iCollat] * sTwoDimHullWhiteTSdf.Integral(dt, dT_0, dS[iOIS + 1], dS[iCollat + 1], dLambdaOIS, dLambdaCollat) ;
-			}
-		}
+		dResult -= dRhoCollatOIS * dCovariancesdf[Maths::SWAPLEG_ANNUITY][Maths::SWAPLEG_ANNUITY];
 		
 		// second term
-		for (std::size_t iCollat_1 = 0; iCollat_1 < iSizeS - 1; ++iCollat_1) {
-			for (std::size_t iCollat_2 = 0; iCollat_2 < iSizeS - 1; ++iCollat_2) {
-				dResult +=  dWeightsCollat[iCollat_1] * dWeightsCollat[iCollat_2] * sTwoDimHullWhiteTSff.Integral(dt, dT_0, dS[iCollat_1 + 1], dS[iCollat_2 + 1], dLambdaCollat, dLambdaCollat) ;
-			}
-		}
+		dResult += dCovariancesff[Maths::SWAPLEG_ANNUITY][Maths::SWAPLEG_ANNUITY];
         
         // third term
-		for (std::size_t iOIS = 0; iOIS < iSizeS - 1; ++iOIS) {
-			dResult +=  dRhoCollatOIS * dWeightsOIS[iOIS] * dDFratio_1 * sTwoDimHullWhiteTSdf.Integral(dt, dT_0, dT_0, dS[iOIS + 1], dLambdaCollat, dLambdaOIS) ; // to check
-		}
+		dResult += dRhoCollatOIS * dDFratio_1 * dCovariancesdf[Maths::SWAPLEG_ANNUITY][Maths::SWAPLEG_START]; // to check
 		
 		// fourth term
-		for (std::size_t iCollat = 0; iCollat < iSizeS - 1; ++iCollat) {
-			dResult -=  dWeightsCollat[iCollat] * dDFratio_1 * sTwoDimHullWhiteTSff.Integral(dt, dT_0, dT_0, dS[iCollat + 1], dLambdaCollat, dLambdaCollat) ;
-		}
+		dResult -= dDFratio_1 * dCovariancesff[Maths::SWAPLEG_START][Maths::SWAPLEG_ANNUITY];
         
         // fifth term
-		for (std::size_t iOIS = 0; iOIS < iSizeS - 1; ++iOIS) {
-			dResult -=  dRhoCollatOIS * dWeightsOIS[iOIS] * dDFratio_2 * sTwoDimHullWhiteTSdf.Integral(dt, dT_0, dT_n, dS[iOIS + 1], dLambdaCollat, dLambdaOIS) ;
-		}
+		dResult -= dRhoCollatOIS * dDFratio_2 * dCovariancesdf[Maths::SWAPLEG_ANNUITY][Maths::SWAPLEG_END];
 		
 		// sixth term
-		for (std::size_t iCollat = 0; iCollat < iSizeS - 1; ++iCollat) {
-			dResult +=  dWeightsCollat[iCollat] * dDFratio_2 * sTwoDimHullWhiteTSff.Integral(dt, dT_0, dT_n, dS[iCollat + 1], dLambdaCollat, dLambdaCollat) ;
-		}
+		dResult += dDFratio_2 * dCovariancesff[Maths::SWAPLEG_END][Maths::SWAPLEG_ANNUITY];
 													
         return exp(dResult);
     }
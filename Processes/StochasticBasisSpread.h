@@ -11,6 +11,7 @@
 
 #include "TermStructure.h"
 #include "2DHullWhiteTS.h"
+#include "Quadrature.h"
 #include "YieldCurve.h"
 
 namespace Processes {
@@ -47,6 +48,28 @@ namespace Processes {
                                                       double dT1,
                                                       double dT2,
                                                       std::size_t iNIntervals) const;
+        
+        //  Same adjustment with the midpoint rule replaced by the closed form of the integral on the pillars of the volatilities (exact)
+        virtual double LiborQuantoAdjustmentMultiplicative(const Finance::TermStructure<double, double> & sSigmaOISTS, 
+                                                           const Finance::TermStructure<double, double> & sSigmaCollatTS, 
+                                                           double dLambdaOIS, 
+                                                           double dLambdaCollat, 
+                                                           double dRhoCollatOIS,
+                                                           double dt,
+                                                           double dT1,
+                                                           double dT2) const;
+        
+        //  Same adjustment by adaptive Gauss-Kronrod quadrature split at the pillars of the volatilities (error and number of evaluations 
+        //  in sQuadrature)
+        virtual double LiborQuantoAdjustmentMultiplicative(const Finance::TermStructure<double, double> & sSigmaOISTS, 
+                                                           const Finance::TermStructure<double, double> & sSigmaCollatTS, 
+                                                           double dLambdaOIS, 
+                                                           double dLambdaCollat, 
+                                                           double dRhoCollatOIS,
+                                                           double dt,
+                                                           double dT1,
+                                                           double dT2,
+                                                           Maths::GaussKronrod & sQuadrature) const;
 	
 		virtual double SwapQuantoAdjustmentMultiplicative(const Finance::TermStructure<double, double> & sSigmaOISTS, 
 													   const Finance::TermStructure<double, double> & sSigmaCollatTS,
@@ -56,8 +79,8 @@ namespace Processes {
 													   const Finance::YieldCurve & sYieldCurveOIS,
 													   const Finance::YieldCurve & sYieldCurveCollat,
                                                        double dt,
-													   const std::vector <double> dS,
-													   const std::vector <double> dT) const;
+													   const std::vector <double> & dS,
+													   const std::vector <double> & dT) const;
 	
 		};
 }
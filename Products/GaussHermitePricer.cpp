@@ -0,0 +1,212 @@
+//
+//  GaussHermitePricer.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include <algorithm>
+#include "GaussHermitePricer.h"
+#include "Quadrature.h"
+#include "Constants.h"
+#include "Require.h"
+
+namespace Products {
+
+    namespace {
+
+        //  Payoff of the single factor dX
+        double PayoffAt(const FactorPayoff & sPayoff, double dX)
+        {
+            double dPayoff = 0.0;
+            sPayoff.Payoff(Utilities::MatrixView<const double>(&dX, 1, 1, 1), Utilities::ArrayView<double>(&dPayoff, 1));
+            return dPayoff;
+        }
+    }
+
+    GaussHermitePricer::GaussHermitePricer(const Processes::LinearGaussianMarkov & sModel, double dRelativeTolerance, double dAbsoluteTolerance) :
+    sModel_(sModel),
+    dRelativeTolerance_(dRelativeTolerance),
+    dAbsoluteTolerance_(dAbsoluteTolerance),
+    dError_(0.0)
+    {
+        for (std::size_t iNNodes = GAUSSHERMITEMINNODES ; iNNodes <= GAUSSHERMITERULEMAXNODES ; iNNodes *= 2)
+        {
+            dHermiteNodes_.push_back(std::vector<double>());
+            dHermiteWeights_.push_back(std::vector<double>());
+            dLegendreNodes_.push_back(std::vector<double>());
+            dLegendreWeights_.push_back(std::vector<double>());
+            Maths::GaussHermiteRule(iNNodes, dHermiteNodes_.back(), dHermiteWeights_.back());
+            Maths::GaussLegendreRule(iNNodes, dLegendreNodes_.back(), dLegendreWeights_.back());
+        }
+    }
+
+    GaussHermitePricer::~GaussHermitePricer()
+    {}
+
+    double GaussHermitePricer::Rule(const FactorPayoff & sPayoff, double dMean, double dStdDev, const std::vector<double> & dNodes, const std::vector<double> & dWeights,
+                                    double dCenter, double dHalfLength, bool bDensity, std::vector<double> & dBuffer) const
+    {
+        //  One batch of factors and payoffs for all the nodes
+        std::size_t iNNodes = dNodes.size();
+        dBuffer.resize(2 * iNNodes);
+        for (std::size_t i = 0 ; i < iNNodes ; ++i)
+        {
+            dBuffer[i] = dMean + dStdDev * (dCenter + dHalfLength * dNodes[i]);
+        }
+        sPayoff.Payoff(Utilities::MatrixView<const double>(&dBuffer[0], 1, iNNodes, iNNodes), Utilities::ArrayView<double>(&dBuffer[iNNodes], iNNodes));
+
+        double dSum = 0.0;
+        for (std::size_t i = 0 ; i < iNNodes ; ++i)
+        {
+            double dWeight = dWeights[i];
+            if (bDensity)
+            {
+                double dZ = dCenter + dHalfLength * dNodes[i];
+                dWeight *= exp(-0.5 * dZ * dZ);
+            }
+            dSum += dWeight * dBuffer[iNNodes + i];
+        }
+        return bDensity ? dSum * dHalfLength / sqrt(2.0 * PI) : dSum;
+    }
+
+    double GaussHermitePricer::Expectation(const FactorPayoff & sPayoff, double dMean, double dStdDev, const std::vector<double> & dKinks, double & dError) const
+    {
+        //  Smooth pieces of [-GAUSSHERMITETRUNCATION, GAUSSHERMITETRUNCATION] between the kinks (only used with kinks)
+        std::vector<double> dBounds(1, -GAUSSHERMITETRUNCATION);
+        for (std::size_t i = 0 ; i < dKinks.size() ; ++i)
+        {
+            if (dKinks[i] > dBounds.back() && dKinks[i] < GAUSSHERMITETRUNCATION)
+            {
+                dBounds.push_back(dKinks[i]);
+            }
+        }
+        dBounds.push_back(GAUSSHERMITETRUNCATION);
+        bool bSmooth = dKinks.empty();
+
+        std::vector<double> dBuffer;
+        double dExpectation = 0.0;
+        dError = 0.0;
+        for (std::size_t iRule = 0 ; iRule < dHermiteNodes_.size() ; ++iRule)
+        {
+            double dPrevious = dExpectation;
+            if (bSmooth)
+            {
+                dExpectation = Rule(sPayoff, dMean, dStdDev, dHermiteNodes_[iRule], dHermiteWeights_[iRule], 0.0, 1.0, false, dBuffer);
+            }
+            else
+            {
+                dExpectation = 0.0;
+                for (std::size_t iPiece = 0 ; iPiece + 1 < dBounds.size() ; ++iPiece)
+                {
+                    double dCenter = 0.5 * (dBounds[iPiece] + dBounds[iPiece + 1]), dHalfLength = 0.5 * (dBounds[iPiece + 1] - dBounds[iPiece]);
+                    dExpectation += Rule(sPayoff, dMean, dStdDev, dLegendreNodes_[iRule], dLegendreWeights_[iRule], dCenter, dHalfLength, true, dBuffer);
+                }
+            }
+            if (iRule > 0)
+            {
+                //  Not converged at the last rule : the difference is returned as the error estimate
+                dError = std::abs(dExpectation - dPrevious);
+                if (dError <= std::max(dAbsoluteTolerance_, dRelativeTolerance_ * std::abs(dExpectation)))
+                {
+                    break;
+                }
+            }
+        }
+        return dExpectation;
+    }
+
+    void GaussHermitePricer::ScanKinks(const FactorPayoff & sPayoff, double dMean, double dStdDev, std::vector<double> & dKinks) const
+    {
+        std::vector<double> dScan(2 * GAUSSHERMITESCANPOINTS);
+        double dStep = 2.0 * GAUSSHERMITETRUNCATION / (GAUSSHERMITESCANPOINTS - 1);
+        for (std::size_t i = 0 ; i < GAUSSHERMITESCANPOINTS ; ++i)
+        {
+            dScan[i] = dMean + dStdDev * (-GAUSSHERMITETRUNCATION + i * dStep);
+        }
+        sPayoff.Payoff(Utilities::MatrixView<const double>(&dScan[0], 1, GAUSSHERMITESCANPOINTS, GAUSSHERMITESCANPOINTS), Utilities::ArrayView<double>(&dScan[GAUSSHERMITESCANPOINTS], GAUSSHERMITESCANPOINTS));
+
+        //  Bisection on each change between zero and non zero payoffs
+        const double * dPayoffs = &dScan[GAUSSHERMITESCANPOINTS];
+        dKinks.clear();
+        for (std::size_t i = 0 ; i + 1 < GAUSSHERMITESCANPOINTS ; ++i)
+        {
+            bool bLowerZero = dPayoffs[i] == 0.0;
+            if (bLowerZero != (dPayoffs[i + 1] == 0.0))
+            {
+                double dLower = -GAUSSHERMITETRUNCATION + i * dStep, dUpper = dLower + dStep;
+                for (std::size_t iBisection = 0 ; iBisection < GAUSSHERMITEBISECTIONS ; ++iBisection)
+                {
+                    double dMiddle = 0.5 * (dLower + dUpper);
+                    if ((PayoffAt(sPayoff, dMean + dStdDev * dMiddle) == 0.0) == bLowerZero)
+                    {
+                        dLower = dMiddle;
+                    }
+                    else
+                    {
+                        dUpper = dMiddle;
+                    }
+                }
+                dKinks.push_back(0.5 * (dLower + dUpper));
+            }
+        }
+    }
+
+    void GaussHermitePricer::FindKinks(const FactorPayoff & sPayoff, double dMean, double dStdDev, std::vector<double> & dKinks) const
+    {
+        Utilities::require(dStdDev > 0.0, "GaussHermitePricer : the factor is not random");
+        ScanKinks(sPayoff, dMean, dStdDev, dKinks);
+        for (std::size_t i = 0 ; i < dKinks.size() ; ++i)
+        {
+            dKinks[i] = dMean + dStdDev * dKinks[i];
+        }
+    }
+
+    void GaussHermitePricer::StandardKinks(const FactorPayoff & sPayoff, double dMean, double dStdDev, const std::vector<double> & dKinks, std::vector<double> & dStandardKinks) const
+    {
+        ScanKinks(sPayoff, dMean, dStdDev, dStandardKinks);
+        for (std::size_t i = 0 ; i < dKinks.size() ; ++i)
+        {
+            dStandardKinks.push_back((dKinks[i] - dMean) / dStdDev);
+        }
+        std::sort(dStandardKinks.begin(), dStandardKinks.end());
+        dStandardKinks.erase(std::unique(dStandardKinks.begin(), dStandardKinks.end()), dStandardKinks.end());
+    }
+
+    double GaussHermitePricer::Price(double dExpiry, double dT, const FactorPayoff & sPayoff, const std::vector<double> & dKinks) const
+    {
+        double dMean = -sModel_.BracketChangeOfProbability(dExpiry, dT), dStdDev = sqrt(sModel_.FactorVariance(dExpiry));
+        Utilities::require(dStdDev > 0.0, "GaussHermitePricer : the factor is not random");
+        double dDiscountFactor = exp(-sModel_.GetYieldCurve(Processes::DISCOUNT).YC(dT) * dT);
+
+        std::vector<double> dStandardKinks;
+        StandardKinks(sPayoff, dMean, dStdDev, dKinks, dStandardKinks);
+        double dError = 0.0, dPrice = dDiscountFactor * Expectation(sPayoff, dMean, dStdDev, dStandardKinks, dError);
+        dError_ = dDiscountFactor * dError;
+        return dPrice;
+    }
+
+    void GaussHermitePricer::Prices(double dExpiry, double dT, const std::vector<const FactorPayoff *> & sPayoffs, std::vector<double> & dPrices,
+                                    const std::vector<std::vector<double> > & dKinks) const
+    {
+        Utilities::require(dKinks.empty() || dKinks.size() == sPayoffs.size(), "GaussHermitePricer : one vector of kinks per payoff");
+        double dMean = -sModel_.BracketChangeOfProbability(dExpiry, dT), dStdDev = sqrt(sModel_.FactorVariance(dExpiry));
+        Utilities::require(dStdDev > 0.0, "GaussHermitePricer : the factor is not random");
+        double dDiscountFactor = exp(-sModel_.GetYieldCurve(Processes::DISCOUNT).YC(dT) * dT);
+
+        dPrices.resize(sPayoffs.size());
+        const std::vector<double> dNoKinks;
+        std::vector<double> dStandardKinks;
+        double dMaxError = 0.0;
+        for (std::size_t iPayoff = 0 ; iPayoff < sPayoffs.size() ; ++iPayoff)
+        {
+            StandardKinks(*sPayoffs[iPayoff], dMean, dStdDev, dKinks.empty() ? dNoKinks : dKinks[iPayoff], dStandardKinks);
+            double dError = 0.0;
+            dPrices[iPayoff] = dDiscountFactor * Expectation(*sPayoffs[iPayoff], dMean, dStdDev, dStandardKinks, dError);
+            dMaxError = std::max(dMaxError, dDiscountFactor * dError);
+        }
+        dError_ = dMaxError;
+    }
+}
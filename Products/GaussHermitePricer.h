@@ -0,0 +1,87 @@
+//
+//  GaussHermitePricer.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_GaussHermitePricer_h
+#define Seminaire_GaussHermitePricer_h
+
+#include <vector>
+#include "HullWhite.h"
+#include "MonteCarloEngine.h"
+
+//  Default tolerances of GaussHermitePricer on the expectation of the payoff (two successive rules agree within max(absolute, relative * |price|))
+#define GAUSSHERMITERELATIVETOLERANCE 1e-12
+#define GAUSSHERMITEABSOLUTETOLERANCE 1e-15
+
+//  Number of nodes of the first rule of GaussHermitePricer, doubled until convergence up to GAUSSHERMITERULEMAXNODES
+#define GAUSSHERMITEMINNODES 8
+
+//  Range [-GAUSSHERMITETRUNCATION, GAUSSHERMITETRUNCATION] of the standardised factor scanned for the kinks and integrated between them
+//  (the gaussian mass outside is below 1e-23), and number of points of the scan
+#define GAUSSHERMITETRUNCATION 10.0
+#define GAUSSHERMITESCANPOINTS 257
+
+//  Bisections on a kink (the width of the scan interval is divided by 2^GAUSSHERMITEBISECTIONS)
+#define GAUSSHERMITEBISECTIONS 52
+
+namespace Products {
+
+    //  Deterministic pricer of the european payoffs of the factor X_t of LinearGaussianMarkov at one date t : the payoff is integrated against
+    //  the gaussian density of X_t (mean - Bracket(t,T) and variance V(t) in the T-forward neutral probability) instead of being sampled
+    //  The payoffs are the FactorPayoff of StreamingMonteCarlo built on the single simulation tenor t (the factors are on the first row)
+    //  Kinks : the payoff is evaluated on a grid of the standardised factor, and each change between zero and non zero values (the strike of
+    //  an option, the barrier of a digital) is located by bisection; the kinks inside a zero region or between two points of the scan have
+    //  to be given by the caller
+    //  Without kink, the expectation is computed by Gauss-Hermite rules, else by Gauss-Legendre rules on each smooth piece between the kinks :
+    //  in both cases the number of nodes is doubled until two successive rules agree (evaluations of the payoff by batches of nodes)
+    //  Error : the difference between the last two rules (discounted), as GaussKronrod::GetError ; it is above the tolerance when the rules
+    //  of GAUSSHERMITERULEMAXNODES nodes have not converged, which the caller has to check
+    class GaussHermitePricer
+    {
+    public:
+        GaussHermitePricer(const Processes::LinearGaussianMarkov & sModel, double dRelativeTolerance = GAUSSHERMITERELATIVETOLERANCE, double dAbsoluteTolerance = GAUSSHERMITEABSOLUTETOLERANCE);
+        virtual ~GaussHermitePricer();
+
+        //  Price of the payoff of X_dExpiry paid at dT (discounted on the discount curve), as StreamingMonteCarlo::Price with the simulation
+        //  tenor dExpiry ; dKinks : additional kinks of the payoff (values of the factor)
+        virtual double Price(double dExpiry, double dT, const FactorPayoff & sPayoff, const std::vector<double> & dKinks = std::vector<double>()) const;
+
+        //  Prices of many payoffs of X_dExpiry paid at dT : the distribution of the factor, the discount factor and the rules are shared by all
+        //  the payoffs ; dKinks : additional kinks of each payoff (empty, or one vector per payoff)
+        virtual void Prices(double dExpiry, double dT, const std::vector<const FactorPayoff *> & sPayoffs, std::vector<double> & dPrices,
+                            const std::vector<std::vector<double> > & dKinks = std::vector<std::vector<double> >()) const;
+
+        //  Error estimate of the last Price, or the largest over the payoffs of the last Prices
+        double GetError() const
+        {
+            return dError_;
+        }
+
+        //  Kinks of the payoff found by the scan (values of the factor), given the mean and the standard deviation of the factor
+        virtual void FindKinks(const FactorPayoff & sPayoff, double dMean, double dStdDev, std::vector<double> & dKinks) const;
+
+    private:
+        const Processes::LinearGaussianMarkov & sModel_;
+        double dRelativeTolerance_, dAbsoluteTolerance_;
+        //  Rules of GAUSSHERMITEMINNODES, 2 GAUSSHERMITEMINNODES, ..., GAUSSHERMITERULEMAXNODES nodes
+        std::vector<std::vector<double> > dHermiteNodes_, dHermiteWeights_, dLegendreNodes_, dLegendreWeights_;
+        mutable double dError_;
+
+        //  Expectation of the payoff of the factor dMean + dStdDev z for a standard gaussian z, with the sorted kinks dKinks in z, and the
+        //  difference between the last two rules in dError
+        double Expectation(const FactorPayoff & sPayoff, double dMean, double dStdDev, const std::vector<double> & dKinks, double & dError) const;
+        //  Sum of dWeights[i] * payoff(dMean + dStdDev * z_i) with z_i = dCenter + dHalfLength * dNodes[i], times phi(z_i) if bDensity
+        double Rule(const FactorPayoff & sPayoff, double dMean, double dStdDev, const std::vector<double> & dNodes, const std::vector<double> & dWeights,
+                    double dCenter, double dHalfLength, bool bDensity, std::vector<double> & dBuffer) const;
+        //  Sorted kinks in z found by the scan
+        void ScanKinks(const FactorPayoff & sPayoff, double dMean, double dStdDev, std::vector<double> & dKinks) const;
+        //  Sorted kinks in z found by the scan and given by the caller (values of the factor)
+        void StandardKinks(const FactorPayoff & sPayoff, double dMean, double dStdDev, const std::vector<double> & dKinks, std::vector<double> & dStandardKinks) const;
+    };
+}
+
+#endif
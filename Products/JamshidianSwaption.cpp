@@ -0,0 +1,170 @@
+//
+//  JamshidianSwaption.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include <algorithm>
+#include "JamshidianSwaption.h"
+#include "MathFunctions.h"
+#include "Require.h"
+#include "Schedule.h"
+#include "Coverage.h"
+
+namespace Products {
+
+    void FixedLegFlows(const Finance::YieldCurve & sYieldCurve, double dStart, double dEnd, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis,
+                       std::vector<double> & dPayments, std::vector<double> & dCoverages)
+    {
+        Utilities::Date::MyDate sToday, sStart(dStart), sEnd(dEnd);
+        Finance::Schedule sSchedule(sStart, sEnd, sYieldCurve, eBasis, eFrequency);
+        const std::vector<Finance::EventOfSchedule> & sEvents = sSchedule.GetSchedule();
+        Utilities::require(!sEvents.empty(), "FixedLegFlows : empty schedule");
+        dPayments.clear();
+        dCoverages.clear();
+        dPayments.reserve(sEvents.size() + 1);
+        dCoverages.reserve(sEvents.size() + 1);
+        for (std::size_t iEvent = 0 ; iEvent < sEvents.size() ; ++iEvent)
+        {
+            dPayments.push_back(sEvents[iEvent].GetEndDate().Diff(sToday));
+            dCoverages.push_back(sEvents[iEvent].GetCoverage());
+        }
+        Finance::Coverage sLastCoverage(eBasis, sEvents.back().GetEndDate(), sEnd);
+        dPayments.push_back(sEnd.Diff(sToday));
+        dCoverages.push_back(sLastCoverage.ComputeCoverage());
+    }
+
+    JamshidianSwaption::JamshidianSwaption(const Processes::LinearGaussianMarkov & sModel, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis, const Processes::CurveName & eCurveName) :
+    sModel_(sModel),
+    eFrequency_(eFrequency),
+    eBasis_(eBasis),
+    eCurveName_(eCurveName)
+    {}
+
+    JamshidianSwaption::~JamshidianSwaption()
+    {}
+
+    void JamshidianSwaption::SetUnderlying(double dExpiry, double dTenor, double dPayment, Underlying & sUnderlying) const
+    {
+        Utilities::require(dExpiry > 0.0 && dTenor > 0.0, "JamshidianSwaption : expiry and tenor have to be positive");
+        Utilities::require(dPayment >= dExpiry, "JamshidianSwaption : the swaption is paid before its expiry");
+        std::vector<double> dPayments;
+        FixedLegFlows(sModel_.GetYieldCurve(eCurveName_), dExpiry, dExpiry + dTenor, eFrequency_, eBasis_, dPayments, sUnderlying.dCoverages_);
+
+        //  Factor at the expiry : gaussian of variance V(t) and of mean - Bracket(t, dPayment) in the dPayment-forward neutral probability
+        double dVariance = sModel_.FactorVariance(dExpiry), dStdDev = sqrt(dVariance), dBetaExpiry = sModel_.Beta(dExpiry);
+        sUnderlying.dMean_ = -sModel_.BracketChangeOfProbability(dExpiry, dPayment);
+        sUnderlying.dDiscountFactor_ = exp(-sModel_.GetYieldCurve(Processes::DISCOUNT).YC(dPayment) * dPayment);
+
+        const Finance::YieldCurve & sYieldCurve = sModel_.GetYieldCurve(eCurveName_);
+        double dExpiryBond = exp(-sYieldCurve.YC(dExpiry) * dExpiry), dAnnuity = 0.0, dLastBond = 0.0;
+        std::size_t iNFlows = dPayments.size();
+        sUnderlying.dBonds_.resize(iNFlows);
+        sUnderlying.dBetas_.resize(iNFlows);
+        sUnderlying.dForwards_.resize(iNFlows);
+        sUnderlying.dStdDevs_.resize(iNFlows);
+        for (std::size_t iFlow = 0 ; iFlow < iNFlows ; ++iFlow)
+        {
+            double dBeta = sModel_.Beta(dPayments[iFlow]) - dBetaExpiry;
+            Utilities::require(dBeta > 0.0, "JamshidianSwaption : payment before the expiry");
+            sUnderlying.dBonds_[iFlow] = sModel_.BondPrice(dExpiry, dPayments[iFlow], 0.0, eCurveName_);
+            sUnderlying.dBetas_[iFlow] = dBeta;
+            //  E[exp(- b X)] = exp(- b m + b^2 V / 2)
+            sUnderlying.dForwards_[iFlow] = sUnderlying.dBonds_[iFlow] * exp(dBeta * (-sUnderlying.dMean_ + 0.5 * dBeta * dVariance));
+            sUnderlying.dStdDevs_[iFlow] = dBeta * dStdDev;
+
+            //  Forward swap rate on the curve
+            dLastBond = exp(-sYieldCurve.YC(dPayments[iFlow]) * dPayments[iFlow]) / dExpiryBond;
+            dAnnuity += sUnderlying.dCoverages_[iFlow] * dLastBond;
+        }
+        sUnderlying.dSwapRate_ = (1.0 - dLastBond) / dAnnuity;
+    }
+
+    double JamshidianSwaption::CriticalFactor(const Underlying & sUnderlying, double dStrike, double dX) const
+    {
+        //  Newton's method on log CB(X) : X <- X + log(CB(X)) CB(X) / sum_i b_i c_i B_i(X)
+        std::size_t iNFlows = sUnderlying.dBonds_.size();
+        for (std::size_t iIteration = 0 ; iIteration < JAMSHIDIANMAXITERATIONS ; ++iIteration)
+        {
+            double dCouponBond = 0.0, dDerivative = 0.0;
+            for (std::size_t iFlow = 0 ; iFlow < iNFlows ; ++iFlow)
+            {
+                double dCoupon = dStrike * sUnderlying.dCoverages_[iFlow] + (iFlow + 1 == iNFlows ? 1.0 : 0.0);
+                double dFlow = dCoupon * sUnderlying.dBonds_[iFlow] * exp(-sUnderlying.dBetas_[iFlow] * dX);
+                dCouponBond += dFlow;
+                dDerivative += sUnderlying.dBetas_[iFlow] * dFlow;
+            }
+            double dStep = log(dCouponBond) * dCouponBond / dDerivative;
+            dX += dStep;
+            if (std::abs(dStep) <= JAMSHIDIANTOLERANCE * std::max(1.0, std::abs(dX)))
+            {
+                return dX;
+            }
+        }
+        Utilities::require(false, "JamshidianSwaption : no convergence of the critical factor");
+        return dX;
+    }
+
+    double JamshidianSwaption::Price(const Underlying & sUnderlying, double dStrike, Finance::OptionType eOptionType, double & dX) const
+    {
+        Utilities::require(eOptionType == Finance::CALL || eOptionType == Finance::PUT, "JamshidianSwaption : payer (CALL) or receiver (PUT) only");
+        Utilities::require(dStrike >= 0.0, "JamshidianSwaption : the decomposition needs a non negative strike");
+        dX = CriticalFactor(sUnderlying, dStrike, dX);
+
+        //  Payer : puts on the bonds struck at B_i(X*), receiver : calls
+        Finance::OptionType eBondOptionType = eOptionType == Finance::CALL ? Finance::PUT : Finance::CALL;
+        std::size_t iNFlows = sUnderlying.dBonds_.size();
+        double dPrice = 0.0;
+        for (std::size_t iFlow = 0 ; iFlow < iNFlows ; ++iFlow)
+        {
+            double dCoupon = dStrike * sUnderlying.dCoverages_[iFlow] + (iFlow + 1 == iNFlows ? 1.0 : 0.0);
+            double dBondStrike = sUnderlying.dBonds_[iFlow] * exp(-sUnderlying.dBetas_[iFlow] * dX);
+            dPrice += dCoupon * MathFunctions::BlackScholes(sUnderlying.dForwards_[iFlow], dBondStrike, sUnderlying.dStdDevs_[iFlow], eBondOptionType);
+        }
+        return sUnderlying.dDiscountFactor_ * dPrice;
+    }
+
+    double JamshidianSwaption::Price(double dExpiry, double dTenor, double dStrike, Finance::OptionType eOptionType, double dPayment) const
+    {
+        Underlying sUnderlying;
+        SetUnderlying(dExpiry, dTenor, std::max(dPayment, dExpiry), sUnderlying);
+        double dX = sUnderlying.dMean_;
+        return Price(sUnderlying, dStrike, eOptionType, dX);
+    }
+
+    double JamshidianSwaption::SwapRate(double dExpiry, double dTenor) const
+    {
+        Underlying sUnderlying;
+        SetUnderlying(dExpiry, dTenor, dExpiry, sUnderlying);
+        return sUnderlying.dSwapRate_;
+    }
+
+    void JamshidianSwaption::Prices(const std::vector<double> & dExpiries,
+                                    const std::vector<double> & dTenors,
+                                    const std::vector<double> & dStrikes,
+                                    Finance::OptionType eOptionType,
+                                    std::vector<double> & dPrices,
+                                    bool bATMRelativeStrikes) const
+    {
+        std::size_t iNExpiries = dExpiries.size(), iNTenors = dTenors.size(), iNStrikes = dStrikes.size();
+        dPrices.resize(iNExpiries * iNTenors * iNStrikes);
+        Underlying sUnderlying;
+        for (std::size_t iExpiry = 0 ; iExpiry < iNExpiries ; ++iExpiry)
+        {
+            for (std::size_t iTenor = 0 ; iTenor < iNTenors ; ++iTenor)
+            {
+                SetUnderlying(dExpiries[iExpiry], dTenors[iTenor], dExpiries[iExpiry], sUnderlying);
+                double dShift = bATMRelativeStrikes ? sUnderlying.dSwapRate_ : 0.0;
+                //  The root of the previous strike is the initial guess of the next one
+                double dX = sUnderlying.dMean_;
+                for (std::size_t iStrike = 0 ; iStrike < iNStrikes ; ++iStrike)
+                {
+                    dPrices[(iExpiry * iNTenors + iTenor) * iNStrikes + iStrike] = Price(sUnderlying, dShift + dStrikes[iStrike], eOptionType, dX);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  JamshidianSwaption.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_JamshidianSwaption_h
+#define Seminaire_JamshidianSwaption_h
+
+#include <vector>
+#include "HullWhite.h"
+#include "Frequency.h"
+#include "Basis.h"
+#include "Option.h"
+
+//  Maximum number of Newton iterations on the critical factor of the Jamshidian decomposition
+#define JAMSHIDIANMAXITERATIONS 50
+
+//  Convergence of the Newton iterations on the critical factor (absolute, the factor is of the order of its standard deviation)
+#define JAMSHIDIANTOLERANCE 1e-14
+
+namespace Products {
+
+    //  Payment dates and coverages of the fixed leg of the swap from dStart to dEnd, as in Annuity::ComputeAnnuity : one flow at the end
+    //  of each event of the schedule, and one last flow at dEnd (coverage from the end of the last event to dEnd)
+    void FixedLegFlows(const Finance::YieldCurve & sYieldCurve, double dStart, double dEnd, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis,
+                       std::vector<double> & dPayments, std::vector<double> & dCoverages);
+
+    //  Exact price of the european swaptions of LinearGaussianMarkov (Jamshidian's decomposition)
+    //  At the expiry t, the bond of maturity T_i is B_i(X) = B(t, T_i, 0) exp(- b_i X) with b_i = \beta(T_i) - \beta(t) > 0, so that the
+    //  value of the fixed leg plus notional CB(X) = sum_i c_i B_i(X) (c_i = K cvg_i, plus 1 at T_n) is decreasing in X
+    //  With X* the root of CB(X*) = 1, the payer swaption (1 - CB(X))^+ = sum_i c_i (B_i(X*) - B_i(X))^+ : a sum of Black-Scholes puts on the
+    //  lognormal bonds, and the receiver swaption the sum of the calls
+    //  X* is found by Newton's method on log CB (convex and decreasing, monotonic convergence from the first iteration)
+    class JamshidianSwaption
+    {
+    public:
+        //  Swaps of frequency eFrequency and basis eBasis on the curve eCurveName of the model (the options are discounted on the discount curve)
+        JamshidianSwaption(const Processes::LinearGaussianMarkov & sModel, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis, const Processes::CurveName & eCurveName);
+        virtual ~JamshidianSwaption();
+
+        //  Price of the swaption of expiry dExpiry into the swap from dExpiry to dExpiry + dTenor of fixed rate dStrike >= 0 (CALL : payer,
+        //  PUT : receiver), paid at dPayment >= dExpiry (dPayment = 0 : paid at the expiry)
+        virtual double Price(double dExpiry, double dTenor, double dStrike, Finance::OptionType eOptionType, double dPayment = 0.0) const;
+
+        //  Forward swap rate of the swap from dExpiry to dExpiry + dTenor
+        virtual double SwapRate(double dExpiry, double dTenor) const;
+
+        //  Prices of the cube of swaptions : dPrices[(iExpiry * dTenors.size() + iTenor) * dStrikes.size() + iStrike]
+        //  The swap of each (expiry, tenor) is set up once for all the strikes, and each strike only costs the root and the n Black-Scholes
+        //  bATMRelativeStrikes : the strikes are spreads over the forward swap rate of each (expiry, tenor)
+        virtual void Prices(const std::vector<double> & dExpiries,
+                            const std::vector<double> & dTenors,
+                            const std::vector<double> & dStrikes,
+                            Finance::OptionType eOptionType,
+                            std::vector<double> & dPrices,
+                            bool bATMRelativeStrikes = false) const;
+
+    protected:
+        //  Swap at the expiry in the measure of the payment date
+        class Underlying
+        {
+        public:
+            //  Coverages, B(t, T_i, 0) and b_i of the flows
+            std::vector<double> dCoverages_, dBonds_, dBetas_;
+            //  Forwards of the bonds in the measure of the payment date E[B_i(X)] and standard deviations of their logarithms b_i sqrt(V(t))
+            std::vector<double> dForwards_, dStdDevs_;
+            //  Mean of the factor at the expiry in the measure of the payment date, discount factor of the payment date
+            double dMean_, dDiscountFactor_;
+            //  Forward swap rate
+            double dSwapRate_;
+        };
+
+        void SetUnderlying(double dExpiry, double dTenor, double dPayment, Underlying & sUnderlying) const;
+        //  Root of CB(X) = 1 from the initial guess dX
+        double CriticalFactor(const Underlying & sUnderlying, double dStrike, double dX) const;
+        double Price(const Underlying & sUnderlying, double dStrike, Finance::OptionType eOptionType, double & dX) const;
+
+    private:
+        const Processes::LinearGaussianMarkov & sModel_;
+        Finance::MyFrequency eFrequency_;
+        Finance::MyBasis eBasis_;
+        Processes::CurveName eCurveName_;
+    };
+}
+
+#endif
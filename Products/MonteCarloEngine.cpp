@@ -0,0 +1,412 @@
+//
+//  MonteCarloEngine.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "MonteCarloEngine.h"
+#include "MathFunctions.h"
+#include "ThreadPool.h"
+#include "Require.h"
+
+namespace Products {
+
+    namespace {
+
+        //  Index of the simulation tenor of the date dDate (found in days as in ProductsLGM::Caplet)
+        std::size_t FindSimulationTenor(const std::vector<double> & dSimulationTenors, double dDate)
+        {
+            long lDate = static_cast<long>(dDate * 365);
+            for (std::size_t iTenor = 0 ; iTenor < dSimulationTenors.size() ; ++iTenor)
+            {
+                if (static_cast<long>(floor(dSimulationTenors[iTenor] * 365)) == lDate)
+                {
+                    return iTenor;
+                }
+            }
+            Utilities::require(false, "Fixing date not found in simulation tenors");
+            return 0;
+        }
+
+        //  E[exp(dCoefficient * X_t)] under the T-forward neutral probability, where X_t is gaussian of mean - Bracket(t,T)
+        double ExpectedExponential(const Processes::LinearGaussianMarkov & sModel, double dt, double dT, double dCoefficient)
+        {
+            return exp(- dCoefficient * sModel.BracketChangeOfProbability(dt, dT) + 0.5 * dCoefficient * dCoefficient * sModel.FactorVariance(dt));
+        }
+
+        double DiscountFactor(const Processes::LinearGaussianMarkov & sModel, double dT)
+        {
+            return exp(-sModel.GetYieldCurve(Processes::DISCOUNT).YC(dT) * dT);
+        }
+    }
+
+    CapletPayoff::CapletPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dStart, double dEnd, double dStrike, const Processes::CurveName & eCurveName, double dQA) : sModel_(sModel), dStart_(dStart)
+    {
+        iFixingTenor_ = FindSimulationTenor(dSimulationTenors, dStart);
+
+        //  LinearGaussianMarkov::Libor(dStart, dStart, dEnd, X) = (dQA / B(dStart, dEnd, X) - 1) / cvg and B(dStart, dEnd, X) = B(dStart, dEnd, 0) exp(- beta X)
+        dForwardRatio_ = dQA / sModel.BondPrice(dStart, dEnd, 0.0, eCurveName);
+        dBeta_ = sModel.Beta(dEnd) - sModel.Beta(dStart);
+        dStrikeRatio_ = 1.0 + (dEnd - dStart) * dStrike;
+    }
+
+    CapletPayoff::~CapletPayoff()
+    {}
+
+    void CapletPayoff::Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const
+    {
+        //  cvg * max(Libor - K, 0) = max(dForwardRatio_ * exp(dBeta_ * X) - (1 + cvg * K), 0)
+        Utilities::ArrayView<const double> dFixingFactors = dFactors[iFixingTenor_];
+        for (std::size_t iPath = 0 ; iPath < dPayoffs.size() ; ++iPath)
+        {
+            dPayoffs[iPath] = std::max(dForwardRatio_ * exp(dBeta_ * dFixingFactors[iPath]) - dStrikeRatio_, 0.0);
+        }
+    }
+
+    double CapletPayoff::ClosedFormPrice(double dT) const
+    {
+        //  dForwardRatio_ * exp(dBeta_ * X) is lognormal under the T-forward neutral probability
+        double dForward = dForwardRatio_ * ExpectedExponential(sModel_, dStart_, dT, dBeta_);
+        double dStdDev = std::abs(dBeta_) * sqrt(sModel_.FactorVariance(dStart_));
+        return DiscountFactor(sModel_, dT) * MathFunctions::BlackScholes(dForward, dStrikeRatio_, dStdDev, Finance::CALL);
+    }
+
+    ZeroCouponPayoff::ZeroCouponPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dFixing, double dMaturity, const Processes::CurveName & eCurveName) : sModel_(sModel), dFixing_(dFixing)
+    {
+        iFixingTenor_ = FindSimulationTenor(dSimulationTenors, dFixing);
+        dBondPrice_ = sModel.BondPrice(dFixing, dMaturity, 0.0, eCurveName);
+        dBeta_ = sModel.Beta(dMaturity) - sModel.Beta(dFixing);
+    }
+
+    ZeroCouponPayoff::~ZeroCouponPayoff()
+    {}
+
+    void ZeroCouponPayoff::Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const
+    {
+        Utilities::ArrayView<const double> dFixingFactors = dFactors[iFixingTenor_];
+        for (std::size_t iPath = 0 ; iPath < dPayoffs.size() ; ++iPath)
+        {
+            dPayoffs[iPath] = dBondPrice_ * exp(-dBeta_ * dFixingFactors[iPath]);
+        }
+    }
+
+    double ZeroCouponPayoff::ClosedFormPrice(double dT) const
+    {
+        return DiscountFactor(sModel_, dT) * dBondPrice_ * ExpectedExponential(sModel_, dFixing_, dT, -dBeta_);
+    }
+
+    SwapPayoff::SwapPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dStart, double dEnd, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis, double dFixedRate, const Processes::CurveName & eCurveName) : sModel_(sModel), dStart_(dStart)
+    {
+        iFixingTenor_ = FindSimulationTenor(dSimulationTenors, dStart);
+
+        //  Schedule and coverages of the fixed leg as in Annuity::ComputeAnnuity, the floating leg is worth 1 - B(dStart, dEnd)
+        std::vector<double> dPayments, dCoverages;
+        FixedLegFlows(sModel.GetYieldCurve(eCurveName), dStart, dEnd, eFrequency, eBasis, dPayments, dCoverages);
+        for (std::size_t iFlow = 0 ; iFlow < dPayments.size() ; ++iFlow)
+        {
+            double dPayment = dPayments[iFlow];
+            dWeights_.push_back(- dFixedRate * dCoverages[iFlow] - (iFlow + 1 == dPayments.size() ? 1.0 : 0.0));
+            dBondPrices_.push_back(sModel.BondPrice(dStart, dPayment, 0.0, eCurveName));
+            dBetas_.push_back(sModel.Beta(dPayment) - sModel.Beta(dStart));
+        }
+    }
+
+    SwapPayoff::~SwapPayoff()
+    {}
+
+    void SwapPayoff::Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const
+    {
+        Utilities::ArrayView<const double> dFixingFactors = dFactors[iFixingTenor_];
+        for (std::size_t iPath = 0 ; iPath < dPayoffs.size() ; ++iPath)
+        {
+            dPayoffs[iPath] = 1.0;
+        }
+        for (std::size_t iFlow = 0 ; iFlow < dWeights_.size() ; ++iFlow)
+        {
+            double dFlow = dWeights_[iFlow] * dBondPrices_[iFlow], dBeta = dBetas_[iFlow];
+            for (std::size_t iPath = 0 ; iPath < dPayoffs.size() ; ++iPath)
+            {
+                dPayoffs[iPath] += dFlow * exp(-dBeta * dFixingFactors[iPath]);
+            }
+        }
+    }
+
+    double SwapPayoff::ClosedFormPrice(double dT) const
+    {
+        double dValue = 1.0;
+        for (std::size_t iFlow = 0 ; iFlow < dWeights_.size() ; ++iFlow)
+        {
+            dValue += dWeights_[iFlow] * dBondPrices_[iFlow] * ExpectedExponential(sModel_, dStart_, dT, -dBetas_[iFlow]);
+        }
+        return DiscountFactor(sModel_, dT) * dValue;
+    }
+
+    SwaptionPayoff::SwaptionPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dStart, double dEnd, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis, double dStrike, Finance::OptionType eOptionType, const Processes::CurveName & eCurveName) :
+    sSwap_(sModel, dSimulationTenors, dStart, dEnd, eFrequency, eBasis, dStrike, eCurveName),
+    sPricer_(sModel, eFrequency, eBasis, eCurveName),
+    dStart_(dStart),
+    dEnd_(dEnd),
+    dStrike_(dStrike),
+    eOptionType_(eOptionType)
+    {
+        Utilities::require(eOptionType == Finance::CALL || eOptionType == Finance::PUT, "SwaptionPayoff : payer (CALL) or receiver (PUT) only");
+    }
+
+    SwaptionPayoff::~SwaptionPayoff()
+    {}
+
+    void SwaptionPayoff::Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const
+    {
+        sSwap_.Payoff(dFactors, dPayoffs);
+        double dSign = eOptionType_ == Finance::CALL ? 1.0 : -1.0;
+        for (std::size_t iPath = 0 ; iPath < dPayoffs.size() ; ++iPath)
+        {
+            dPayoffs[iPath] = std::max(dSign * dPayoffs[iPath], 0.0);
+        }
+    }
+
+    double SwaptionPayoff::ClosedFormPrice(double dT) const
+    {
+        return sPricer_.Price(dStart_, dEnd_ - dStart_, dStrike_, eOptionType_, dT);
+    }
+
+    namespace {
+
+        //  Simulation, change of probability and pricing of the blocks of paths of a partition, and of their antithetic paths
+        //  The partition only keeps the statistics of the means of its antithetic pairs (for the payoff and the control variates), and the
+        //  distribution of the discounted payoffs of its paths if required (sPartitionDistributions not empty)
+        class PricingPartitionTask : public Utilities::ParallelTask
+        {
+        public:
+            PricingPartitionTask(const Processes::LGMPathGenerator & sGenerator, const std::vector<double> & dBrackets, const std::vector<const FactorPayoff *> & sPayoffs, double dDiscountFactor, std::size_t iNRealisations, std::size_t iBlockSize, std::size_t iNPartitions, std::vector<Stats::CovarianceAccumulator> & sPartitionStatistics, std::vector<Stats::TDigest> & sPartitionDistributions) :
+            sGenerator_(sGenerator),
+            dBrackets_(dBrackets),
+            sPayoffs_(sPayoffs),
+            dDiscountFactor_(dDiscountFactor),
+            iNRealisations_(iNRealisations),
+            iBlockSize_(iBlockSize),
+            iNPartitions_(iNPartitions),
+            sPartitionStatistics_(sPartitionStatistics),
+            sPartitionDistributions_(sPartitionDistributions)
+            {}
+
+            virtual void Run(std::size_t iPartition)
+            {
+                std::size_t iNBlocks = (iNRealisations_ + iBlockSize_ - 1) / iBlockSize_, iNTenors = dBrackets_.size(), iNPayoffs = sPayoffs_.size();
+                std::size_t iFirstBlock = iPartition * iNBlocks / iNPartitions_, iEndBlock = (iPartition + 1) * iNBlocks / iNPartitions_;
+
+                //  One buffer for the factors, the antithetic factors and their payoffs
+                std::vector<double> dBuffer(2 * (iNTenors + iNPayoffs) * iBlockSize_);
+                for (std::size_t iBlock = iFirstBlock ; iBlock < iEndBlock ; ++iBlock)
+                {
+                    std::size_t iFirstPath = iBlock * iBlockSize_, iNPaths = std::min(iBlockSize_, iNRealisations_ - iFirstPath);
+                    Utilities::MatrixView<double> dFactorsView(&dBuffer[0], iNTenors, iNPaths, iNPaths), dAntitheticFactorsView(&dBuffer[iNTenors * iNPaths], iNTenors, iNPaths, iNPaths);
+                    Utilities::MatrixView<double> dPayoffsView(&dBuffer[2 * iNTenors * iNPaths], iNPayoffs, iNPaths, iNPaths), dAntitheticPayoffsView(&dBuffer[(2 * iNTenors + iNPayoffs) * iNPaths], iNPayoffs, iNPaths, iNPaths);
+                    sGenerator_.Generate(iFirstPath, dFactorsView);
+
+                    //  Shift to the T-forward neutral probability
+                    for (std::size_t iSimulationTenor = 0 ; iSimulationTenor < iNTenors ; ++iSimulationTenor)
+                    {
+                        Utilities::ArrayView<double> dTenorFactors = dFactorsView[iSimulationTenor], dTenorAntitheticFactors = dAntitheticFactorsView[iSimulationTenor];
+                        double dBracket = dBrackets_[iSimulationTenor];
+                        for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                        {
+                            //  Antithetic variables
+                            dTenorAntitheticFactors[iPath] = - dTenorFactors[iPath] - dBracket;
+                            dTenorFactors[iPath] -= dBracket;
+                        }
+                    }
+
+                    for (std::size_t iPayoff = 0 ; iPayoff < iNPayoffs ; ++iPayoff)
+                    {
+                        Utilities::ArrayView<double> dPayoffs = dPayoffsView[iPayoff], dAntitheticPayoffs = dAntitheticPayoffsView[iPayoff];
+                        sPayoffs_[iPayoff]->Payoff(dFactorsView, dPayoffs);
+                        sPayoffs_[iPayoff]->Payoff(dAntitheticFactorsView, dAntitheticPayoffs);
+
+                        for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                        {
+                            dPayoffs[iPath] *= dDiscountFactor_;
+                            dAntitheticPayoffs[iPath] *= dDiscountFactor_;
+                        }
+                        //  Distribution of the payoff only (the first one), not of the control variates
+                        if (iPayoff == 0 && !sPartitionDistributions_.empty())
+                        {
+                            sPartitionDistributions_[iPartition].Add(dPayoffs);
+                            sPartitionDistributions_[iPartition].Add(dAntitheticPayoffs);
+                        }
+
+                        for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                        {
+                            dPayoffs[iPath] = 0.5 * (dPayoffs[iPath] + dAntitheticPayoffs[iPath]);
+                        }
+                    }
+                    sPartitionStatistics_[iPartition].Add(dPayoffsView);
+                }
+            }
+
+        private:
+            const Processes::LGMPathGenerator & sGenerator_;
+            const std::vector<double> & dBrackets_;
+            const std::vector<const FactorPayoff *> & sPayoffs_;
+            double dDiscountFactor_;
+            std::size_t iNRealisations_, iBlockSize_, iNPartitions_;
+            std::vector<Stats::CovarianceAccumulator> & sPartitionStatistics_;
+            std::vector<Stats::TDigest> & sPartitionDistributions_;
+        };
+
+        //  Regression coefficients of the payoff (variable 0) on the control variates (variables 1, ..., n) : solution of Cov(C,C) beta = Cov(C,Y)
+        //  by gaussian elimination (the covariance matrix is symmetric positive) ; a control variate which is a linear combination of the 
+        //  previous ones (or constant) gets a zero coefficient
+        std::vector<double> RegressionCoefficients(const Stats::CovarianceAccumulator & sStatistics)
+        {
+            std::size_t iNControls = sStatistics.GetNbVariables() - 1;
+            std::vector<std::vector<double> > dMatrix(iNControls, std::vector<double>(iNControls));
+            std::vector<double> dCoefficients(iNControls), dScales(iNControls);
+            for (std::size_t i = 0 ; i < iNControls ; ++i)
+            {
+                for (std::size_t j = 0 ; j < iNControls ; ++j)
+                {
+                    dMatrix[i][j] = sStatistics.GetCovariance(i + 1, j + 1);
+                }
+                dCoefficients[i] = sStatistics.GetCovariance(i + 1, 0);
+                dScales[i] = dMatrix[i][i];
+            }
+
+            std::vector<bool> bIsDropped(iNControls, false);
+            for (std::size_t j = 0 ; j < iNControls ; ++j)
+            {
+                if (dMatrix[j][j] <= 1e-12 * dScales[j] || dMatrix[j][j] <= 0.0)
+                {
+                    bIsDropped[j] = true;
+                    continue;
+                }
+                for (std::size_t i = j + 1 ; i < iNControls ; ++i)
+                {
+                    double dFactor = dMatrix[i][j] / dMatrix[j][j];
+                    for (std::size_t k = j ; k < iNControls ; ++k)
+                    {
+                        dMatrix[i][k] -= dFactor * dMatrix[j][k];
+                    }
+                    dCoefficients[i] -= dFactor * dCoefficients[j];
+                }
+            }
+            for (std::size_t j = iNControls ; j-- > 0 ; )
+            {
+                if (bIsDropped[j])
+                {
+                    dCoefficients[j] = 0.0;
+                    continue;
+                }
+                for (std::size_t k = j + 1 ; k < iNControls ; ++k)
+                {
+                    dCoefficients[j] -= dMatrix[j][k] * dCoefficients[k];
+                }
+                dCoefficients[j] /= dMatrix[j][j];
+            }
+            return dCoefficients;
+        }
+    }
+
+    StreamingMonteCarlo::StreamingMonteCarlo(const Processes::LinearGaussianMarkov & sModel, std::size_t iBlockSize, bool bComputeDistribution) : sModel_(sModel), iBlockSize_(iBlockSize), bComputeDistribution_(bComputeDistribution)
+    {
+        Utilities::require(iBlockSize > 0, "StreamingMonteCarlo : block size has to be positive");
+    }
+
+    StreamingMonteCarlo::~StreamingMonteCarlo()
+    {}
+
+    MonteCarloResult StreamingMonteCarlo::Price(std::size_t iNRealisations,
+                                                const std::vector<double> & dSimulationTenors,
+                                                double dT,
+                                                const FactorPayoff & sPayoff,
+                                                bool bIsStepByStepMC) const
+    {
+        return Price(iNRealisations, dSimulationTenors, dT, sPayoff, std::vector<const ControlVariate *>(), bIsStepByStepMC);
+    }
+
+    MonteCarloResult StreamingMonteCarlo::Price(std::size_t iNRealisations,
+                                                const std::vector<double> & dSimulationTenors,
+                                                double dT,
+                                                const FactorPayoff & sPayoff,
+                                                const std::vector<const ControlVariate *> & sControlVariates,
+                                                bool bIsStepByStepMC) const
+    {
+        Utilities::require(!dSimulationTenors.empty(), "Simulation Times is empty");
+        Utilities::require(iNRealisations > 0, "Number of paths has to be positive");
+
+        Processes::LGMPathGenerator sGenerator(sModel_, dSimulationTenors, bIsStepByStepMC);
+
+        //  Bracket of the factor and of dB(t,T) / B(t,T) at each simulation tenor
+        std::vector<double> dBrackets(dSimulationTenors.size());
+        sModel_.BracketChangeOfProbability(Utilities::ArrayView<const double>(&dSimulationTenors[0], dSimulationTenors.size()), dT, Utilities::ArrayView<double>(&dBrackets[0], dBrackets.size()));
+
+        const Finance::YieldCurve & sDiscountCurve = sModel_.GetYieldCurve(Processes::DISCOUNT);
+        double dDiscountFactor = exp(-sDiscountCurve.YC(dT) * dT);
+
+        //  The payoff and then the control variates are priced on the same paths
+        std::size_t iNControls = sControlVariates.size();
+        std::vector<const FactorPayoff *> sPayoffs(1, &sPayoff);
+        for (std::size_t iControl = 0 ; iControl < iNControls ; ++iControl)
+        {
+            sPayoffs.push_back(sControlVariates[iControl]);
+        }
+
+        //  The blocks are split in a fixed number of partitions, whatever the number of threads
+        std::size_t iNBlocks = (iNRealisations + iBlockSize_ - 1) / iBlockSize_, iNPartitions = std::min(iNBlocks, static_cast<std::size_t>(MONTECARLONPARTITIONS));
+        std::vector<Stats::CovarianceAccumulator> sPartitionStatistics(iNPartitions, Stats::CovarianceAccumulator(1 + iNControls));
+        std::vector<Stats::TDigest> sPartitionDistributions(bComputeDistribution_ ? iNPartitions : 0);
+        PricingPartitionTask sTask(sGenerator, dBrackets, sPayoffs, dDiscountFactor, iNRealisations, iBlockSize_, iNPartitions, sPartitionStatistics, sPartitionDistributions);
+        Utilities::ThreadPool::GetThreadPool(sModel_.GetNbThreads()).ParallelFor(iNPartitions, sTask);
+
+        //  Merge of the partitions in their order (the result does not depend on the number of threads)
+        MonteCarloResult sResult;
+        Stats::CovarianceAccumulator sStatistics(1 + iNControls);
+        for (std::size_t iPartition = 0 ; iPartition < iNPartitions ; ++iPartition)
+        {
+            sStatistics.Merge(sPartitionStatistics[iPartition]);
+        }
+        for (std::size_t iPartition = 0 ; iPartition < sPartitionDistributions.size() ; ++iPartition)
+        {
+            sResult.sDistribution_.Merge(sPartitionDistributions[iPartition]);
+        }
+
+        //  Controlled estimator : mean(Y) - sum_i beta_i (mean(C_i) - E[C_i]), of variance Var(Y) - sum_i beta_i Cov(C_i, Y)
+        std::vector<double> dControlPrices(iNControls);
+        double dVariance = sStatistics.GetVariance(0), dControlledVariance = dVariance;
+        if (iNControls > 0)
+        {
+            sResult.dControlCoefficients_ = RegressionCoefficients(sStatistics);
+            for (std::size_t iControl = 0 ; iControl < iNControls ; ++iControl)
+            {
+                dControlPrices[iControl] = sControlVariates[iControl]->ClosedFormPrice(dT);
+                dControlledVariance -= sResult.dControlCoefficients_[iControl] * sStatistics.GetCovariance(iControl + 1, 0);
+            }
+            dControlledVariance = std::max(dControlledVariance, 0.0);
+        }
+
+        //  Convergence trace with the final coefficients
+        sResult.dConvergence_.reserve(iNPartitions);
+        Stats::CovarianceAccumulator sPartialStatistics(1 + iNControls);
+        for (std::size_t iPartition = 0 ; iPartition < iNPartitions ; ++iPartition)
+        {
+            sPartialStatistics.Merge(sPartitionStatistics[iPartition]);
+            double dPrice = sPartialStatistics.GetMean(0);
+            for (std::size_t iControl = 0 ; iControl < iNControls ; ++iControl)
+            {
+                dPrice -= sResult.dControlCoefficients_[iControl] * (sPartialStatistics.GetMean(iControl + 1) - dControlPrices[iControl]);
+            }
+            sResult.dConvergence_.push_back(dPrice);
+        }
+
+        sResult.dPrice_ = sResult.dConvergence_.back();
+        sResult.dStandardError_ = sqrt(dControlledVariance / sStatistics.GetCount());
+        sResult.iNPaths_ = 2 * sStatistics.GetCount();
+        sResult.dVarianceReduction_ = dControlledVariance > 0.0 ? dVariance / dControlledVariance : (dVariance > 0.0 ? std::numeric_limits<double>::infinity() : 1.0);
+        return sResult;
+    }
+}
@@ -0,0 +1,184 @@
+//
+//  MonteCarloEngine.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_MonteCarloEngine_h
+#define Seminaire_MonteCarloEngine_h
+
+#include <vector>
+#include "HullWhite.h"
+#include "ArrayView.h"
+#include "Accumulators.h"
+#include "Frequency.h"
+#include "Basis.h"
+#include "Option.h"
+#include "JamshidianSwaption.h"
+
+//  Number of paths priced at once by a task of the engine : the block of paths stays in cache from its simulation to its pricing
+#define MONTECARLOBLOCKSIZE 1024
+
+//  Number of partitions of the blocks of paths, each one run by one task of the thread pool with its own accumulators : it is also the
+//  maximum length of the convergence trace
+#define MONTECARLONPARTITIONS 64
+
+namespace Products {
+
+    //  Payoff of a product as a function of the simulated factor under the T-forward neutral probability
+    class FactorPayoff
+    {
+    public:
+        virtual ~FactorPayoff()
+        {}
+
+        //  dFactors[iSimulationTenor][iPath] : factors of a block of paths, dPayoffs[iPath] : payoffs (paid at the maturity of the numeraire)
+        virtual void Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const = 0;
+    };
+
+    //  Payoff priced in closed form by the model : used as a control variate by StreamingMonteCarlo
+    class ControlVariate : public FactorPayoff
+    {
+    public:
+        virtual ~ControlVariate()
+        {}
+
+        //  Price of the payoff paid at dT (discounted on the discount curve), the expectation of the discounted payoffs of StreamingMonteCarlo
+        virtual double ClosedFormPrice(double dT) const = 0;
+    };
+
+    //  Caplet fixing at dStart (which has to be a simulation tenor), paying cvg * max(Libor - K, 0) at dEnd
+    //  Closed form : Black-Scholes formula on the lognormal forward zero-coupon bond
+    class CapletPayoff : public ControlVariate
+    {
+    public:
+        CapletPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dStart, double dEnd, double dStrike, const Processes::CurveName & eCurveName, double dQA = 1.0);
+        virtual ~CapletPayoff();
+
+        virtual void Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const;
+        virtual double ClosedFormPrice(double dT) const;
+
+    private:
+        const Processes::LinearGaussianMarkov & sModel_;
+        double dStart_;
+        std::size_t iFixingTenor_;
+        //  The libor fixing at dStart is (dForwardRatio_ * exp(dBeta_ * X) - 1) / cvg
+        double dForwardRatio_, dBeta_, dStrikeRatio_;
+    };
+
+    //  Price at dFixing (which has to be a simulation tenor) of the zero-coupon bond of maturity dMaturity : LinearGaussianMarkov::BondPrice
+    class ZeroCouponPayoff : public ControlVariate
+    {
+    public:
+        ZeroCouponPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dFixing, double dMaturity, const Processes::CurveName & eCurveName);
+        virtual ~ZeroCouponPayoff();
+
+        virtual void Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const;
+        virtual double ClosedFormPrice(double dT) const;
+
+    private:
+        const Processes::LinearGaussianMarkov & sModel_;
+        double dFixing_;
+        std::size_t iFixingTenor_;
+        //  B(dFixing, dMaturity, X) = dBondPrice_ * exp(- dBeta_ * X)
+        double dBondPrice_, dBeta_;
+    };
+
+    //  Value at dStart (which has to be a simulation tenor) of the payer swap of fixed rate dFixedRate on the schedule of SwapMonoCurve
+    //  (the legs are discounted on the curve eCurveName)
+    class SwapPayoff : public ControlVariate
+    {
+    public:
+        SwapPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dStart, double dEnd, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis, double dFixedRate, const Processes::CurveName & eCurveName);
+        virtual ~SwapPayoff();
+
+        virtual void Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const;
+        virtual double ClosedFormPrice(double dT) const;
+
+    private:
+        const Processes::LinearGaussianMarkov & sModel_;
+        double dStart_;
+        std::size_t iFixingTenor_;
+        //  Value of the swap : 1 + sum_i dWeights_[i] * dBondPrices_[i] * exp(- dBetas_[i] * X)
+        std::vector<double> dWeights_, dBondPrices_, dBetas_;
+    };
+
+    //  Payer (CALL) or receiver (PUT) swaption exercised at dStart into the swap of SwapPayoff of fixed rate dStrike : the positive part of its
+    //  value, priced in closed form by JamshidianSwaption
+    class SwaptionPayoff : public ControlVariate
+    {
+    public:
+        SwaptionPayoff(const Processes::LinearGaussianMarkov & sModel, const std::vector<double> & dSimulationTenors, double dStart, double dEnd, Finance::MyFrequency eFrequency, Finance::MyBasis eBasis, double dStrike, Finance::OptionType eOptionType, const Processes::CurveName & eCurveName);
+        virtual ~SwaptionPayoff();
+
+        virtual void Payoff(Utilities::MatrixView<const double> dFactors, Utilities::ArrayView<double> dPayoffs) const;
+        virtual double ClosedFormPrice(double dT) const;
+
+    private:
+        SwapPayoff sSwap_;
+        JamshidianSwaption sPricer_;
+        double dStart_, dEnd_, dStrike_;
+        Finance::OptionType eOptionType_;
+    };
+
+    //  Result of a Monte-Carlo pricing
+    class MonteCarloResult
+    {
+    public:
+        MonteCarloResult() : dPrice_(0.0), dStandardError_(0.0), iNPaths_(0), dVarianceReduction_(1.0)
+        {}
+
+        double dPrice_;
+        double dStandardError_;
+        //  Number of simulated paths (antithetic paths included)
+        std::size_t iNPaths_;
+        //  Price estimated with the first partitions of the blocks of paths : dConvergence_[i] uses the (i + 1) first partitions (at most
+        //  MONTECARLONPARTITIONS points, one per block below MONTECARLONPARTITIONS blocks)
+        std::vector<double> dConvergence_;
+        //  Distribution of the discounted payoffs of the paths (percentiles), if required
+        Stats::TDigest sDistribution_;
+        //  Regression coefficients of the payoff on the control variates
+        std::vector<double> dControlCoefficients_;
+        //  Variance of the estimator without the control variates divided by its variance with them : number of paths saved for the same standard error
+        double dVarianceReduction_;
+    };
+
+    //  Streaming Monte-Carlo engine : each block of paths is simulated, shifted to the T-forward neutral probability, priced and
+    //  accumulated while it is in cache, and is never stored in a SimulationData
+    //  The memory used is O(block size) per thread (plus the statistics of each partition for the convergence trace) whatever the number of paths,
+    //  and the simulated paths are the ones of LinearGaussianMarkov::Simulate (same seed, same paths, whatever the number of threads)
+    class StreamingMonteCarlo
+    {
+    public:
+        //  bComputeDistribution : the discounted payoffs are also summarized in a t-digest for their percentiles (about twice slower for a caplet)
+        StreamingMonteCarlo(const Processes::LinearGaussianMarkov & sModel, std::size_t iBlockSize = MONTECARLOBLOCKSIZE, bool bComputeDistribution = false);
+        virtual ~StreamingMonteCarlo();
+
+        //  Price of the payoff paid at dT, using iNRealisations paths and their antithetic paths simulated at dSimulationTenors
+        //  The standard error is computed on the means of the pairs of antithetic paths
+        virtual MonteCarloResult Price(std::size_t iNRealisations,
+                                       const std::vector<double> & dSimulationTenors,
+                                       double dT,
+                                       const FactorPayoff & sPayoff,
+                                       bool bIsStepByStepMC = true) const;
+
+        //  Same pricing with control variates : the payoff is regressed on the payoffs of the control variates on the same paths, and the
+        //  price is corrected by the regression coefficients times the errors of the controls on their closed form prices
+        //  The coefficients are estimated on the same paths (bias in O(1 / number of paths))
+        virtual MonteCarloResult Price(std::size_t iNRealisations,
+                                       const std::vector<double> & dSimulationTenors,
+                                       double dT,
+                                       const FactorPayoff & sPayoff,
+                                       const std::vector<const ControlVariate *> & sControlVariates,
+                                       bool bIsStepByStepMC = true) const;
+
+    private:
+        const Processes::LinearGaussianMarkov & sModel_;
+        std::size_t iBlockSize_;
+        bool bComputeDistribution_;
+    };
+}
+
+#endif
@@ -20,25 +20,28 @@ namespace Products {
     std::vector<double> ProductsLGM::Caplet(double dStart, double dEnd, double dPay, double dStrike, const Finance::SimulationData & sSimulationData, const Processes::CurveName & eCurveName, double dQA) const
     {
         //  Price of a caplet starting a dStart, ending at dEnd and paying at dPay, with Strike dStrike and with MC Simulation factors at dStart
-        std::size_t iWhere = Utilities::FindInVector(sSimulationData.GetDateList(), static_cast<long>(dStart * 365));
+        const std::vector<long> & lDates = sSimulationData.GetDateList();
+        long lStart = static_cast<long>(dStart * 365);
+        std::size_t iWhere;
         
-        if (iWhere != sSimulationData.GetDateList().size())
+        if (Utilities::IsFound(lDates, lStart, &iWhere))
         {
-            std::vector<std::vector<double> > dMatrixEndFactor = sSimulationData.GetData().second[iWhere];
+            //  Only one factor which is simulated for now
+            Finance::SimulationData::ConstFactorView dEndFactor = sSimulationData.GetFactorPaths(iWhere, 0);
         
-            std::size_t iNPaths = dMatrixEndFactor.size();
-            std::vector<double> dResults;
+            std::size_t iNPaths = dEndFactor.size();
+            std::vector<double> dResults(iNPaths);
+            Utilities::ArrayView<double> dLibors(iNPaths == 0 ? 0 : &dResults[0], iNPaths);
         
             double dCoverage = (dEnd - dStart);
             
+            //  Only one factor which is simulated for now
+            //  Fixing of the libor at start date of the period, for all the paths at once
+            Libor(dStart, dStart, dEnd, dEndFactor/*, Processes::T_FORWARD_NEUTRAL*/, dLibors, eCurveName, dQA);
             for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
             {
-                //  Only one factor which is simulated for now
-                //  Fixing of the libor at start date of the period
                 //  Alexandre 4/12/2012 add coverage because cash-flow of cash-flow is cvg * max (Libor - K, 0)
-                double dFactor = dMatrixEndFactor[iPath][0];
-                double dLibor = Libor(dStart, dStart, dEnd, dFactor/*, Processes::T_FORWARD_NEUTRAL*/, eCurveName, dQA);
-                dResults.push_back( dCoverage * std::max(dLibor - dStrike, 0.0));
+                dResults[iPath] = dCoverage * std::max(dResults[iPath] - dStrike, 0.0);
             }
         
             return dResults;
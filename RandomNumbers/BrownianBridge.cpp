@@ -0,0 +1,122 @@
+//
+//  BrownianBridge.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include "BrownianBridge.h"
+#include "Require.h"
+
+namespace RandomNumbers {
+
+    BrownianBridge::BrownianBridge(const std::vector<double> & dVariances)
+    {
+        std::size_t iNSteps = dVariances.size();
+        Utilities::require(iNSteps > 0, "BrownianBridge : no step");
+        for (std::size_t iStep = 0 ; iStep < iNSteps ; ++iStep)
+        {
+            Utilities::require(dVariances[iStep] >= (iStep ? dVariances[iStep - 1] : 0.0), "BrownianBridge : variances have to be non-negative and non-decreasing");
+        }
+
+        iBridgeIndex_.resize(iNSteps);
+        iLeftIndex_.resize(iNSteps);
+        iRightIndex_.resize(iNSteps);
+        dLeftWeight_.resize(iNSteps);
+        dRightWeight_.resize(iNSteps);
+        dStdDev_.resize(iNSteps);
+
+        //  Steps already built
+        std::vector<bool> bIsBuilt(iNSteps, false);
+
+        //  The last step first
+        bIsBuilt[iNSteps - 1] = true;
+        iBridgeIndex_[0] = iNSteps - 1;
+        iLeftIndex_[0] = iRightIndex_[0] = 0;
+        dLeftWeight_[0] = dRightWeight_[0] = 0.0;
+        dStdDev_[0] = sqrt(dVariances[iNSteps - 1]);
+
+        //  Then the middle of each interval [j, k] of steps to build, from its left neighbour j - 1 (or 0) and its right neighbour k
+        for (std::size_t i = 1, j = 0 ; i < iNSteps ; ++i)
+        {
+            while (bIsBuilt[j])
+            {
+                ++j;
+            }
+            std::size_t k = j;
+            while (!bIsBuilt[k])
+            {
+                ++k;
+            }
+            std::size_t l = j + ((k - 1 - j) >> 1);
+            bIsBuilt[l] = true;
+
+            iBridgeIndex_[i] = l;
+            iLeftIndex_[i] = j;
+            iRightIndex_[i] = k;
+
+            double dLeftVariance = j ? dVariances[j - 1] : 0.0, dVariance = dVariances[l], dRightVariance = dVariances[k];
+            if (dRightVariance > dLeftVariance)
+            {
+                dLeftWeight_[i] = (dRightVariance - dVariance) / (dRightVariance - dLeftVariance);
+                dRightWeight_[i] = (dVariance - dLeftVariance) / (dRightVariance - dLeftVariance);
+                dStdDev_[i] = sqrt((dVariance - dLeftVariance) * (dRightVariance - dVariance) / (dRightVariance - dLeftVariance));
+            }
+            else
+            {
+                //  No variance between the neighbours : the step is equal to its right neighbour
+                dLeftWeight_[i] = 0.0;
+                dRightWeight_[i] = 1.0;
+                dStdDev_[i] = 0.0;
+            }
+
+            j = k + 1;
+            if (j >= iNSteps)
+            {
+                j = 0;
+            }
+        }
+    }
+
+    BrownianBridge::~BrownianBridge()
+    {}
+
+    void BrownianBridge::Transform(Utilities::MatrixView<const double> dGaussians, Utilities::MatrixView<double> dPaths) const
+    {
+        std::size_t iNSteps = GetNbSteps(), iNPaths = dPaths.columns();
+        Utilities::require(dGaussians.rows() >= iNSteps && dPaths.rows() >= iNSteps, "BrownianBridge : not enough dimensions");
+        Utilities::require(dGaussians.columns() >= iNPaths, "BrownianBridge : not enough gaussians");
+
+        //  Row by row : each construction step is a linear combination of rows over all the paths
+        Utilities::ArrayView<const double> dGaussian = dGaussians[0];
+        Utilities::ArrayView<double> dLast = dPaths[iNSteps - 1];
+        for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+        {
+            dLast[iPath] = dStdDev_[0] * dGaussian[iPath];
+        }
+        for (std::size_t i = 1 ; i < iNSteps ; ++i)
+        {
+            dGaussian = dGaussians[i];
+            Utilities::ArrayView<double> dStep = dPaths[iBridgeIndex_[i]];
+            Utilities::ArrayView<const double> dRight = dPaths[iRightIndex_[i]];
+            double dLeftWeight = dLeftWeight_[i], dRightWeight = dRightWeight_[i], dStdDev = dStdDev_[i];
+            if (iLeftIndex_[i])
+            {
+                Utilities::ArrayView<const double> dLeft = dPaths[iLeftIndex_[i] - 1];
+                for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                {
+                    dStep[iPath] = dLeftWeight * dLeft[iPath] + dRightWeight * dRight[iPath] + dStdDev * dGaussian[iPath];
+                }
+            }
+            else
+            {
+                for (std::size_t iPath = 0 ; iPath < iNPaths ; ++iPath)
+                {
+                    dStep[iPath] = dRightWeight * dRight[iPath] + dStdDev * dGaussian[iPath];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+//
+//  BrownianBridge.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_BrownianBridge_h
+#define Seminaire_BrownianBridge_h
+
+#include <vector>
+#include "ArrayView.h"
+
+namespace RandomNumbers {
+
+    //  Brownian bridge construction of a gaussian martingale with independent increments (a brownian motion on its variance clock)
+    //
+    //  The first gaussian gives the last step, the second one the middle step knowing the last one, and so on by bisection : the first
+    //  dimensions of a low-discrepancy sequence, which are the best distributed ones, drive the largest part of the variance of the paths
+    class BrownianBridge
+    {
+    public:
+        //  dVariances : non-decreasing variances of the process at each step (the process is 0 with variance 0 before the first step)
+        BrownianBridge(const std::vector<double> & dVariances);
+        virtual ~BrownianBridge();
+
+        std::size_t GetNbSteps() const
+        {
+            return iBridgeIndex_.size();
+        }
+
+        //  dPaths[iStep][iPath] from the independent standard gaussians dGaussians[iDimension][iPath] (the buffers must be distinct)
+        void Transform(Utilities::MatrixView<const double> dGaussians, Utilities::MatrixView<double> dPaths) const;
+
+    private:
+        //  At the construction step i, the step iBridgeIndex_[i] is built from the steps iLeftIndex_[i] - 1 (or 0 if iLeftIndex_[i] is 0)
+        //  and iRightIndex_[i]
+        std::vector<std::size_t> iBridgeIndex_, iLeftIndex_, iRightIndex_;
+        std::vector<double> dLeftWeight_, dRightWeight_, dStdDev_;
+    };
+}
+
+#endif
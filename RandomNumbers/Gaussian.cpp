@@ -9,22 +9,25 @@
 #include <iostream>
 #include <vector>
 #include "Gaussian.h"
-#include <tr1/random> 
+#include "Philox.h"
+#include "Sobol.h"
 
 namespace RandomNumbers {
 
     //  Default constructor
-    Gaussian1D::Gaussian1D() : dMean_(0.0), dStdDev_(1.0), iNRealisations_(1), iAntitheticVariables_(0)
+    Gaussian1D::Gaussian1D() : dMean_(0.0), dStdDev_(1.0), iNRealisations_(1), iAntitheticVariables_(0), lSeed_(0), lStream_(0)
     {
         dRealisations_.resize(iNRealisations_);
     }
 
     //  Constructor
-    Gaussian1D::Gaussian1D(double dMean, double dStdDev, size_t iNRealisations, int iAntitheticVariables):
+    Gaussian1D::Gaussian1D(double dMean, double dStdDev, size_t iNRealisations, int iAntitheticVariables, unsigned long lSeed, unsigned long lStream):
     dMean_(dMean),
     dStdDev_(dStdDev),
     iNRealisations_(iNRealisations),
-    iAntitheticVariables_(iAntitheticVariables)
+    iAntitheticVariables_(iAntitheticVariables),
+    lSeed_(lSeed),
+    lStream_(lStream)
     {}
 
     //  Destructor
@@ -35,26 +38,55 @@ namespace RandomNumbers {
 
     void Gaussian1D::GenerateGaussian()
     {
-        std::tr1::ranlux64_base_01 eng; // core engine class
-        eng.seed(time(NULL));
+        //  The i-th realisation is the i-th gaussian of the substream : same seed, same realisations
+        Philox sGenerator(lSeed_, lStream_);
         
-        //  Generation of normal variables via this distribution
-        std::tr1::normal_distribution<double> dist(dMean_, dStdDev_ /** dStdDev_*/);
-        dist.reset(); // discard any cached values
-        
-        std::vector<double> dRealisations(iNRealisations_, 0.0), dRealisationsAntithetic(iNRealisations_, 0.0);
-        
-        for (std::size_t i = 0 ; i < dRealisations.size() ; ++i)
+        //  Batched generation directly in the realisations
+        dRealisations_.resize(GetNbRealisations());
+        if (dRealisations_.empty())
         {
-            dRealisations[i] = dist(eng);
+            return;
+        }
+        sGenerator.Gaussians(0, Utilities::ArrayView<double>(&dRealisations_[0], iNRealisations_));
+        for (std::size_t i = 0 ; i < iNRealisations_ ; ++i)
+        {
+            dRealisations_[i] = dMean_ + dStdDev_ * dRealisations_[i];
             if (iAntitheticVariables_)
             {
                 //  Antithetic variables 
-                dRealisationsAntithetic[i] = 2 * dMean_ - dRealisations[i];
+                dRealisations_[iNRealisations_ + i] = 2 * dMean_ - dRealisations_[i];
+            }
+        }
+    }
+
+    SobolGaussian1D::SobolGaussian1D(double dMean, double dStdDev, size_t iNRealisations, int iAntitheticVariables, SobolScrambling eScrambling, unsigned long lSeed, unsigned long lStream) :
+    Gaussian1D(dMean, dStdDev, iNRealisations, iAntitheticVariables, lSeed, lStream),
+    eScrambling_(eScrambling)
+    {}
+
+    SobolGaussian1D::~SobolGaussian1D()
+    {}
+
+    void SobolGaussian1D::GenerateGaussian()
+    {
+        dRealisations_.resize(GetNbRealisations());
+        if (dRealisations_.empty())
+        {
+            return;
+        }
+
+        //  Only the coordinate lStream_ of the points is needed : one-row view on the realisations
+        Sobol sSequence(lStream_ + 1, eScrambling_, lSeed_);
+        Utilities::MatrixView<double> dCoordinates(&dRealisations_[0], 1, iNRealisations_, iNRealisations_);
+        sSequence.Gaussians(sSequence.GetFirstIndex(), dCoordinates, lStream_);
+        for (std::size_t i = 0 ; i < iNRealisations_ ; ++i)
+        {
+            dRealisations_[i] = dMean_ + dStdDev_ * dRealisations_[i];
+            if (iAntitheticVariables_)
+            {
+                //  Antithetic variables
+                dRealisations_[iNRealisations_ + i] = 2 * dMean_ - dRealisations_[i];
             }
         }
-        
-        dRealisations_.insert(dRealisations_.begin(), dRealisations.begin(), dRealisations.end());
-        dRealisations_.insert(dRealisations_.end(), dRealisationsAntithetic.begin(), dRealisationsAntithetic.end());
     }
 }
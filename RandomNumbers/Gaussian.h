@@ -7,6 +7,7 @@
 //
 
 #include <vector>
+#include "Sobol.h"
 
 #ifndef GAUSSIAN_H_INCLUDED
 #define GAUSSIAN_H_INCLUDED
@@ -18,11 +19,12 @@ namespace RandomNumbers
     {
     public:
         Gaussian1D();
-        Gaussian1D(double dMean, double dStdDev, size_t iNRealisations, int iAntitheticVariables);
+        //  Realisations are drawn from the substream lStream of the counter-based generator seeded with lSeed
+        Gaussian1D(double dMean, double dStdDev, size_t iNRealisations, int iAntitheticVariables, unsigned long lSeed = 0, unsigned long lStream = 0);
         virtual ~Gaussian1D();
 
         virtual void GenerateGaussian();
-        virtual std::vector<double> GetRealisations() const
+        virtual const std::vector<double> & GetRealisations() const
         {
             return dRealisations_;
         };
@@ -37,8 +39,25 @@ namespace RandomNumbers
         size_t iNRealisations_;
         int iAntitheticVariables_;
         std::vector<double> dRealisations_;
+        unsigned long lSeed_;
+        unsigned long lStream_;
 
     };
+
+    //  Drop-in replacement of Gaussian1D drawing its realisations from a Sobol sequence : the realisation i is the inverse cumulative
+    //  distribution of the coordinate lStream of the point i, so that the Gaussian1D built with the streams 0, ..., d - 1 and the same
+    //  seed give together the points of a d-dimensional (scrambled) Sobol sequence
+    class SobolGaussian1D : public Gaussian1D
+    {
+    public:
+        SobolGaussian1D(double dMean, double dStdDev, size_t iNRealisations, int iAntitheticVariables, SobolScrambling eScrambling = LINEAR_SCRAMBLING, unsigned long lSeed = 0, unsigned long lStream = 0);
+        virtual ~SobolGaussian1D();
+
+        virtual void GenerateGaussian();
+
+    protected:
+        SobolScrambling eScrambling_;
+    };
 }
 
 #endif // GAUSSIAN_H_INCLUDED
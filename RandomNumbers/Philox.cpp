@@ -0,0 +1,310 @@
+//
+//  Philox.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "Philox.h"
+#include "MathFunctions.h"
+#include "BatchMathFunctions.h"
+#include "CPUFeatures.h"
+
+#ifdef SEMINAIRE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+//  Constants of Philox4x32
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+#define PHILOX_NROUNDS 10
+
+//  Uniforms and gaussians are drawn from disjoint counters (top bit of the draw index)
+#define PHILOX_GAUSSIAN_DOMAIN 0x8000000000000000ULL
+
+//  Number of blocks generated at once by the scalar code
+#define PHILOX_MAXLANES 16
+
+namespace RandomNumbers {
+    
+    namespace {
+        
+        inline void PhiloxRound(uint32_t c[4], const uint32_t k[2])
+        {
+            uint64_t lProduct0 = static_cast<uint64_t>(PHILOX_M0) * c[0];
+            uint64_t lProduct1 = static_cast<uint64_t>(PHILOX_M1) * c[2];
+            uint32_t iHi0 = static_cast<uint32_t>(lProduct0 >> 32), iLo0 = static_cast<uint32_t>(lProduct0);
+            uint32_t iHi1 = static_cast<uint32_t>(lProduct1 >> 32), iLo1 = static_cast<uint32_t>(lProduct1);
+            
+            c[0] = iHi1 ^ c[1] ^ k[0];
+            c[1] = iLo1;
+            c[2] = iHi0 ^ c[3] ^ k[1];
+            c[3] = iLo0;
+        }
+        
+        //  Uniform in (0,1) with 52 bits from two 32-bit words : (k + 1/2) / 2^52 is exact, whatever the instruction set
+        inline double ToUniform(uint32_t iHigh, uint32_t iLow)
+        {
+            uint64_t lBits = ((static_cast<uint64_t>(iHigh) << 32) | iLow) >> 12;
+            return (static_cast<double>(lBits) + 0.5) * (1.0 / 4503599627370496.0);
+        }
+        
+        //  Words of iNLanes consecutive blocks : iWords[j][iLane] is the j-th word of the block lFirstCounter + iLane
+        struct PhiloxLanes
+        {
+            uint32_t iWords[4][PHILOX_MAXLANES];
+        };
+        
+        void PhiloxLanesScalar(uint64_t lFirstCounter, uint64_t lDomain, uint64_t lStream, uint64_t lSeed, std::size_t iNLanes, PhiloxLanes & sLanes)
+        {
+            for (std::size_t iLane = 0 ; iLane < iNLanes ; ++iLane)
+            {
+                uint64_t lCounter = (lFirstCounter + iLane) | lDomain;
+                uint32_t c[4] = {static_cast<uint32_t>(lCounter), static_cast<uint32_t>(lCounter >> 32), static_cast<uint32_t>(lStream), static_cast<uint32_t>(lStream >> 32)};
+                uint32_t k[2] = {static_cast<uint32_t>(lSeed), static_cast<uint32_t>(lSeed >> 32)};
+                for (std::size_t iRound = 0 ; iRound < PHILOX_NROUNDS ; ++iRound)
+                {
+                    if (iRound > 0)
+                    {
+                        //  Bump the key
+                        k[0] += PHILOX_W0;
+                        k[1] += PHILOX_W1;
+                    }
+                    PhiloxRound(c, k);
+                }
+                for (std::size_t j = 0 ; j < 4 ; ++j)
+                {
+                    sLanes.iWords[j][iLane] = c[j];
+                }
+            }
+        }
+        
+#ifdef SEMINAIRE_X86_SIMD
+        //  8 blocks at once (word j of the 8 blocks in one register), converted to 16 uniforms written in pResults
+        //  The counters lFirstCounter, ..., lFirstCounter + 7 must not carry over 32 bits
+        SEMINAIRE_TARGET("avx2")
+        void PhiloxUniformsAVX2(uint64_t lFirstCounter, uint64_t lStream, uint64_t lSeed, double * pResults)
+        {
+            __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(lFirstCounter))), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i c1 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(lFirstCounter >> 32)));
+            __m256i c2 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(lStream))), c3 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(lStream >> 32)));
+            const __m256i M0 = _mm256_set1_epi32(static_cast<int>(PHILOX_M0)), M1 = _mm256_set1_epi32(static_cast<int>(PHILOX_M1));
+            uint32_t k0 = static_cast<uint32_t>(lSeed), k1 = static_cast<uint32_t>(lSeed >> 32);
+            
+            for (std::size_t iRound = 0 ; iRound < PHILOX_NROUNDS ; ++iRound)
+            {
+                if (iRound > 0)
+                {
+                    k0 += PHILOX_W0;
+                    k1 += PHILOX_W1;
+                }
+                //  32x32 -> 64 bits products of the even and odd lanes
+                __m256i dEven0 = _mm256_mul_epu32(c0, M0), dOdd0 = _mm256_mul_epu32(_mm256_srli_epi64(c0, 32), M0);
+                __m256i dEven1 = _mm256_mul_epu32(c2, M1), dOdd1 = _mm256_mul_epu32(_mm256_srli_epi64(c2, 32), M1);
+                __m256i iLo0 = _mm256_blend_epi32(dEven0, _mm256_slli_epi64(dOdd0, 32), 0xAA), iHi0 = _mm256_blend_epi32(_mm256_srli_epi64(dEven0, 32), dOdd0, 0xAA);
+                __m256i iLo1 = _mm256_blend_epi32(dEven1, _mm256_slli_epi64(dOdd1, 32), 0xAA), iHi1 = _mm256_blend_epi32(_mm256_srli_epi64(dEven1, 32), dOdd1, 0xAA);
+                
+                c0 = _mm256_xor_si256(_mm256_xor_si256(iHi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+                c1 = iLo1;
+                c2 = _mm256_xor_si256(_mm256_xor_si256(iHi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+                c3 = iLo0;
+            }
+            
+            //  Same conversion as ToUniform : 52 bits in the mantissa of a double in [1,2)
+            const __m256i iExponent = _mm256_set1_epi64x(0x3FF0000000000000LL);
+            const __m256d dOne = _mm256_set1_pd(1.0), dHalfUlp = _mm256_set1_pd(1.0 / 9007199254740992.0);
+            for (std::size_t iHalf = 0 ; iHalf < 2 ; ++iHalf)
+            {
+                __m128i w0 = iHalf ? _mm256_extracti128_si256(c0, 1) : _mm256_castsi256_si128(c0), w1 = iHalf ? _mm256_extracti128_si256(c1, 1) : _mm256_castsi256_si128(c1);
+                __m128i w2 = iHalf ? _mm256_extracti128_si256(c2, 1) : _mm256_castsi256_si128(c2), w3 = iHalf ? _mm256_extracti128_si256(c3, 1) : _mm256_castsi256_si128(c3);
+                __m256i lFirst = _mm256_or_si256(_mm256_slli_epi64(_mm256_cvtepu32_epi64(w0), 32), _mm256_cvtepu32_epi64(w1));
+                __m256i lSecond = _mm256_or_si256(_mm256_slli_epi64(_mm256_cvtepu32_epi64(w2), 32), _mm256_cvtepu32_epi64(w3));
+                __m256d dFirst = _mm256_add_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(lFirst, 12), iExponent)), dOne), dHalfUlp);
+                __m256d dSecond = _mm256_add_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(lSecond, 12), iExponent)), dOne), dHalfUlp);
+                
+                //  Interleave : first and second uniforms of each block
+                __m256d dLow = _mm256_unpacklo_pd(dFirst, dSecond), dHigh = _mm256_unpackhi_pd(dFirst, dSecond);
+                _mm256_storeu_pd(pResults + 8 * iHalf, _mm256_permute2f128_pd(dLow, dHigh, 0x20));
+                _mm256_storeu_pd(pResults + 8 * iHalf + 4, _mm256_permute2f128_pd(dLow, dHigh, 0x31));
+            }
+        }
+        
+        //  16 blocks at once, converted to 32 uniforms
+        //  Zero-masked forms with a full mask (_mm512_maskz_...) : gcc implements the unmasked ones on an undefined source register
+        SEMINAIRE_TARGET("avx512f")
+        void PhiloxUniformsAVX512(uint64_t lFirstCounter, uint64_t lStream, uint64_t lSeed, double * pResults)
+        {
+            __m512i c0 = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(lFirstCounter))), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+            __m512i c1 = _mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(lFirstCounter >> 32)));
+            __m512i c2 = _mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(lStream))), c3 = _mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(lStream >> 32)));
+            const __m512i M0 = _mm512_set1_epi32(static_cast<int>(PHILOX_M0)), M1 = _mm512_set1_epi32(static_cast<int>(PHILOX_M1));
+            uint32_t k0 = static_cast<uint32_t>(lSeed), k1 = static_cast<uint32_t>(lSeed >> 32);
+            
+            for (std::size_t iRound = 0 ; iRound < PHILOX_NROUNDS ; ++iRound)
+            {
+                if (iRound > 0)
+                {
+                    k0 += PHILOX_W0;
+                    k1 += PHILOX_W1;
+                }
+                __m512i dEven0 = _mm512_maskz_mul_epu32(0xFF, c0, M0), dOdd0 = _mm512_maskz_mul_epu32(0xFF, _mm512_maskz_srli_epi64(0xFF, c0, 32), M0);
+                __m512i dEven1 = _mm512_maskz_mul_epu32(0xFF, c2, M1), dOdd1 = _mm512_maskz_mul_epu32(0xFF, _mm512_maskz_srli_epi64(0xFF, c2, 32), M1);
+                __m512i iLo0 = _mm512_mask_blend_epi32(0xAAAA, dEven0, _mm512_maskz_slli_epi64(0xFF, dOdd0, 32)), iHi0 = _mm512_mask_blend_epi32(0xAAAA, _mm512_maskz_srli_epi64(0xFF, dEven0, 32), dOdd0);
+                __m512i iLo1 = _mm512_mask_blend_epi32(0xAAAA, dEven1, _mm512_maskz_slli_epi64(0xFF, dOdd1, 32)), iHi1 = _mm512_mask_blend_epi32(0xAAAA, _mm512_maskz_srli_epi64(0xFF, dEven1, 32), dOdd1);
+                
+                c0 = _mm512_xor_si512(_mm512_xor_si512(iHi1, c1), _mm512_set1_epi32(static_cast<int>(k0)));
+                c1 = iLo1;
+                c2 = _mm512_xor_si512(_mm512_xor_si512(iHi0, c3), _mm512_set1_epi32(static_cast<int>(k1)));
+                c3 = iLo0;
+            }
+            
+            const __m512i iExponent = _mm512_set1_epi64(0x3FF0000000000000LL);
+            const __m512d dOne = _mm512_set1_pd(1.0), dHalfUlp = _mm512_set1_pd(1.0 / 9007199254740992.0);
+            const __m512i iLowIndex = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), iHighIndex = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+            for (std::size_t iHalf = 0 ; iHalf < 2 ; ++iHalf)
+            {
+                __m256i w0 = iHalf ? _mm512_maskz_extracti64x4_epi64(0x0F, c0, 1) : _mm512_maskz_extracti64x4_epi64(0x0F, c0, 0), w1 = iHalf ? _mm512_maskz_extracti64x4_epi64(0x0F, c1, 1) : _mm512_maskz_extracti64x4_epi64(0x0F, c1, 0);
+                __m256i w2 = iHalf ? _mm512_maskz_extracti64x4_epi64(0x0F, c2, 1) : _mm512_maskz_extracti64x4_epi64(0x0F, c2, 0), w3 = iHalf ? _mm512_maskz_extracti64x4_epi64(0x0F, c3, 1) : _mm512_maskz_extracti64x4_epi64(0x0F, c3, 0);
+                __m512i lFirst = _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, _mm512_maskz_cvtepu32_epi64(0xFF, w0), 32), _mm512_maskz_cvtepu32_epi64(0xFF, w1));
+                __m512i lSecond = _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, _mm512_maskz_cvtepu32_epi64(0xFF, w2), 32), _mm512_maskz_cvtepu32_epi64(0xFF, w3));
+                __m512d dFirst = _mm512_add_pd(_mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_maskz_srli_epi64(0xFF, lFirst, 12), iExponent)), dOne), dHalfUlp);
+                __m512d dSecond = _mm512_add_pd(_mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_maskz_srli_epi64(0xFF, lSecond, 12), iExponent)), dOne), dHalfUlp);
+                
+                _mm512_storeu_pd(pResults + 16 * iHalf, _mm512_permutex2var_pd(dFirst, iLowIndex, dSecond));
+                _mm512_storeu_pd(pResults + 16 * iHalf + 8, _mm512_permutex2var_pd(dFirst, iHighIndex, dSecond));
+            }
+        }
+#endif
+    }
+    
+    Philox::Philox(uint64_t lSeed, uint64_t lStream) : lSeed_(lSeed), lStream_(lStream), lPosition_(0)
+    {}
+    
+    Philox::~Philox()
+    {}
+    
+    void Philox::GenerateBlock(uint64_t lCounter, uint32_t iOutput[4]) const
+    {
+        GenerateBlock(lCounter, 0, iOutput);
+    }
+    
+    void Philox::GenerateBlock(uint64_t lCounter, uint64_t lDomain, uint32_t iOutput[4]) const
+    {
+        PhiloxLanes sLanes;
+        PhiloxLanesScalar(lCounter, lDomain, lStream_, lSeed_, 1, sLanes);
+        for (std::size_t j = 0 ; j < 4 ; ++j)
+        {
+            iOutput[j] = sLanes.iWords[j][0];
+        }
+    }
+    
+    void Philox::Uniforms(uint64_t lFirstIndex, uint64_t lDomain, Utilities::ArrayView<double> dResults) const
+    {
+        //  Two uniforms per block : the uniform i is the half (i & 1) of the block i >> 1
+        double * pResults = dResults.data();
+        std::size_t iN = dResults.size(), i = 0;
+        uint64_t lIndex = lFirstIndex;
+        if (iN > 0 && (lIndex & 1))
+        {
+            uint32_t iBlock[4];
+            GenerateBlock(lIndex >> 1, lDomain, iBlock);
+            pResults[i++] = ToUniform(iBlock[2], iBlock[3]);
+            ++lIndex;
+        }
+        
+#ifdef SEMINAIRE_X86_SIMD
+        //  Full vectors of blocks, as long as the counters of a vector do not carry over 32 bits
+        Utilities::SIMDLevel eSIMDLevel = Utilities::GetSIMDLevel();
+        std::size_t iNLanes = eSIMDLevel == Utilities::SIMD_AVX512 ? 16 : (eSIMDLevel == Utilities::SIMD_AVX2 ? 8 : 0);
+        while (iNLanes > 0 && i + 2 * iNLanes <= iN)
+        {
+            uint64_t lCounter = (lIndex >> 1) | lDomain;
+            if (static_cast<uint32_t>(lCounter) > 0xFFFFFFFFU - iNLanes)
+            {
+                break;
+            }
+            if (iNLanes == 16)
+            {
+                PhiloxUniformsAVX512(lCounter, lStream_, lSeed_, pResults + i);
+            }
+            else
+            {
+                PhiloxUniformsAVX2(lCounter, lStream_, lSeed_, pResults + i);
+            }
+            i += 2 * iNLanes;
+            lIndex += 2 * iNLanes;
+        }
+#endif
+        //  Remaining uniforms
+        PhiloxLanes sLanes;
+        while (i < iN)
+        {
+            std::size_t iNBlocks = std::min(static_cast<std::size_t>(PHILOX_MAXLANES), (iN - i + 1) / 2);
+            PhiloxLanesScalar(lIndex >> 1, lDomain, lStream_, lSeed_, iNBlocks, sLanes);
+            for (std::size_t iLane = 0 ; iLane < iNBlocks && i < iN ; ++iLane)
+            {
+                pResults[i++] = ToUniform(sLanes.iWords[0][iLane], sLanes.iWords[1][iLane]);
+                if (i < iN)
+                {
+                    pResults[i++] = ToUniform(sLanes.iWords[2][iLane], sLanes.iWords[3][iLane]);
+                }
+            }
+            lIndex += 2 * iNBlocks;
+        }
+    }
+    
+    double Philox::Uniform(uint64_t lIndex) const
+    {
+        uint32_t iBlock[4];
+        GenerateBlock(lIndex >> 1, 0, iBlock);
+        return lIndex & 1 ? ToUniform(iBlock[2], iBlock[3]) : ToUniform(iBlock[0], iBlock[1]);
+    }
+    
+    double Philox::Gaussian(uint64_t lIndex) const
+    {
+        //  Inverse of the cumulative distribution of a uniform of the gaussian counters
+        uint32_t iBlock[4];
+        GenerateBlock(lIndex >> 1, PHILOX_GAUSSIAN_DOMAIN, iBlock);
+        return MathFunctions::InvCumNorm(lIndex & 1 ? ToUniform(iBlock[2], iBlock[3]) : ToUniform(iBlock[0], iBlock[1]));
+    }
+    
+    void Philox::Uniforms(uint64_t lFirstIndex, Utilities::ArrayView<double> dResults) const
+    {
+        Uniforms(lFirstIndex, 0, dResults);
+    }
+    
+    void Philox::Gaussians(uint64_t lFirstIndex, Utilities::ArrayView<double> dResults) const
+    {
+        //  Uniforms then inverse cumulative distribution in place
+        Uniforms(lFirstIndex, PHILOX_GAUSSIAN_DOMAIN, dResults);
+        MathFunctions::InvCumNorm(dResults, dResults);
+    }
+    
+    double Philox::NextUniform()
+    {
+        return Uniform(lPosition_++);
+    }
+    
+    double Philox::NextGaussian()
+    {
+        return Gaussian(lPosition_++);
+    }
+    
+    void Philox::NextUniforms(Utilities::ArrayView<double> dResults)
+    {
+        Uniforms(lPosition_, dResults);
+        lPosition_ += dResults.size();
+    }
+    
+    void Philox::NextGaussians(Utilities::ArrayView<double> dResults)
+    {
+        Gaussians(lPosition_, dResults);
+        lPosition_ += dResults.size();
+    }
+}
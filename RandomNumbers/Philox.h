@@ -0,0 +1,99 @@
+//
+//  Philox.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_Philox_h
+#define Seminaire_Philox_h
+
+#include <stdint.h>
+#include "ArrayView.h"
+
+namespace RandomNumbers {
+    
+    //  Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011)
+    //  
+    //  The i-th draw of a stream is a pure function of (seed, stream, i) : 
+    //      - the key is the seed
+    //      - the counter is made of the draw index and of the stream index
+    //  so that any draw can be generated in O(1) without replaying the stream (skip-ahead), and 
+    //  independent substreams are obtained by changing the stream index (one per path, per thread, ...)
+    class Philox
+    {
+    public:
+        Philox(uint64_t lSeed = 0, uint64_t lStream = 0);
+        virtual ~Philox();
+        
+        //  Raw generator : 4 random 32-bit words for the counter (lCounter, lStream) and the key lSeed
+        void GenerateBlock(uint64_t lCounter, uint32_t iOutput[4]) const;
+        
+        //  i-th uniform of the stream in (0,1) (never 0 nor 1)
+        double Uniform(uint64_t lIndex) const;
+        
+        //  i-th standard gaussian of the stream (inverse cumulative distribution of uniforms independent from the ones above)
+        double Gaussian(uint64_t lIndex) const;
+        
+        //  Batched versions : draws lFirstIndex, lFirstIndex + 1, ... written in the caller's buffer (SIMD kernels when available)
+        //  The draws are the same as the ones given one by one by Uniform and Gaussian
+        void Uniforms(uint64_t lFirstIndex, Utilities::ArrayView<double> dResults) const;
+        void Gaussians(uint64_t lFirstIndex, Utilities::ArrayView<double> dResults) const;
+        
+        //  Sequential access : the next draw(s) of the stream
+        double NextUniform();
+        double NextGaussian();
+        void NextUniforms(Utilities::ArrayView<double> dResults);
+        void NextGaussians(Utilities::ArrayView<double> dResults);
+        
+        //  O(1) skip-ahead of lNDraws draws
+        void Skip(uint64_t lNDraws)
+        {
+            lPosition_ += lNDraws;
+        }
+        
+        void SetPosition(uint64_t lPosition)
+        {
+            lPosition_ = lPosition;
+        }
+        
+        uint64_t GetPosition() const
+        {
+            return lPosition_;
+        }
+        
+        //  Change the substream (and go back to its first draw)
+        void SetStream(uint64_t lStream)
+        {
+            lStream_ = lStream;
+            lPosition_ = 0;
+        }
+        
+        void SetSeed(uint64_t lSeed)
+        {
+            lSeed_ = lSeed;
+            lPosition_ = 0;
+        }
+        
+        uint64_t GetSeed() const
+        {
+            return lSeed_;
+        }
+        
+        uint64_t GetStream() const
+        {
+            return lStream_;
+        }
+        
+    private:
+        uint64_t lSeed_;
+        uint64_t lStream_;
+        uint64_t lPosition_;
+        
+        void GenerateBlock(uint64_t lCounter, uint64_t lDomain, uint32_t iOutput[4]) const;
+        void Uniforms(uint64_t lFirstIndex, uint64_t lDomain, Utilities::ArrayView<double> dResults) const;
+    };
+}
+
+#endif
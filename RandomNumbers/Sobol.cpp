@@ -0,0 +1,314 @@
+//
+//  Sobol.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include "Sobol.h"
+#include "Philox.h"
+#include "Require.h"
+#include "BatchMathFunctions.h"
+
+//  Seed of the pseudo-random initial direction numbers of the dimensions beyond the table (fixed : the sequence never changes)
+#define SOBOLDIRECTIONSEED 0x536F626F6CULL
+
+//  Number of dimensions (after the first one) with tabulated initial direction numbers
+#define SOBOLNTABULATED 20
+
+namespace RandomNumbers {
+
+    namespace {
+
+        //  Initial direction numbers m_1, ..., m_s of the dimensions 2 to 21 (Joe & Kuo, new-joe-kuo-6.21201)
+        //  Their primitive polynomials are the first primitive polynomials by increasing degree, found by NextPrimitivePolynomial
+        const uint32_t iJoeKuoInitialNumbers[SOBOLNTABULATED][8] =
+        {
+            {1},
+            {1, 3},
+            {1, 3, 1},
+            {1, 1, 1},
+            {1, 1, 3, 3},
+            {1, 3, 5, 13},
+            {1, 1, 5, 5, 17},
+            {1, 1, 5, 5, 5},
+            {1, 1, 7, 11, 19},
+            {1, 1, 5, 1, 1},
+            {1, 1, 1, 3, 11},
+            {1, 3, 5, 5, 31},
+            {1, 3, 3, 9, 7, 49},
+            {1, 1, 1, 15, 21, 21},
+            {1, 3, 1, 13, 27, 49},
+            {1, 1, 1, 15, 7, 5},
+            {1, 3, 1, 15, 13, 25},
+            {1, 1, 5, 5, 19, 61},
+            {1, 3, 7, 11, 23, 15, 103},
+            {1, 3, 7, 13, 13, 15, 69}
+        };
+
+        //  Product of two polynomials of GF(2)[x] modulo the polynomial lModulus of degree iDegree (bit i is the coefficient of x^i)
+        uint64_t MultiplyModulo(uint64_t lLeft, uint64_t lRight, uint64_t lModulus, std::size_t iDegree)
+        {
+            uint64_t lResult = 0;
+            while (lRight)
+            {
+                if (lRight & 1)
+                {
+                    lResult ^= lLeft;
+                }
+                lRight >>= 1;
+                lLeft <<= 1;
+                if (lLeft >> iDegree & 1)
+                {
+                    lLeft ^= lModulus;
+                }
+            }
+            return lResult;
+        }
+
+        //  x^lPower modulo lModulus
+        uint64_t PowerOfX(uint64_t lPower, uint64_t lModulus, std::size_t iDegree)
+        {
+            uint64_t lResult = 1, lSquare = iDegree == 1 ? (2 ^ lModulus) : 2;
+            while (lPower)
+            {
+                if (lPower & 1)
+                {
+                    lResult = MultiplyModulo(lResult, lSquare, lModulus, iDegree);
+                }
+                lSquare = MultiplyModulo(lSquare, lSquare, lModulus, iDegree);
+                lPower >>= 1;
+            }
+            return lResult;
+        }
+
+        //  A polynomial of degree s is primitive iff x is of order 2^s - 1 modulo this polynomial
+        bool IsPrimitive(uint64_t lPolynomial, std::size_t iDegree)
+        {
+            uint64_t lOrder = (1ULL << iDegree) - 1;
+            if (PowerOfX(lOrder, lPolynomial, iDegree) != 1)
+            {
+                return false;
+            }
+            //  x^(order / q) must not be 1 for each prime factor q of the order
+            uint64_t lRemaining = lOrder;
+            for (uint64_t lFactor = 2 ; lFactor * lFactor <= lRemaining ; ++lFactor)
+            {
+                if (lRemaining % lFactor == 0)
+                {
+                    if (PowerOfX(lOrder / lFactor, lPolynomial, iDegree) == 1)
+                    {
+                        return false;
+                    }
+                    while (lRemaining % lFactor == 0)
+                    {
+                        lRemaining /= lFactor;
+                    }
+                }
+            }
+            if (lRemaining > 1 && lRemaining != lOrder && PowerOfX(lOrder / lRemaining, lPolynomial, iDegree) == 1)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        //  Next primitive polynomial by increasing degree and coefficients : x^s + a_1 x^(s-1) + ... + a_(s-1) x + 1 is stored as
+        //  its degree s and the integer a = a_1 ... a_(s-1) in base 2
+        void NextPrimitivePolynomial(std::size_t & iDegree, uint32_t & iCoefficients)
+        {
+            do
+            {
+                ++iCoefficients;
+                if (iDegree == 0 || iCoefficients >> (iDegree - 1))
+                {
+                    ++iDegree;
+                    iCoefficients = 0;
+                    Utilities::require(iDegree < SOBOLNBITS, "Sobol : too many dimensions");
+                }
+            }
+            while (!IsPrimitive((1ULL << iDegree) | (static_cast<uint64_t>(iCoefficients) << 1) | 1, iDegree));
+        }
+
+        //  Parity of the number of bits of i
+        inline uint32_t Parity(uint32_t i)
+        {
+            return static_cast<uint32_t>(__builtin_parity(i));
+        }
+    }
+
+    Sobol::Sobol(std::size_t iNDimensions, SobolScrambling eScrambling, unsigned long lSeed) :
+    iNDimensions_(iNDimensions),
+    eScrambling_(eScrambling),
+    iDirections_(iNDimensions * SOBOLNBITS, 0),
+    iShifts_(iNDimensions, 0)
+    {
+        Utilities::require(iNDimensions > 0, "Sobol : number of dimensions has to be positive");
+
+        //  First dimension : van der Corput sequence
+        for (std::size_t k = 0 ; k < SOBOLNBITS ; ++k)
+        {
+            iDirections_[k] = 1U << (SOBOLNBITS - 1 - k);
+        }
+
+        std::size_t iDegree = 0;
+        uint32_t iCoefficients = 0;
+        for (std::size_t iDimension = 1 ; iDimension < iNDimensions_ ; ++iDimension)
+        {
+            NextPrimitivePolynomial(iDegree, iCoefficients);
+            uint32_t * pDirections = &iDirections_[iDimension * SOBOLNBITS];
+
+            //  Initial direction numbers m_k (odd, lower than 2^k), shifted as the k first bits of the direction numbers
+            Philox sGenerator(SOBOLDIRECTIONSEED, iDimension);
+            for (std::size_t k = 0 ; k < iDegree ; ++k)
+            {
+                uint32_t iInitialNumber = 0;
+                if (iDimension <= SOBOLNTABULATED)
+                {
+                    iInitialNumber = iJoeKuoInitialNumbers[iDimension - 1][k];
+                }
+                else
+                {
+                    uint32_t iRandom[4];
+                    sGenerator.GenerateBlock(k, iRandom);
+                    iInitialNumber = (iRandom[0] & ((2U << k) - 1)) | 1;
+                }
+                pDirections[k] = iInitialNumber << (SOBOLNBITS - 1 - k);
+            }
+
+            //  Recurrence of the primitive polynomial on the direction numbers
+            for (std::size_t k = iDegree ; k < SOBOLNBITS ; ++k)
+            {
+                uint32_t iDirection = pDirections[k - iDegree] ^ (pDirections[k - iDegree] >> iDegree);
+                for (std::size_t j = 1 ; j < iDegree ; ++j)
+                {
+                    if ((iCoefficients >> (iDegree - 1 - j)) & 1)
+                    {
+                        iDirection ^= pDirections[k - j];
+                    }
+                }
+                pDirections[k] = iDirection;
+            }
+        }
+
+        if (eScrambling_ != NO_SCRAMBLING)
+        {
+            Scramble(lSeed);
+        }
+        lPosition_ = GetFirstIndex();
+    }
+
+    Sobol::~Sobol()
+    {}
+
+    void Sobol::Scramble(unsigned long lSeed)
+    {
+        for (std::size_t iDimension = 0 ; iDimension < iNDimensions_ ; ++iDimension)
+        {
+            //  One substream of random words per dimension : the SOBOLNBITS first words for the matrix, the next one for the shift
+            Philox sGenerator(lSeed, iDimension);
+            uint32_t iRandom[4];
+            uint32_t * pDirections = &iDirections_[iDimension * SOBOLNBITS];
+
+            if (eScrambling_ == LINEAR_SCRAMBLING)
+            {
+                //  Random lower triangular matrix with unit diagonal acting on the binary digits (most significant digit first) :
+                //  the row of the digit of bit iBit has this bit and random bits on the more significant digits
+                uint32_t iRows[SOBOLNBITS];
+                for (std::size_t iBit = 0 ; iBit < SOBOLNBITS ; ++iBit)
+                {
+                    sGenerator.GenerateBlock(iBit, iRandom);
+                    uint32_t iMoreSignificant = iBit == SOBOLNBITS - 1 ? 0 : (0xFFFFFFFFU << (iBit + 1));
+                    iRows[iBit] = (1U << iBit) | (iRandom[0] & iMoreSignificant);
+                }
+                for (std::size_t k = 0 ; k < SOBOLNBITS ; ++k)
+                {
+                    uint32_t iScrambled = 0;
+                    for (std::size_t iBit = 0 ; iBit < SOBOLNBITS ; ++iBit)
+                    {
+                        iScrambled |= Parity(iRows[iBit] & pDirections[k]) << iBit;
+                    }
+                    pDirections[k] = iScrambled;
+                }
+            }
+
+            sGenerator.GenerateBlock(SOBOLNBITS, iRandom);
+            iShifts_[iDimension] = iRandom[0];
+        }
+    }
+
+    uint32_t Sobol::Integer(uint64_t lIndex, std::size_t iDimension) const
+    {
+        Utilities::require(lIndex >> SOBOLNBITS == 0, "Sobol : index out of the sequence");
+
+        //  Gray code order : the point i is the sum of the direction numbers of the bits of i xor (i >> 1)
+        uint64_t lGrayCode = lIndex ^ (lIndex >> 1);
+        const uint32_t * pDirections = &iDirections_[iDimension * SOBOLNBITS];
+        uint32_t iResult = iShifts_[iDimension];
+        for (std::size_t k = 0 ; lGrayCode ; ++k, lGrayCode >>= 1)
+        {
+            if (lGrayCode & 1)
+            {
+                iResult ^= pDirections[k];
+            }
+        }
+        return iResult;
+    }
+
+    double Sobol::Uniform(uint64_t lIndex, std::size_t iDimension) const
+    {
+        return (Integer(lIndex, iDimension) + 0.5) * (1.0 / 4294967296.0);
+    }
+
+    void Sobol::Point(uint64_t lIndex, Utilities::ArrayView<double> dPoint) const
+    {
+        Utilities::require(dPoint.size() <= iNDimensions_, "Sobol : too many dimensions");
+        for (std::size_t iDimension = 0 ; iDimension < dPoint.size() ; ++iDimension)
+        {
+            dPoint[iDimension] = Uniform(lIndex, iDimension);
+        }
+    }
+
+    void Sobol::Uniforms(uint64_t lFirstIndex, Utilities::MatrixView<double> dPoints, std::size_t iFirstDimension) const
+    {
+        Utilities::require(iFirstDimension + dPoints.rows() <= iNDimensions_, "Sobol : too many dimensions");
+        std::size_t iNPoints = dPoints.columns();
+        if (iNPoints == 0)
+        {
+            return;
+        }
+        Utilities::require((lFirstIndex + iNPoints - 1) >> SOBOLNBITS == 0, "Sobol : index out of the sequence");
+
+        for (std::size_t iRow = 0 ; iRow < dPoints.rows() ; ++iRow)
+        {
+            //  The first point directly, the next ones by flipping one direction number : point i and i - 1 differ by the direction number
+            //  of the lowest bit set in i
+            std::size_t iDimension = iFirstDimension + iRow;
+            Utilities::ArrayView<double> dCoordinates = dPoints[iRow];
+            const uint32_t * pDirections = &iDirections_[iDimension * SOBOLNBITS];
+            uint32_t iCurrent = Integer(lFirstIndex, iDimension);
+            dCoordinates[0] = (iCurrent + 0.5) * (1.0 / 4294967296.0);
+            for (std::size_t iPoint = 1 ; iPoint < iNPoints ; ++iPoint)
+            {
+                iCurrent ^= pDirections[__builtin_ctzll(lFirstIndex + iPoint)];
+                dCoordinates[iPoint] = (iCurrent + 0.5) * (1.0 / 4294967296.0);
+            }
+        }
+    }
+
+    void Sobol::Gaussians(uint64_t lFirstIndex, Utilities::MatrixView<double> dPoints, std::size_t iFirstDimension) const
+    {
+        Uniforms(lFirstIndex, dPoints, iFirstDimension);
+        for (std::size_t iRow = 0 ; iRow < dPoints.rows() ; ++iRow)
+        {
+            MathFunctions::InvCumNorm(dPoints[iRow], dPoints[iRow]);
+        }
+    }
+
+    void Sobol::NextPoint(Utilities::ArrayView<double> dPoint)
+    {
+        Point(lPosition_, dPoint);
+        ++lPosition_;
+    }
+}
@@ -0,0 +1,105 @@
+//
+//  Sobol.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_Sobol_h
+#define Seminaire_Sobol_h
+
+#include <stdint.h>
+#include <vector>
+#include "ArrayView.h"
+
+//  Number of bits of the points : the sequence has 2^32 points
+#define SOBOLNBITS 32
+
+namespace RandomNumbers {
+
+    typedef enum
+    {
+        NO_SCRAMBLING,          //  Plain Sobol sequence
+        DIGITAL_SHIFT,          //  Random digital shift (xor of a random point)
+        LINEAR_SCRAMBLING       //  Random linear scrambling (Matousek) followed by a random digital shift
+    } SobolScrambling;
+
+    //  Sobol low-discrepancy sequence in base 2 (Bratley & Fox, Joe & Kuo)
+    //
+    //  The first dimensions use the primitive polynomials and initial direction numbers of Joe & Kuo (2008), the next ones the following
+    //  primitive polynomials (found once when the generator is built) with pseudo-random initial direction numbers, so that several hundreds
+    //  of dimensions are available.
+    //  The points are given in Gray code order : the i-th point is a pure function of i (O(1) skip-ahead) and consecutive points differ by
+    //  one direction number (O(1) per coordinate in the batched / sequential generation).
+    //  The scramblings are randomized by lSeed and keep the low-discrepancy structure of the sequence.
+    class Sobol
+    {
+    public:
+        Sobol(std::size_t iNDimensions, SobolScrambling eScrambling = NO_SCRAMBLING, unsigned long lSeed = 0);
+        virtual ~Sobol();
+
+        std::size_t GetNbDimensions() const
+        {
+            return iNDimensions_;
+        }
+
+        SobolScrambling GetScrambling() const
+        {
+            return eScrambling_;
+        }
+
+        //  Coordinate iDimension of the point lIndex in (0,1) (the 32-bit integer k is mapped to (k + 1/2) / 2^32)
+        double Uniform(uint64_t lIndex, std::size_t iDimension) const;
+
+        //  Point lIndex (one coordinate per dimension)
+        void Point(uint64_t lIndex, Utilities::ArrayView<double> dPoint) const;
+
+        //  Points lFirstIndex, lFirstIndex + 1, ... : dPoints[iDimension - iFirstDimension][iPoint], for the dPoints.rows() dimensions
+        //  starting at iFirstDimension
+        void Uniforms(uint64_t lFirstIndex, Utilities::MatrixView<double> dPoints, std::size_t iFirstDimension = 0) const;
+
+        //  Same points mapped to standard gaussians by the inverse cumulative distribution
+        void Gaussians(uint64_t lFirstIndex, Utilities::MatrixView<double> dPoints, std::size_t iFirstDimension = 0) const;
+
+        //  Sequential access : the next point of the sequence
+        //  The plain sequence starts at its second point since its first point is the origin (gaussians far in the tails)
+        void NextPoint(Utilities::ArrayView<double> dPoint);
+
+        void Skip(uint64_t lNPoints)
+        {
+            lPosition_ += lNPoints;
+        }
+
+        void SetPosition(uint64_t lPosition)
+        {
+            lPosition_ = lPosition;
+        }
+
+        uint64_t GetPosition() const
+        {
+            return lPosition_;
+        }
+
+        //  First point of the sequence worth using : 1 for the plain sequence, 0 for the scrambled ones
+        uint64_t GetFirstIndex() const
+        {
+            return eScrambling_ == NO_SCRAMBLING ? 1 : 0;
+        }
+
+    private:
+        std::size_t iNDimensions_;
+        SobolScrambling eScrambling_;
+        uint64_t lPosition_;
+
+        //  iDirections_[iDimension * SOBOLNBITS + k] : k-th direction number of the dimension (scrambled if needed)
+        std::vector<uint32_t> iDirections_;
+        //  Digital shift of each dimension (0 if no scrambling)
+        std::vector<uint32_t> iShifts_;
+
+        uint32_t Integer(uint64_t lIndex, std::size_t iDimension) const;
+        void Scramble(unsigned long lSeed);
+    };
+}
+
+#endif
@@ -8,20 +8,21 @@
 
 #include <iostream>
 #include "Uniform.h"
-#include <tr1/random>
-#include <time.h>
+#include "Philox.h"
 
 namespace RandomNumbers {
 
     //  Default constructor
-    Uniform::Uniform() : dLeft_(0.0), dRight_(1.0), iNRealisations_(1), iAntitheticVariables_(0)
+    Uniform::Uniform() : dLeft_(0.0), dRight_(1.0), iNRealisations_(1), iAntitheticVariables_(0), lSeed_(0), lStream_(0)
     {
         dRealisations_.resize(iNRealisations_);
     }
 
     //  Constructor
-    Uniform::Uniform(double dLeft, double dRight, size_t iNRealisations, int iAntitheticVariables)
+    Uniform::Uniform(double dLeft, double dRight, size_t iNRealisations, int iAntitheticVariables, unsigned long lSeed, unsigned long lStream)
     {
+        lSeed_          = lSeed;
+        lStream_        = lStream;
         dLeft_          = dLeft;
         dRight_         = dRight;
         iAntitheticVariables_ = iAntitheticVariables;
@@ -37,21 +38,27 @@ namespace RandomNumbers {
 
     void Uniform::GenerateUniform()
     {
-        std::tr1::ranlux64_base_01 eng; // core engine class
-        eng.seed(time(NULL));
-        
-        // Generation of uniforms via this distribution
-        std::tr1::uniform_real<double> dist(dLeft_, dRight_);
-        dist.reset();
+        //  The i-th realisation is the i-th uniform of the substream : same seed, same realisations
+        Philox sGenerator(lSeed_, lStream_);
         
+        if (!iAntitheticVariables_ && iNRealisations_ > 0)
+        {
+            //  Batched generation directly in the realisations
+            sGenerator.Uniforms(0, Utilities::ArrayView<double>(&dRealisations_[0], iNRealisations_));
+            for (std::size_t i = 0 ; i < iNRealisations_ ; ++i)
+            {
+                dRealisations_[i] = dLeft_ + (dRight_ - dLeft_) * dRealisations_[i];
+            }
+            return;
+        }
         for (std::size_t i = 0 ; i < iNRealisations_ ; ++i)
         {
-            dRealisations_[i] = dist(eng);
+            dRealisations_[i] = dLeft_ + (dRight_ - dLeft_) * sGenerator.Uniform(i);
             if (iAntitheticVariables_)
             {
                 //  Antithetic variables
                 i++;
-                dRealisations_[i] = dLeft_ + (dRight_ - dLeft_) * (1 - dRealisations_[i - 1]);
+                dRealisations_[i] = dLeft_ + dRight_ - dRealisations_[i - 1];
             }
         }
     }
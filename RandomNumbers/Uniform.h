@@ -18,11 +18,12 @@ namespace RandomNumbers {
     {
     public:
         Uniform();
-        Uniform(double dLeft, double dRight, std::size_t iNRealisations, int iAntitheticVariables = false);
+        //  Realisations are drawn from the substream lStream of the counter-based generator seeded with lSeed
+        Uniform(double dLeft, double dRight, std::size_t iNRealisations, int iAntitheticVariables = false, unsigned long lSeed = 0, unsigned long lStream = 0);
         virtual ~Uniform();
 
         virtual void GenerateUniform();
-        virtual std::vector<double> GetRealisations() const
+        virtual const std::vector<double> & GetRealisations() const
         {
             return dRealisations_;
         };
@@ -34,6 +35,8 @@ namespace RandomNumbers {
 
         std::vector<double> dRealisations_;
         size_t iNRealisations_;
+        unsigned long lSeed_;
+        unsigned long lStream_;
 
     };
 
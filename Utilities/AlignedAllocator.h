@@ -0,0 +1,109 @@
+//
+//  AlignedAllocator.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_AlignedAllocator_h
+#define Seminaire_AlignedAllocator_h
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace Utilities {
+
+    //  Standard allocator returning memory aligned on iAlignment bytes (a power of two, multiple of sizeof(void*))
+    //  Used to store large contiguous buffers (simulated paths, ...) aligned on cache lines / SIMD registers
+    template<class T, std::size_t iAlignment = 64>
+    class AlignedAllocator
+    {
+    public:
+        typedef T               value_type;
+        typedef T*              pointer;
+        typedef const T*        const_pointer;
+        typedef T&              reference;
+        typedef const T&        const_reference;
+        typedef std::size_t     size_type;
+        typedef std::ptrdiff_t  difference_type;
+
+        template<class U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, iAlignment> other;
+        };
+
+        AlignedAllocator()
+        {}
+
+        AlignedAllocator(const AlignedAllocator &)
+        {}
+
+        template<class U>
+        AlignedAllocator(const AlignedAllocator<U, iAlignment> &)
+        {}
+
+        ~AlignedAllocator()
+        {}
+
+        pointer address(reference x) const
+        {
+            return &x;
+        }
+
+        const_pointer address(const_reference x) const
+        {
+            return &x;
+        }
+
+        pointer allocate(size_type n, const void * = 0)
+        {
+            if (n == 0)
+            {
+                return 0;
+            }
+            void * p = 0;
+            if (posix_memalign(&p, iAlignment, n * sizeof(T)) != 0)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<pointer>(p);
+        }
+
+        void deallocate(pointer p, size_type)
+        {
+            free(p);
+        }
+
+        size_type max_size() const
+        {
+            return static_cast<size_type>(-1) / sizeof(T);
+        }
+
+        void construct(pointer p, const T & value)
+        {
+            new (static_cast<void*>(p)) T(value);
+        }
+
+        void destroy(pointer p)
+        {
+            p->~T();
+        }
+    };
+
+    template<class T, class U, std::size_t iAlignment>
+    inline bool operator == (const AlignedAllocator<T, iAlignment> &, const AlignedAllocator<U, iAlignment> &)
+    {
+        return true;
+    }
+
+    template<class T, class U, std::size_t iAlignment>
+    inline bool operator != (const AlignedAllocator<T, iAlignment> &, const AlignedAllocator<U, iAlignment> &)
+    {
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+//
+//  AllocationCounter.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.h"
+
+#ifdef SEMINAIRE_ALLOCATION_COUNTER
+
+#if __cplusplus < 201103L
+#define SEMINAIRE_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define SEMINAIRE_NO_THROW throw()
+#else
+#define SEMINAIRE_THROW_BAD_ALLOC
+#define SEMINAIRE_NO_THROW noexcept
+#endif
+
+namespace {
+    volatile std::size_t iNAllocations = 0;
+    
+    void * CountedAllocation(std::size_t iSize)
+    {
+        __sync_fetch_and_add(&iNAllocations, 1);
+        void * p = malloc(iSize ? iSize : 1);
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+}
+
+namespace Utilities {
+    
+    bool AllocationCounter::IsEnabled()
+    {
+        return true;
+    }
+    
+    std::size_t AllocationCounter::GetNbAllocations()
+    {
+        return iNAllocations;
+    }
+    
+    void AllocationCounter::Reset()
+    {
+        __sync_lock_test_and_set(&iNAllocations, 0);
+    }
+}
+
+void * operator new (std::size_t iSize) SEMINAIRE_THROW_BAD_ALLOC
+{
+    return CountedAllocation(iSize);
+}
+
+void * operator new[] (std::size_t iSize) SEMINAIRE_THROW_BAD_ALLOC
+{
+    return CountedAllocation(iSize);
+}
+
+void operator delete (void * p) SEMINAIRE_NO_THROW
+{
+    free(p);
+}
+
+void operator delete[] (void * p) SEMINAIRE_NO_THROW
+{
+    free(p);
+}
+
+#else
+
+namespace Utilities {
+    
+    bool AllocationCounter::IsEnabled()
+    {
+        return false;
+    }
+    
+    std::size_t AllocationCounter::GetNbAllocations()
+    {
+        return 0;
+    }
+    
+    void AllocationCounter::Reset()
+    {}
+}
+
+#endif
@@ -0,0 +1,30 @@
+//
+//  AllocationCounter.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_AllocationCounter_h
+#define Seminaire_AllocationCounter_h
+
+#include <cstddef>
+
+namespace Utilities {
+    
+    //  Counts the calls to the global operator new, replaced in AllocationCounter.cpp only in a diagnostic build compiled with
+    //  SEMINAIRE_ALLOCATION_COUNTER defined (the replacement adds an atomic increment to every allocation)
+    //  Used to check that pricing routines do not allocate per path
+    class AllocationCounter
+    {
+    public:
+        //  Whether the allocations are counted (otherwise GetNbAllocations always returns 0)
+        static bool IsEnabled();
+        //  Number of allocations since the last Reset
+        static std::size_t GetNbAllocations();
+        static void Reset();
+    };
+}
+
+#endif
@@ -0,0 +1,137 @@
+//
+//  ArrayView.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_ArrayView_h
+#define Seminaire_ArrayView_h
+
+#include <cstddef>
+
+namespace Utilities {
+
+    //  Non-owning view over contiguous elements (pointer + size), never copies the data
+    //  Use ArrayView<const T> for read-only access
+    template<class T>
+    class ArrayView
+    {
+    public:
+        typedef T           value_type;
+        typedef T*          iterator;
+        typedef std::size_t size_type;
+
+        ArrayView() : pData_(0), iSize_(0)
+        {}
+
+        ArrayView(T * pData, std::size_t iSize) : pData_(pData), iSize_(iSize)
+        {}
+
+        //  Conversion from a non-const view to a const view
+        template<class U>
+        ArrayView(const ArrayView<U> & sView) : pData_(sView.data()), iSize_(sView.size())
+        {}
+
+        T & operator [] (std::size_t i) const
+        {
+            return pData_[i];
+        }
+
+        T * data() const
+        {
+            return pData_;
+        }
+
+        std::size_t size() const
+        {
+            return iSize_;
+        }
+
+        bool empty() const
+        {
+            return iSize_ == 0;
+        }
+
+        T * begin() const
+        {
+            return pData_;
+        }
+
+        T * end() const
+        {
+            return pData_ + iSize_;
+        }
+
+        //  Sub-view of iCount elements starting at iOffset
+        ArrayView<T> Slice(std::size_t iOffset, std::size_t iCount) const
+        {
+            return ArrayView<T>(pData_ + iOffset, iCount);
+        }
+
+    private:
+        T * pData_;
+        std::size_t iSize_;
+    };
+
+    //  Non-owning row-major view over a 2D block : iNRows rows of iNColumns elements, each row starting iStride elements after the previous one
+    template<class T>
+    class MatrixView
+    {
+    public:
+        MatrixView() : pData_(0), iNRows_(0), iNColumns_(0), iStride_(0)
+        {}
+
+        MatrixView(T * pData, std::size_t iNRows, std::size_t iNColumns, std::size_t iStride) : pData_(pData), iNRows_(iNRows), iNColumns_(iNColumns), iStride_(iStride)
+        {}
+
+        template<class U>
+        MatrixView(const MatrixView<U> & sView) : pData_(sView.data()), iNRows_(sView.rows()), iNColumns_(sView.columns()), iStride_(sView.stride())
+        {}
+
+        ArrayView<T> operator [] (std::size_t iRow) const
+        {
+            return ArrayView<T>(pData_ + iRow * iStride_, iNColumns_);
+        }
+
+        T & operator () (std::size_t iRow, std::size_t iColumn) const
+        {
+            return pData_[iRow * iStride_ + iColumn];
+        }
+
+        T * data() const
+        {
+            return pData_;
+        }
+
+        std::size_t rows() const
+        {
+            return iNRows_;
+        }
+
+        std::size_t columns() const
+        {
+            return iNColumns_;
+        }
+
+        std::size_t stride() const
+        {
+            return iStride_;
+        }
+
+        //  Sub-view of the iCount columns starting at iOffset (all the rows)
+        MatrixView<T> SliceColumns(std::size_t iOffset, std::size_t iCount) const
+        {
+            return MatrixView<T>(pData_ + iOffset, iNRows_, iCount, iStride_);
+        }
+
+    private:
+        T * pData_;
+        std::size_t iNRows_;
+        std::size_t iNColumns_;
+        std::size_t iStride_;
+    };
+}
+
+#endif
@@ -0,0 +1,57 @@
+//
+//  CPUFeatures.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include "CPUFeatures.h"
+
+namespace Utilities {
+    
+    namespace {
+        
+        SIMDLevel DetectSIMDLevel()
+        {
+#ifdef SEMINAIRE_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return SIMD_AVX512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return SIMD_AVX2;
+            }
+#endif
+            return SIMD_SCALAR;
+        }
+        
+        SIMDLevel eMaxSIMDLevel = SIMD_AVX512;
+    }
+    
+    SIMDLevel GetSIMDLevel()
+    {
+        static const SIMDLevel eCPUSIMDLevel = DetectSIMDLevel();
+        return eCPUSIMDLevel < eMaxSIMDLevel ? eCPUSIMDLevel : eMaxSIMDLevel;
+    }
+    
+    void SetMaxSIMDLevel(SIMDLevel eSIMDLevel)
+    {
+        eMaxSIMDLevel = eSIMDLevel;
+    }
+    
+    const char * GetSIMDLevelName(SIMDLevel eSIMDLevel)
+    {
+        switch (eSIMDLevel)
+        {
+            case SIMD_AVX512:
+                return "AVX-512";
+            case SIMD_AVX2:
+                return "AVX2";
+            default:
+                return "Scalar";
+        }
+    }
+}
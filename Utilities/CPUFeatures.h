@@ -0,0 +1,41 @@
+//
+//  CPUFeatures.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_CPUFeatures_h
+#define Seminaire_CPUFeatures_h
+
+//  SIMD kernels are only compiled on x86 with gcc or clang (function multi-versioning through the target attribute)
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SEMINAIRE_X86_SIMD 1
+#if defined(__clang__)
+#define SEMINAIRE_TARGET(cTarget) __attribute__((target(cTarget)))
+#else
+//  No contraction in fused multiply-add so that the SIMD kernels give the same results as the scalar code
+#define SEMINAIRE_TARGET(cTarget) __attribute__((target(cTarget), optimize("fp-contract=off")))
+#endif
+#endif
+
+namespace Utilities {
+    
+    typedef enum
+    {
+        SIMD_SCALAR,
+        SIMD_AVX2,
+        SIMD_AVX512
+    }SIMDLevel;
+    
+    //  Best instruction set available on the running CPU (detected once), capped by SetMaxSIMDLevel
+    SIMDLevel GetSIMDLevel();
+    
+    //  Cap the instruction set used by the batched kernels (for benchmarks and comparisons with the scalar code)
+    void SetMaxSIMDLevel(SIMDLevel eSIMDLevel);
+    
+    const char * GetSIMDLevelName(SIMDLevel eSIMDLevel);
+}
+
+#endif
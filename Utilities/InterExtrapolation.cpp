@@ -7,296 +7,860 @@
 //
 
 #include <iostream>
+#include <algorithm>
 #include "InterExtrapolation.h"
-#include "VectorUtilities.h"
 #include <cmath>
 #include "Require.h"
+#include "CPUFeatures.h"
+
+#ifdef SEMINAIRE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+//  Number of points located then evaluated together by the batched interpolation
+#define INTERPOLATIONBATCHSIZE 256
+
+//  Number of intervals walked from the hint before the search of Locate
+#define INTERPOLATIONMAXWALK 8
+
+//  Number of nodes around a point of an InterExtrapolationnD
+#define INTERPOLATIONNDMAXCORNERS (1 << INTERPOLATIONNDMAXDIMENSIONS)
 
 namespace Utilities
 {
     namespace Interp 
     {
-        InterExtrapolation1D::InterExtrapolation1D() : eInterpolationType_(NEAR), iNValues_(0)
+        namespace {
+
+#ifdef SEMINAIRE_X86_SIMD
+            //  The kernels compute the same operations in the same order as InterExtrapolation1D::Evaluate (same values)
+            //  X : pillars, V : values, iLast : index of the last pillar (at least 1), i : intervals of the points found by Locate
+
+            //  Gathers with a full mask on a zeroed source : gcc implements the unmasked gathers on an undefined source register
+            SEMINAIRE_TARGET("avx2")
+            inline __m256d GatherAVX2(const double * p, __m128i iIndex)
+            {
+                return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, iIndex, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+            }
+
+            SEMINAIRE_TARGET("avx512f")
+            inline __m512d GatherAVX512(const double * p, __m256i iIndex)
+            {
+                return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, iIndex, p, 8);
+            }
+
+            //  LIN : interval [i, i + 1], or the line through the last and the first pillars outside the pillars
+            SEMINAIRE_TARGET("avx2")
+            std::size_t LinearAVX2(const double * x, const int * i, double * dResults, std::size_t iN, const double * X, const double * V, int iLast)
+            {
+                const __m128i iLastIndex = _mm_set1_epi32(iLast), iZero = _mm_setzero_si128(), iOne = _mm_set1_epi32(1);
+                std::size_t j = 0;
+                for ( ; j + 4 <= iN ; j += 4)
+                {
+                    __m128i iIndex = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i + j));
+                    __m128i iOutside = _mm_or_si128(_mm_cmplt_epi32(iIndex, iZero), _mm_cmpeq_epi32(iIndex, iLastIndex));
+                    __m128i iLow = _mm_blendv_epi8(iIndex, iLastIndex, iOutside), iHigh = _mm_blendv_epi8(_mm_add_epi32(iIndex, iOne), iZero, iOutside);
+
+                    __m256d dXLow = GatherAVX2(X, iLow), dXHigh = GatherAVX2(X, iHigh);
+                    __m256d dVLow = GatherAVX2(V, iLow), dVHigh = GatherAVX2(V, iHigh);
+                    __m256d dX = _mm256_loadu_pd(x + j);
+                    __m256d dSlope = _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(dVHigh, dVLow), _mm256_sub_pd(dX, dXLow)), _mm256_sub_pd(dXHigh, dXLow));
+                    _mm256_storeu_pd(dResults + j, _mm256_add_pd(dVLow, dSlope));
+                }
+                return j;
+            }
+
+            //  SPLINE_CUBIC : cubic on [i, i + 1], linear extrapolation with the slopes at the first and the last pillars (Y2 : second derivatives)
+            SEMINAIRE_TARGET("avx2")
+            std::size_t SplineAVX2(const double * x, const int * i, double * dResults, std::size_t iN, const double * X, const double * V, const double * Y2, int iLast, double dLowerSlope, double dUpperSlope)
+            {
+                const __m128i iLastIndex = _mm_set1_epi32(iLast), iLastInterval = _mm_set1_epi32(iLast - 1), iZero = _mm_setzero_si128(), iOne = _mm_set1_epi32(1);
+                const __m256d dSix = _mm256_set1_pd(6.0);
+                const __m256d dFirstX = _mm256_set1_pd(X[0]), dFirstV = _mm256_set1_pd(V[0]), dLastX = _mm256_set1_pd(X[iLast]), dLastV = _mm256_set1_pd(V[iLast]);
+                const __m256d dLowerSlopes = _mm256_set1_pd(dLowerSlope), dUpperSlopes = _mm256_set1_pd(dUpperSlope);
+                std::size_t j = 0;
+                for ( ; j + 4 <= iN ; j += 4)
+                {
+                    __m128i iIndex = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i + j));
+                    __m128i iLow = _mm_min_epi32(_mm_max_epi32(iIndex, iZero), iLastInterval), iHigh = _mm_add_epi32(iLow, iOne);
+                    __m256d dBelow = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmplt_epi32(iIndex, iZero)));
+                    __m256d dAbove = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(iIndex, iLastIndex)));
+
+                    __m256d dXLow = GatherAVX2(X, iLow), dXHigh = GatherAVX2(X, iHigh);
+                    __m256d dVLow = GatherAVX2(V, iLow), dVHigh = GatherAVX2(V, iHigh);
+                    __m256d dY2Low = GatherAVX2(Y2, iLow), dY2High = GatherAVX2(Y2, iHigh);
+                    __m256d dX = _mm256_loadu_pd(x + j);
+
+                    __m256d h = _mm256_sub_pd(dXHigh, dXLow);
+                    __m256d a = _mm256_div_pd(_mm256_sub_pd(dXHigh, dX), h), b = _mm256_div_pd(_mm256_sub_pd(dX, dXLow), h);
+                    __m256d dCubicA = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(a, a), a), a), dCubicB = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(b, b), b), b);
+                    __m256d dCurvature = _mm256_add_pd(_mm256_mul_pd(dCubicA, dY2Low), _mm256_mul_pd(dCubicB, dY2High));
+                    __m256d dResult = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a, dVLow), _mm256_mul_pd(b, dVHigh)), _mm256_div_pd(_mm256_mul_pd(dCurvature, _mm256_mul_pd(h, h)), dSix));
+
+                    dResult = _mm256_blendv_pd(dResult, _mm256_add_pd(dFirstV, _mm256_mul_pd(_mm256_sub_pd(dX, dFirstX), dLowerSlopes)), dBelow);
+                    dResult = _mm256_blendv_pd(dResult, _mm256_add_pd(dLastV, _mm256_mul_pd(_mm256_sub_pd(dX, dLastX), dUpperSlopes)), dAbove);
+                    _mm256_storeu_pd(dResults + j, dResult);
+                }
+                return j;
+            }
+
+            //  Step interpolations : value of the pillar min(max(i + iShift, 0), iLast)
+            SEMINAIRE_TARGET("avx2")
+            std::size_t StepAVX2(const int * i, double * dResults, std::size_t iN, const double * V, int iLast, int iShift)
+            {
+                const __m128i iLastIndex = _mm_set1_epi32(iLast), iZero = _mm_setzero_si128(), iShifts = _mm_set1_epi32(iShift);
+                std::size_t j = 0;
+                for ( ; j + 4 <= iN ; j += 4)
+                {
+                    __m128i iIndex = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i + j));
+                    iIndex = _mm_min_epi32(_mm_max_epi32(_mm_add_epi32(iIndex, iShifts), iZero), iLastIndex);
+                    _mm256_storeu_pd(dResults + j, GatherAVX2(V, iIndex));
+                }
+                return j;
+            }
+
+            //  AVX-512 versions : the indices are handled with AVX2 instructions, the lane masks are built from their sign bits
+            SEMINAIRE_TARGET("avx512f")
+            std::size_t LinearAVX512(const double * x, const int * i, double * dResults, std::size_t iN, const double * X, const double * V, int iLast)
+            {
+                const __m256i iLastIndex = _mm256_set1_epi32(iLast), iZero = _mm256_setzero_si256(), iOne = _mm256_set1_epi32(1);
+                std::size_t j = 0;
+                for ( ; j + 8 <= iN ; j += 8)
+                {
+                    __m256i iIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(i + j));
+                    __m256i iOutside = _mm256_or_si256(_mm256_cmpgt_epi32(iZero, iIndex), _mm256_cmpeq_epi32(iIndex, iLastIndex));
+                    __m256i iLow = _mm256_blendv_epi8(iIndex, iLastIndex, iOutside), iHigh = _mm256_blendv_epi8(_mm256_add_epi32(iIndex, iOne), iZero, iOutside);
+
+                    __m512d dXLow = GatherAVX512(X, iLow), dXHigh = GatherAVX512(X, iHigh);
+                    __m512d dVLow = GatherAVX512(V, iLow), dVHigh = GatherAVX512(V, iHigh);
+                    __m512d dX = _mm512_loadu_pd(x + j);
+                    __m512d dSlope = _mm512_div_pd(_mm512_mul_pd(_mm512_sub_pd(dVHigh, dVLow), _mm512_sub_pd(dX, dXLow)), _mm512_sub_pd(dXHigh, dXLow));
+                    _mm512_storeu_pd(dResults + j, _mm512_add_pd(dVLow, dSlope));
+                }
+                return j;
+            }
+
+            SEMINAIRE_TARGET("avx512f")
+            std::size_t SplineAVX512(const double * x, const int * i, double * dResults, std::size_t iN, const double * X, const double * V, const double * Y2, int iLast, double dLowerSlope, double dUpperSlope)
+            {
+                const __m256i iLastIndex = _mm256_set1_epi32(iLast), iLastInterval = _mm256_set1_epi32(iLast - 1), iZero = _mm256_setzero_si256(), iOne = _mm256_set1_epi32(1);
+                const __m512d dSix = _mm512_set1_pd(6.0);
+                const __m512d dFirstX = _mm512_set1_pd(X[0]), dFirstV = _mm512_set1_pd(V[0]), dLastX = _mm512_set1_pd(X[iLast]), dLastV = _mm512_set1_pd(V[iLast]);
+                const __m512d dLowerSlopes = _mm512_set1_pd(dLowerSlope), dUpperSlopes = _mm512_set1_pd(dUpperSlope);
+                std::size_t j = 0;
+                for ( ; j + 8 <= iN ; j += 8)
+                {
+                    __m256i iIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(i + j));
+                    __m256i iLow = _mm256_min_epi32(_mm256_max_epi32(iIndex, iZero), iLastInterval), iHigh = _mm256_add_epi32(iLow, iOne);
+                    __mmask8 iBelow = static_cast<__mmask8>(_mm256_movemask_ps(_mm256_castsi256_ps(iIndex)));
+                    __mmask8 iAbove = static_cast<__mmask8>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(iIndex, iLastIndex))));
+
+                    __m512d dXLow = GatherAVX512(X, iLow), dXHigh = GatherAVX512(X, iHigh);
+                    __m512d dVLow = GatherAVX512(V, iLow), dVHigh = GatherAVX512(V, iHigh);
+                    __m512d dY2Low = GatherAVX512(Y2, iLow), dY2High = GatherAVX512(Y2, iHigh);
+                    __m512d dX = _mm512_loadu_pd(x + j);
+
+                    __m512d h = _mm512_sub_pd(dXHigh, dXLow);
+                    __m512d a = _mm512_div_pd(_mm512_sub_pd(dXHigh, dX), h), b = _mm512_div_pd(_mm512_sub_pd(dX, dXLow), h);
+                    __m512d dCubicA = _mm512_sub_pd(_mm512_mul_pd(_mm512_mul_pd(a, a), a), a), dCubicB = _mm512_sub_pd(_mm512_mul_pd(_mm512_mul_pd(b, b), b), b);
+                    __m512d dCurvature = _mm512_add_pd(_mm512_mul_pd(dCubicA, dY2Low), _mm512_mul_pd(dCubicB, dY2High));
+                    __m512d dResult = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(a, dVLow), _mm512_mul_pd(b, dVHigh)), _mm512_div_pd(_mm512_mul_pd(dCurvature, _mm512_mul_pd(h, h)), dSix));
+
+                    dResult = _mm512_mask_blend_pd(iBelow, dResult, _mm512_add_pd(dFirstV, _mm512_mul_pd(_mm512_sub_pd(dX, dFirstX), dLowerSlopes)));
+                    dResult = _mm512_mask_blend_pd(iAbove, dResult, _mm512_add_pd(dLastV, _mm512_mul_pd(_mm512_sub_pd(dX, dLastX), dUpperSlopes)));
+                    _mm512_storeu_pd(dResults + j, dResult);
+                }
+                return j;
+            }
+
+            SEMINAIRE_TARGET("avx512f")
+            std::size_t StepAVX512(const int * i, double * dResults, std::size_t iN, const double * V, int iLast, int iShift)
+            {
+                const __m256i iLastIndex = _mm256_set1_epi32(iLast), iZero = _mm256_setzero_si256(), iShifts = _mm256_set1_epi32(iShift);
+                std::size_t j = 0;
+                for ( ; j + 8 <= iN ; j += 8)
+                {
+                    __m256i iIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(i + j));
+                    iIndex = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(iIndex, iShifts), iZero), iLastIndex);
+                    _mm512_storeu_pd(dResults + j, GatherAVX512(V, iIndex));
+                }
+                return j;
+            }
+#endif
+        }
+
+        InterExtrapolation1D::InterExtrapolation1D() : eInterpolationType_(NEAR), iNValues_(0), dLowerSlope_(0.0), dUpperSlope_(0.0), bIsUniformGrid_(false), dFirstVariable_(0.0), dInverseStep_(0.0)
         {}
-        
+
         InterExtrapolation1D::InterExtrapolation1D(const std::vector<double> & dVariables,
                                                    const std::vector<double> & dValues,
-                                                   InterExtrapolationType eInterpolationType) : 
-        
+                                                   InterExtrapolationType eInterpolationType) :
+
         iNValues_(dValues.size()),
         dValues_(dValues),
         dVariables_(dVariables),
         eInterpolationType_(eInterpolationType)
-        
+
         {
             Utilities::require(dValues_.size() == dVariables_.size(), "Values and variables are not of the same size");
-            if (eInterpolationType_ == SPLINE_CUBIC)
-            {
-                //  Compute the second derivative
-                
-                //  Adapted from Numerical Recipes in C (page 139)
-                
-                //Given arrays x[1..n] and y[1..n] containing a tabulated function, i.e., yi = f(xi), with
-                //x1 < x2 < .. . < xN, and given values yp1 and ypn for the first derivative of the interpolating
-                //    function at points 1 and n, respectively, this routine returns an array y2[1..n] that contains
-                //    the second derivatives of the interpolating function at the tabulated points xi. If yp1 and/or
-                //    ypn are equal to 1 × 1030 or larger, the routine is signaled to set the corresponding boundary
-                //    condition for a natural spline, with zero second derivative on that boundary.
-                
-                double yp1 = 0.0, ypn = 0.0;
-                int i,k, n = static_cast<int>(dVariables_.size());
-                double p,qn,sig,un;
-                std::vector<double> u(n-1);
-                //  Had to resize the second derivative values to n+1 because it was coded this way in Numerical Recipes (to be changed)
-                dSecondDerivativeValues_.resize(n+1);
-                if (yp1 > 0.99e30)
+            UpdateGrid();
+        }
+
+        InterExtrapolation1D::~InterExtrapolation1D()
+        {}
+
+        void InterExtrapolation1D::UpdateGrid()
+        {
+            iNValues_ = dVariables_.size();
+            bIsUniformGrid_ = false;
+            dFirstVariable_ = iNValues_ > 0 ? dVariables_[0] : 0.0;
+            dInverseStep_ = 0.0;
+            Utilities::require(dValues_.size() == iNValues_, "Values and variables are not of the same size");
+
+            //  Pillars given in any order are sorted once (with their values)
+            bool bIsSorted = true;
+            for (std::size_t i = 1 ; i < iNValues_ && bIsSorted ; ++i)
+            {
+                bIsSorted = dVariables_[i] > dVariables_[i - 1];
+            }
+            if (!bIsSorted)
+            {
+                std::vector<std::pair<double, double> > dPillars(iNValues_);
+                for (std::size_t i = 0 ; i < iNValues_ ; ++i)
                 {
-                    //The lower boundary condition is set either to be "natural"
-                    dSecondDerivativeValues_[1] = u[1] = 0.0;
-                }
-                else 
-                { 
-                    //or else to have a specified first derivative.
-                    dSecondDerivativeValues_[1] = -0.5;
-                    u[1]=(3.0/(dVariables_[2]-dVariables_[1]))*((dValues_[2]-dValues_[1])/(dVariables_[2]-dVariables_[1])-yp1);
-                }
-                
-                for (i=2;i<=n-1;i++) 
-                { 
-                    //This is the decomposition loop of the tridiagonal algorithm.
-                    //y2 and u are used for temporary storage of the decomposed factors.
-                    sig=(dVariables_[i]-dVariables_[i-1])/(dVariables_[i+1]-dVariables_[i-1]);
-                    p=sig*dSecondDerivativeValues_[i-1]+2.0;
-                    dSecondDerivativeValues_[i]=(sig-1.0)/p;
-                    u[i]=(dValues_[i+1]-dValues_[i])/(dVariables_[i+1]-dVariables_[i]) - (dValues_[i]-dValues_[i-1])/(dVariables_[i]-dVariables_[i-1]);
-                    u[i]=(6.0*u[i]/(dVariables_[i+1]-dVariables_[i-1])-sig*u[i-1])/p;
+                    dPillars[i] = std::make_pair(dVariables_[i], dValues_[i]);
                 }
-                
-                if (ypn > 0.99e30) 
+                std::sort(dPillars.begin(), dPillars.end());
+                for (std::size_t i = 0 ; i < iNValues_ ; ++i)
                 {
-                    //The upper boundary condition is set either to be natural 
-                    qn=un=0.0;
+                    dVariables_[i] = dPillars[i].first;
+                    dValues_[i] = dPillars[i].second;
+                    Utilities::require(i == 0 || dVariables_[i] > dVariables_[i - 1], "InterExtrapolation1D : pillars have to be distinct");
                 }
-                else 
-                { 
-                    //or else to have a specified first derivative.
-                    qn=0.5;
-                    un=(3.0/(dVariables_[n]-dVariables_[n-1]))*(ypn-(dValues_[n]-dValues_[n-1])/(dVariables_[n]-dVariables_[n-1]));
-                }
-                dSecondDerivativeValues_[n]=(un-qn*u[n-1])/(qn*dSecondDerivativeValues_[n-1]+1.0);
-                //Set second derivative at edge to 0.0
-                dSecondDerivativeValues_[n] = 0.0;
-                
-                //This is the backsubstitution loop of the tridiagonal algorithm
-                for (k=n-1;k>=1;k--) 
+            }
+            if (iNValues_ > 1)
+            {
+                double dStep = (dVariables_.back() - dFirstVariable_) / (iNValues_ - 1);
+                bIsUniformGrid_ = true;
+                for (std::size_t i = 1 ; i < iNValues_ - 1 && bIsUniformGrid_ ; ++i)
                 {
-                    dSecondDerivativeValues_[k]=dSecondDerivativeValues_[k]*dSecondDerivativeValues_[k+1]+u[k]; 
+                    bIsUniformGrid_ = std::abs(dVariables_[i] - (dFirstVariable_ + i * dStep)) <= 1e-10 * dStep;
                 }
-                
-                //  Set second derivative at edge to 0
-                //dSecondDerivativeValues_[1] = 0.0;
+                dInverseStep_ = 1.0 / dStep;
+            }
+            ComputeSecondDerivatives();
+        }
 
-                //  Free u
-                u.clear();
+        void InterExtrapolation1D::ComputeSecondDerivatives()
+        {
+            dSecondDerivativeValues_.assign(iNValues_, 0.0);
+            dSplineSigmas_.clear();
+            dSplinePivots_.clear();
+            dSplineFactors_.clear();
+            dLowerSlope_ = dUpperSlope_ = 0.0;
+            if (eInterpolationType_ != SPLINE_CUBIC || iNValues_ < 2)
+            {
+                return;
             }
+
+            //  Adapted from Numerical Recipes in C (page 139) : tridiagonal system of the second derivatives of the spline
+            //  The first derivative is set to 0 at the first pillar, and the second derivative is set to 0 at the last pillar (natural spline)
+            //  Decomposition loop of the tridiagonal algorithm, kept for the solves of BumpValue and SecondDerivativeResponse
+            const std::vector<double> & x = dVariables_;
+            std::size_t n = iNValues_;
+            dSplineSigmas_.assign(n, 0.0);
+            dSplinePivots_.assign(n, 1.0);
+            dSplineFactors_.assign(n, 0.0);
+            dSplineFactors_[0] = -0.5;
+            for (std::size_t i = 1 ; i < n - 1 ; ++i)
+            {
+                double sig = (x[i] - x[i - 1]) / (x[i + 1] - x[i - 1]);
+                double p = sig * dSplineFactors_[i - 1] + 2.0;
+                dSplineSigmas_[i] = sig;
+                dSplinePivots_[i] = p;
+                dSplineFactors_[i] = (sig - 1.0) / p;
+            }
+
+            SolveSecondDerivatives(&dValues_[0], 0.0, &dSecondDerivativeValues_[0]);
+            ComputeSlopes();
         }
-        
-        InterExtrapolation1D::~InterExtrapolation1D()
-        {}
-        
+
+        void InterExtrapolation1D::SolveSecondDerivatives(const double * y, double dFirstSlope, double * y2) const
+        {
+            //  Forward substitution (y2 is used for the temporary storage of u) then backsubstitution loop of the tridiagonal algorithm
+            const std::vector<double> & x = dVariables_;
+            std::size_t n = iNValues_;
+            y2[0] = (3.0 / (x[1] - x[0])) * ((y[1] - y[0]) / (x[1] - x[0]) - dFirstSlope);
+            for (std::size_t i = 1 ; i < n - 1 ; ++i)
+            {
+                double u = (y[i + 1] - y[i]) / (x[i + 1] - x[i]) - (y[i] - y[i - 1]) / (x[i] - x[i - 1]);
+                y2[i] = (6.0 * u / (x[i + 1] - x[i - 1]) - dSplineSigmas_[i] * y2[i - 1]) / dSplinePivots_[i];
+            }
+            y2[n - 1] = 0.0;
+            for (std::size_t k = n - 1 ; k-- > 0 ; )
+            {
+                y2[k] = dSplineFactors_[k] * y2[k + 1] + y2[k];
+            }
+        }
+
+        void InterExtrapolation1D::ComputeSlopes()
+        {
+            const std::vector<double> & x = dVariables_, & y = dValues_, & y2 = dSecondDerivativeValues_;
+            std::size_t n = iNValues_;
+            double hFirst = x[1] - x[0], hLast = x[n - 1] - x[n - 2];
+            dLowerSlope_ = (y[1] - y[0]) / hFirst - hFirst * (2.0 * y2[0] + y2[1]) / 6.0;
+            dUpperSlope_ = (y[n - 1] - y[n - 2]) / hLast + hLast * (y2[n - 2] + 2.0 * y2[n - 1]) / 6.0;
+        }
+
+        void InterExtrapolation1D::BumpValue(std::size_t iPillar, double dShift)
+        {
+            Utilities::require(iPillar < iNValues_, "InterExtrapolation1D::BumpValue : the pillar is out of range");
+            dValues_[iPillar] += dShift;
+            if (dSplineFactors_.empty())
+            {
+                return;
+            }
+            std::vector<double> dResponse(iNValues_);
+            SecondDerivativeResponse(iPillar, Utilities::ArrayView<double>(&dResponse[0], iNValues_));
+            for (std::size_t i = 0 ; i < iNValues_ ; ++i)
+            {
+                dSecondDerivativeValues_[i] += dShift * dResponse[i];
+            }
+            ComputeSlopes();
+        }
+
+        void InterExtrapolation1D::SecondDerivativeResponse(std::size_t iPillar, Utilities::ArrayView<double> dResponse) const
+        {
+            Utilities::require(iPillar < iNValues_, "InterExtrapolation1D::SecondDerivativeResponse : the pillar is out of range");
+            Utilities::require(dResponse.size() == iNValues_, "InterExtrapolation1D::SecondDerivativeResponse : the response is not of the number of pillars");
+            if (dSplineFactors_.empty())
+            {
+                std::fill(dResponse.begin(), dResponse.end(), 0.0);
+                return;
+            }
+            //  Solve of the system for the unit bump of the pillar (the first derivative at the first pillar does not move)
+            std::vector<double> dBump(iNValues_, 0.0);
+            dBump[iPillar] = 1.0;
+            SolveSecondDerivatives(&dBump[0], 0.0, dResponse.data());
+        }
+
+        int InterExtrapolation1D::Locate(double dVariable) const
+        {
+            int iNValues = static_cast<int>(iNValues_);
+            if (!bIsUniformGrid_)
+            {
+                return static_cast<int>(std::upper_bound(dVariables_.begin(), dVariables_.end(), dVariable) - dVariables_.begin()) - 1;
+            }
+            if (dVariable < dFirstVariable_)
+            {
+                return -1;
+            }
+            double dPosition = (dVariable - dFirstVariable_) * dInverseStep_;
+            int i = dPosition < iNValues - 1 ? static_cast<int>(dPosition) : iNValues - 1;
+            //  The rounding of the position is corrected on the pillars themselves
+            if (dVariable < dVariables_[i])
+            {
+                --i;
+            }
+            else if (i + 1 < iNValues && dVariable >= dVariables_[i + 1])
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        int InterExtrapolation1D::Locate(double dVariable, int iHint) const
+        {
+            //  Merge-walk : for increasing points, the interval is the one of the hint or one of the next ones
+            int iNValues = static_cast<int>(iNValues_);
+            int i = std::min(std::max(iHint, -1), iNValues - 1);
+            if (i < 0 || dVariables_[i] <= dVariable)
+            {
+                for (int iStep = 0 ; iStep < INTERPOLATIONMAXWALK ; ++iStep, ++i)
+                {
+                    if (i + 1 == iNValues || dVariable < dVariables_[i + 1])
+                    {
+                        return i;
+                    }
+                }
+            }
+            return Locate(dVariable);
+        }
+
         double InterExtrapolation1D::Interp1D(double dVariable) const
         {
-			if (eInterpolationType_ == LIN) {
-				// BEGINNING OF LINEAR CASE
-				double dResult = 0.0 ;
-				std::size_t iUpperIndex = 0, iLowerIndex = 0;
-				bool bUpper = false, bLower = false ;
-				
-				for (std::size_t iRunningIndex = 0; iRunningIndex < dVariables_.size(); ++iRunningIndex) {
-					double dRunningVariable = dVariables_[iRunningIndex] ;
-					if (dRunningVariable > dVariable) {
-						if (bUpper) {
-							if (dRunningVariable < dVariables_[iUpperIndex]) {
-								iUpperIndex = iRunningIndex ;
-							}
-						}
-						else {
-							bUpper = true ;
-							iUpperIndex = iRunningIndex ;
-						}
-						if (!bLower && dRunningVariable > dVariables_[iLowerIndex]) {
-							iLowerIndex = iRunningIndex ;
-						}
-					}
-					if (dRunningVariable <= dVariable) {
-						if (bLower) {
-							if (dRunningVariable > dVariables_[iLowerIndex]) {
-								iLowerIndex = iRunningIndex ;
-							}
-						}
-						else {
-							bLower = true ;
-							iLowerIndex = iRunningIndex ;
-						}
-						if (!bUpper && dRunningVariable <= dVariables_[iUpperIndex]) {
-							iUpperIndex = iRunningIndex ;
-						}
-					}
-				}
-				
-				if (dVariables_[iUpperIndex] == dVariables_[iLowerIndex]) {
-					return dValues_[iUpperIndex] ;
-				}
-				else {
-					dResult = dValues_[iLowerIndex] + (dValues_[iUpperIndex] - dValues_[iLowerIndex]) * (dVariable - dVariables_[iLowerIndex]) / (dVariables_[iUpperIndex] - dVariables_[iLowerIndex]) ;
-					return dResult ;
-				}
-			}
-			// END OF LINEAR CASE
-			else {
-				
-                double dResult = 0.0;
-                int iValue, iValue1, iValue2;
-                
-                // if the variable hasn't been found, iValue=exc value
-                if (!IsFound(dVariables_, dVariable, (std::size_t*)&iValue))
+            return Evaluate(dVariable, Locate(dVariable));
+        }
+
+        double InterExtrapolation1D::Interp1D(double dVariable, int & iHint) const
+        {
+            iHint = Locate(dVariable, iHint);
+            return Evaluate(dVariable, iHint);
+        }
+
+        void InterExtrapolation1D::Interp1D(Utilities::ArrayView<const double> dVariables, Utilities::ArrayView<double> dResults) const
+        {
+            Utilities::require(dVariables.size() == dResults.size(), "Interp1D : input and output sizes are not the same");
+            Utilities::require(iNValues_ > 0, "Interp1D : no pillar");
+            int iIndices[INTERPOLATIONBATCHSIZE];
+            int iHint = -1, iLastInterval = static_cast<int>(iNValues_) - 2;
+            const double * X = &dVariables_[0];
+            for (std::size_t iStart = 0 ; iStart < dVariables.size() ; iStart += INTERPOLATIONBATCHSIZE)
+            {
+                std::size_t iN = std::min<std::size_t>(INTERPOLATIONBATCHSIZE, dVariables.size() - iStart);
+                const double * x = dVariables.data() + iStart;
+                for (std::size_t j = 0 ; j < iN ; ++j)
+                {
+                    //  Sorted points inside the pillars : interval of the previous point or the next one, the walk of Locate otherwise
+                    if (iHint >= 0 && iHint <= iLastInterval && X[iHint] <= x[j])
+                    {
+                        if (x[j] < X[iHint + 1])
+                        {
+                            iIndices[j] = iHint;
+                            continue;
+                        }
+                        if (iHint < iLastInterval && x[j] < X[iHint + 2])
+                        {
+                            iIndices[j] = ++iHint;
+                            continue;
+                        }
+                    }
+                    iHint = iIndices[j] = Locate(x[j], iHint);
+                }
+                Evaluate(x, iIndices, dResults.data() + iStart, iN);
+            }
+        }
+
+        void InterExtrapolation1D::Evaluate(const double * dVariables, const int * iIndices, double * dResults, std::size_t iN) const
+        {
+            std::size_t iDone = 0;
+#ifdef SEMINAIRE_X86_SIMD
+            int iLast = static_cast<int>(iNValues_) - 1;
+            Utilities::SIMDLevel eSIMDLevel = iLast > 0 ? Utilities::GetSIMDLevel() : Utilities::SIMD_SCALAR;
+            const double * X = &dVariables_[0], * V = &dValues_[0];
+            switch (eInterpolationType_)
+            {
+                case LIN:
+                    if (eSIMDLevel == Utilities::SIMD_AVX512)
+                        iDone = LinearAVX512(dVariables, iIndices, dResults, iN, X, V, iLast);
+                    else if (eSIMDLevel == Utilities::SIMD_AVX2)
+                        iDone = LinearAVX2(dVariables, iIndices, dResults, iN, X, V, iLast);
+                    break;
+                case SPLINE_CUBIC:
+                    if (eSIMDLevel == Utilities::SIMD_AVX512)
+                        iDone = SplineAVX512(dVariables, iIndices, dResults, iN, X, V, &dSecondDerivativeValues_[0], iLast, dLowerSlope_, dUpperSlope_);
+                    else if (eSIMDLevel == Utilities::SIMD_AVX2)
+                        iDone = SplineAVX2(dVariables, iIndices, dResults, iN, X, V, &dSecondDerivativeValues_[0], iLast, dLowerSlope_, dUpperSlope_);
+                    break;
+                case RIGHT_CONTINUOUS:
+                case LEFT_CONTINUOUS:
                 {
-                    iValue = Utilities::FindInVector(dVariables_, dVariable);
+                    int iShift = eInterpolationType_ == RIGHT_CONTINUOUS ? 1 : 0;
+                    if (eSIMDLevel == Utilities::SIMD_AVX512)
+                        iDone = StepAVX512(iIndices, dResults, iN, V, iLast, iShift);
+                    else if (eSIMDLevel == Utilities::SIMD_AVX2)
+                        iDone = StepAVX2(iIndices, dResults, iN, V, iLast, iShift);
+                    break;
                 }
-                //iValue = 1;
-                iValue1 = iValue;
-                iValue2 = iValue + 1;
-                
-                if (iValue == -1)
+                default:
+                    break;
+            }
+#endif
+            //  Remaining points (and everything when no SIMD is available, and NEAR)
+            for (std::size_t j = iDone ; j < iN ; ++j)
+            {
+                dResults[j] = Evaluate(dVariables[j], iIndices[j]);
+            }
+        }
+
+        double InterExtrapolation1D::Evaluate(double dVariable, int i) const
+        {
+            int iLast = static_cast<int>(iNValues_) - 1;
+            switch (eInterpolationType_)
+            {
+                case LIN:
                 {
-                    // Extrapolation
-                    if (dVariable > dVariables_[iNValues_ - 1])
+                    if (iLast == 0)
                     {
-                        iValue1 = static_cast<int>(iNValues_ - 2);
-                        iValue2 = static_cast<int>(iNValues_ - 1);
+                        return dValues_[0];
                     }
-                    else
+                    if (i < 0 || i == iLast)
                     {
-                        // dVariable < dVariables[0]
-                        iValue1 = 0;
-                        iValue2 = 1;
+                        //  Outside the pillars : on the line through the first and the last pillars
+                        return dValues_[iLast] + (dValues_[0] - dValues_[iLast]) * (dVariable - dVariables_[iLast]) / (dVariables_[0] - dVariables_[iLast]);
                     }
+                    return dValues_[i] + (dValues_[i + 1] - dValues_[i]) * (dVariable - dVariables_[i]) / (dVariables_[i + 1] - dVariables_[i]);
                 }
-                
-                if (eInterpolationType_ != LIN && eInterpolationType_ != SPLINE_CUBIC)
+                case NEAR:
                 {
-                    //  Adapts the iValue for RIGHT_CONTINUOUS and LEFT_CONTINUOUS interpolation types
-                    if (iValue == -1)
+                    if (i < 0 || i == iLast)
                     {
-                        if (iValue2 == static_cast<int>(iNValues_ - 1))
-                        {
-                            iValue2++;
-                            iValue1++;
-                        }
-                        else
-                        {
-                            iValue2--;
-                            iValue1--;
-                        }
+                        return dValues_[i < 0 ? 0 : iLast];
                     }
+                    return std::abs(dVariable - dVariables_[i]) < std::abs(dVariable - dVariables_[i + 1]) ? dValues_[i] : dValues_[i + 1];
                 }
-                
-                switch (eInterpolationType_)
+                case RIGHT_CONTINUOUS:
+                {
+                    return dValues_[std::min(i + 1, iLast)];
+                }
+                case LEFT_CONTINUOUS:
+                {
+                    return dValues_[std::max(i, 0)];
+                }
+                default:
+                    break;
+            }
+
+            //  SPLINE_CUBIC : outside the pillars, linear extrapolation with the slopes of the spline at the first and the last pillars
+            if (iLast == 0)
+            {
+                return dValues_[0];
+            }
+            if (i < 0)
+            {
+                return dValues_[0] + (dVariable - dVariables_[0]) * dLowerSlope_;
+            }
+            if (i == iLast)
+            {
+                return dValues_[iLast] + (dVariable - dVariables_[iLast]) * dUpperSlope_;
+            }
+            //  Cubic spline polynomial on the interval [i, i + 1] (the variables must be distinct)
+            double h = dVariables_[i + 1] - dVariables_[i];
+            double a = (dVariables_[i + 1] - dVariable) / h, b = (dVariable - dVariables_[i]) / h;
+            return a * dValues_[i] + b * dValues_[i + 1] + ((a * a * a - a) * dSecondDerivativeValues_[i] + (b * b * b - b) * dSecondDerivativeValues_[i + 1]) * (h * h) / 6.0;
+        }
+
+        namespace {
+
+            //  Two nodes iLow and iHigh of a dimension around x, with the weights of their values (dWeights) and of their second derivatives
+            //  (dCurvatures, SPLINE_CUBIC) : the 1D interpolation of InterExtrapolation1D written as a linear combination of the nodes
+            void AxisWeights(const InterExtrapolation1D & sAxis, InterExtrapolationType eInterpolationType, double x, int & iHint, int & iLow, int & iHigh, double * dWeights, double * dCurvatures)
+            {
+                const std::vector<double> & X = sAxis.GetVariables();
+                int iLast = static_cast<int>(X.size()) - 1;
+                int i = iHint = sAxis.Locate(x, iHint);
+                dWeights[0] = 1.0;
+                dWeights[1] = dCurvatures[0] = dCurvatures[1] = 0.0;
+                if (iLast == 0)
+                {
+                    iLow = iHigh = 0;
+                    return;
+                }
+                switch (eInterpolationType)
                 {
                     case LIN:
                     {
-                        dResult = dValues_[iValue1] + (dValues_[iValue2] - dValues_[iValue1]) / (dVariables_[iValue2] - dVariables_[iValue1]) * (dVariable - dVariables_[iValue1]);
-                        break;
+                        //  Outside the pillars : on the line through the last and the first pillars
+                        bool bOutside = i < 0 || i == iLast;
+                        iLow = bOutside ? iLast : i;
+                        iHigh = bOutside ? 0 : i + 1;
+                        double t = (x - X[iLow]) / (X[iHigh] - X[iLow]);
+                        dWeights[0] = 1.0 - t;
+                        dWeights[1] = t;
+                        return;
                     }
                     case NEAR:
                     {
-                        dResult = iValue2 == (int)iNValues_ || iValue2 == 0 ? dValues_[iValue2] : std::abs(dVariable - dVariables_[iValue1]) < std::abs(dVariable - dVariables_[iValue2]) ? dValues_[iValue1] : dValues_[iValue2];
-                        break;
+                        iLow = iHigh = i < 0 ? 0 : (i == iLast ? iLast : (std::abs(x - X[i]) < std::abs(x - X[i + 1]) ? i : i + 1));
+                        return;
                     }
                     case RIGHT_CONTINUOUS:
                     {
-                        dResult = iValue2 == (int)iNValues_? dValues_[iValue2 - 1] : dValues_[iValue2];
-                        break;
+                        iLow = iHigh = std::min(i + 1, iLast);
+                        return;
                     }
                     case LEFT_CONTINUOUS:
                     {
-                        dResult = iValue1 == -1 ? dValues_[0] : dValues_[iValue1];
+                        iLow = iHigh = std::max(i, 0);
+                        return;
+                    }
+                    default:
                         break;
+                }
+
+                //  SPLINE_CUBIC : cubic on the interval, linear extrapolation with the slopes of the spline at the first and the last pillars
+                iLow = std::min(std::max(i, 0), iLast - 1);
+                iHigh = iLow + 1;
+                double h = X[iHigh] - X[iLow];
+                if (i < 0)
+                {
+                    double dx = x - X[0];
+                    dWeights[0] = 1.0 - dx / h;
+                    dWeights[1] = dx / h;
+                    dCurvatures[0] = -dx * h / 3.0;
+                    dCurvatures[1] = -dx * h / 6.0;
+                }
+                else if (i == iLast)
+                {
+                    double dx = x - X[iLast];
+                    dWeights[0] = -dx / h;
+                    dWeights[1] = 1.0 + dx / h;
+                    dCurvatures[0] = dx * h / 6.0;
+                    dCurvatures[1] = dx * h / 3.0;
+                }
+                else
+                {
+                    double a = (X[iHigh] - x) / h, b = (x - X[iLow]) / h;
+                    dWeights[0] = a;
+                    dWeights[1] = b;
+                    dCurvatures[0] = (a * a * a - a) * (h * h) / 6.0;
+                    dCurvatures[1] = (b * b * b - b) * (h * h) / 6.0;
+                }
+            }
+
+            //  Sum of dWeights[iCorner * iNCoefficients + k] * C[iOffsets[iCorner] + k] : four partial sums (index modulo 4) added at the end,
+            //  in the same order as the AVX2 kernel
+            double Contract(const double * dWeights, const int * iOffsets, const double * C, std::size_t iNCorners, std::size_t iNCoefficients)
+            {
+                double dSums[4] = {0.0, 0.0, 0.0, 0.0};
+                std::size_t n = 0;
+                for (std::size_t iCorner = 0 ; iCorner < iNCorners ; ++iCorner)
+                {
+                    const double * dCoefficients = C + iOffsets[iCorner];
+                    for (std::size_t k = 0 ; k < iNCoefficients ; ++k, ++n)
+                    {
+                        dSums[n & 3] += dWeights[n] * dCoefficients[k];
                     }
-                    case SPLINE_CUBIC:
+                }
+                return (dSums[0] + dSums[1]) + (dSums[2] + dSums[3]);
+            }
+
+#ifdef SEMINAIRE_X86_SIMD
+            //  Tensor cubic : the coefficients of a corner are contiguous (iNCoefficients multiple of 4)
+            //  Multilinear : the values of four corners are gathered (iNCoefficients = 1, iNCorners multiple of 4)
+            SEMINAIRE_TARGET("avx2")
+            double ContractAVX2(const double * dWeights, const int * iOffsets, const double * C, std::size_t iNCorners, std::size_t iNCoefficients)
+            {
+                __m256d dSums = _mm256_setzero_pd();
+                if (iNCoefficients == 1)
+                {
+                    for (std::size_t iCorner = 0 ; iCorner < iNCorners ; iCorner += 4)
                     {
-                        //Given the arrays xa[1..n] and ya[1..n], which tabulate a function (with the xai’s in order),
-                        //and given the array y2a[1..n], which is the output from spline above, and given a value of
-                        //x, this routine returns a cubic-spline interpolated value y.
-                        //{
-                        int klo,khi,k;
-                        float h,b,a;
-                        klo=1;
-                        //We will find the right place in the table by means of
-                        //bisection. This is optimal if sequential calls to this
-                        //    routine are at random values of x. If sequential calls
-                        //    are in order, and closely spaced, one would do better
-                        //        to store previous values of klo and khi and test if
-                        //            they remain appropriate on the next call.
-                        khi=static_cast<int>(dValues_.size());
-                        while (khi-klo > 1) 
-                        {
-                            k=(khi+klo) >> 1;
-                            if (dVariables_[k] > dVariable)
-                                khi=k;
-                            else 
-                                klo=k;
-                        }
-                        //klo and khi now bracket the input value of x.
-                        //khi = iValue2
-                        //  klo = iValue1
-                        h=dVariables_[khi]-dVariables_[klo];
-                        //  The variables must be distinct
-                        
-                        a=(dVariables_[khi]-dVariable)/h;
-                        b=(dVariable-dVariables_[klo])/h; 
-                        //Cubic spline polynomial is now evaluated.
-                        if (dVariable < dVariables_.back())
-                        {
-                            dResult=a*dValues_[klo]+b*dValues_[khi]+((a*a*a-a)*dSecondDerivativeValues_[klo]+(b*b*b-b)*dSecondDerivativeValues_[khi])*(h*h)/6.0;
-                        }
-                        else
+                        __m128i iCornerOffsets = _mm_loadu_si128(reinterpret_cast<const __m128i *>(iOffsets + iCorner));
+                        dSums = _mm256_add_pd(dSums, _mm256_mul_pd(_mm256_loadu_pd(dWeights + iCorner), GatherAVX2(C, iCornerOffsets)));
+                    }
+                }
+                else
+                {
+                    for (std::size_t iCorner = 0 ; iCorner < iNCorners ; ++iCorner)
+                    {
+                        const double * dCornerWeights = dWeights + iCorner * iNCoefficients, * dCoefficients = C + iOffsets[iCorner];
+                        for (std::size_t k = 0 ; k < iNCoefficients ; k += 4)
                         {
-                            std::size_t n = dVariables_.size();
-                            dResult = dValues_.back() + (dVariable - dVariables_.back()) * (-(dValues_[n - 1] - dValues_[n - 2])/(dVariables_[n - 1] - dVariables_[n - 2]) + (dSecondDerivativeValues_[n - 2]) /(6.0 * (dVariables_[n - 1] - dVariables_[n - 2])) + (dSecondDerivativeValues_[n - 1]) /(3.0 * (dVariables_[n - 1] - dVariables_[n - 2])));
+                            dSums = _mm256_add_pd(dSums, _mm256_mul_pd(_mm256_loadu_pd(dCornerWeights + k), _mm256_loadu_pd(dCoefficients + k)));
                         }
-                        break;
                     }
-                        
-                    default:
-                        break;
                 }
-                
-                
-                return dResult;
-			}
+                double dPartialSums[4];
+                _mm256_storeu_pd(dPartialSums, dSums);
+                return (dPartialSums[0] + dPartialSums[1]) + (dPartialSums[2] + dPartialSums[3]);
+            }
+#endif
         }
-        
-        InterExtrapolationnD::InterExtrapolationnD()
+
+        InterExtrapolationnD::InterExtrapolationnD() : eInterpolationType_(NEAR), iNDimensions_(0), iNValues_(0), iNCoefficients_(1)
         {}
-        
-        InterExtrapolationnD::InterExtrapolationnD(const std::map<std::size_t, std::vector<double> > & dVariables,
-                                                   const std::map<std::size_t, std::vector<double> > & dValues,
+
+        InterExtrapolationnD::InterExtrapolationnD(const std::vector<std::vector<double> > & dAxes,
+                                                   const std::vector<double> & dValues,
                                                    InterExtrapolationType eInterpolationType)
-        : dVariables_(dVariables), dValues_(dValues), eInterpolationType_(eInterpolationType)
+        : eInterpolationType_(eInterpolationType), iNDimensions_(dAxes.size()), iNValues_(dValues.size())
+        {
+            Utilities::require(iNDimensions_ > 0 && iNDimensions_ <= INTERPOLATIONNDMAXDIMENSIONS, "InterExtrapolationnD : the number of dimensions is not supported");
+            iNCoefficients_ = eInterpolationType_ == SPLINE_CUBIC ? static_cast<std::size_t>(1) << iNDimensions_ : 1;
+
+            //  Row-major grid : the last dimension varies fastest
+            std::size_t iNNodes = 1;
+            iStrides_.resize(iNDimensions_);
+            for (std::size_t d = iNDimensions_ ; d-- > 0 ; )
+            {
+                const std::vector<double> & dAxis = dAxes[d];
+                Utilities::require(!dAxis.empty(), "InterExtrapolationnD : empty dimension");
+                for (std::size_t i = 1 ; i < dAxis.size() ; ++i)
+                {
+                    Utilities::require(dAxis[i] > dAxis[i - 1], "InterExtrapolationnD : the pillars of each dimension have to be increasing");
+                }
+                iStrides_[d] = iNNodes * iNCoefficients_;
+                iNNodes *= dAxis.size();
+            }
+            Utilities::require(iNNodes == iNValues_, "InterExtrapolationnD : the number of values is not the number of nodes of the grid");
+            for (std::size_t d = 0 ; d < iNDimensions_ ; ++d)
+            {
+                sAxes_.push_back(InterExtrapolation1D(dAxes[d], dAxes[d], LIN));
+            }
+
+            dCoefficients_.assign(iNNodes * iNCoefficients_, 0.0);
+            for (std::size_t iNode = 0 ; iNode < iNNodes ; ++iNode)
+            {
+                dCoefficients_[iNode * iNCoefficients_] = dValues[iNode];
+            }
+
+            //  Second derivatives along the dimensions of each subset : the 1D spline along the lowest dimension d of the subset, applied
+            //  to the lines (along d) of the coefficients of the subset without d
+            for (std::size_t iSubset = 1 ; iSubset < iNCoefficients_ ; ++iSubset)
+            {
+                std::size_t d = 0;
+                while (!(iSubset & (static_cast<std::size_t>(1) << d)))
+                {
+                    ++d;
+                }
+                std::size_t iBase = iSubset & ~(static_cast<std::size_t>(1) << d);
+                std::size_t iNPillars = dAxes[d].size(), iNodeStride = iStrides_[d] / iNCoefficients_;
+                std::vector<double> dLine(iNPillars);
+                for (std::size_t iNode = 0 ; iNode < iNNodes ; ++iNode)
+                {
+                    //  First node of a line along d
+                    if ((iNode / iNodeStride) % iNPillars != 0)
+                    {
+                        continue;
+                    }
+                    for (std::size_t i = 0 ; i < iNPillars ; ++i)
+                    {
+                        dLine[i] = dCoefficients_[(iNode + i * iNodeStride) * iNCoefficients_ + iBase];
+                    }
+                    InterExtrapolation1D sLine(dAxes[d], dLine, SPLINE_CUBIC);
+                    const std::vector<double> & dSecondDerivatives = sLine.GetSecondDerivatives();
+                    for (std::size_t i = 0 ; i < iNPillars ; ++i)
+                    {
+                        dCoefficients_[(iNode + i * iNodeStride) * iNCoefficients_ + iSubset] = dSecondDerivatives[i];
+                    }
+                }
+            }
+        }
+
+        InterExtrapolationnD::~InterExtrapolationnD()
         {}
-        
-        std::map<std::size_t, double> InterExtrapolationnD::InterpnD(const std::map<size_t, double> &dValue)
+
+        double InterExtrapolationnD::InterpnD(const std::vector<double> & dPoint) const
         {
-            std::map<std::size_t, double> Result;
-            std::map<std::size_t, std::vector<double> >::iterator iter;
-            for (iter = dVariables_.begin() ; iter != dVariables_.end() ; ++iter)
+            return InterpnD(Utilities::ArrayView<const double>(dPoint.empty() ? 0 : &dPoint[0], dPoint.size()));
+        }
+
+        double InterExtrapolationnD::InterpnD(Utilities::ArrayView<const double> dPoint) const
+        {
+            Utilities::require(dPoint.size() == iNDimensions_, "InterpnD : the point is not of the dimension of the grid");
+            int iHints[INTERPOLATIONNDMAXDIMENSIONS];
+            std::fill(iHints, iHints + INTERPOLATIONNDMAXDIMENSIONS, -1);
+            return Evaluate(dPoint.data(), iHints);
+        }
+
+        void InterExtrapolationnD::InterpnD(Utilities::MatrixView<const double> dPoints, Utilities::ArrayView<double> dResults) const
+        {
+            Utilities::require(dPoints.columns() == iNDimensions_, "InterpnD : the points are not of the dimension of the grid");
+            Utilities::require(dPoints.rows() == dResults.size(), "InterpnD : input and output sizes are not the same");
+            int iHints[INTERPOLATIONNDMAXDIMENSIONS];
+            std::fill(iHints, iHints + INTERPOLATIONNDMAXDIMENSIONS, -1);
+            for (std::size_t iPoint = 0 ; iPoint < dResults.size() ; ++iPoint)
+            {
+                dResults[iPoint] = Evaluate(dPoints[iPoint].data(), iHints);
+            }
+        }
+
+        double InterExtrapolationnD::Evaluate(const double * dPoint, int * iHints) const
+        {
+            //  Tensor product of the weights of the dimensions : corner c (bit d : high node of the dimension d) and coefficient s
+            //  (bit d : second derivative along the dimension d) have the weight dWeights[c * iNTerms + s], built one dimension at a time
+            double dWeights[2][INTERPOLATIONNDMAXCORNERS * INTERPOLATIONNDMAXCORNERS];
+            int iOffsets[2][INTERPOLATIONNDMAXCORNERS];
+            bool bIsSpline = eInterpolationType_ == SPLINE_CUBIC;
+            std::size_t iNCorners = 1, iNTerms = 1;
+            int iCurrent = 0;
+            dWeights[0][0] = 1.0;
+            iOffsets[0][0] = 0;
+            for (std::size_t d = 0 ; d < iNDimensions_ ; ++d)
+            {
+                int iNodes[2];
+                double dAxisWeights[2], dAxisCurvatures[2];
+                AxisWeights(sAxes_[d], eInterpolationType_, dPoint[d], iHints[d], iNodes[0], iNodes[1], dAxisWeights, dAxisCurvatures);
+
+                const double * dOldWeights = dWeights[iCurrent];
+                const int * iOldOffsets = iOffsets[iCurrent];
+                double * dNewWeights = dWeights[1 - iCurrent];
+                int * iNewOffsets = iOffsets[1 - iCurrent];
+                std::size_t iNNewTerms = bIsSpline ? 2 * iNTerms : iNTerms;
+                for (std::size_t iNode = 0 ; iNode < 2 ; ++iNode)
+                {
+                    for (std::size_t iCorner = 0 ; iCorner < iNCorners ; ++iCorner)
+                    {
+                        std::size_t iNewCorner = iCorner + iNode * iNCorners;
+                        iNewOffsets[iNewCorner] = iOldOffsets[iCorner] + static_cast<int>(iNodes[iNode] * iStrides_[d]);
+                        for (std::size_t s = 0 ; s < iNTerms ; ++s)
+                        {
+                            double dWeight = dOldWeights[iCorner * iNTerms + s];
+                            dNewWeights[iNewCorner * iNNewTerms + s] = dWeight * dAxisWeights[iNode];
+                            if (bIsSpline)
+                            {
+                                dNewWeights[iNewCorner * iNNewTerms + iNTerms + s] = dWeight * dAxisCurvatures[iNode];
+                            }
+                        }
+                    }
+                }
+                iNCorners *= 2;
+                iNTerms = iNNewTerms;
+                iCurrent = 1 - iCurrent;
+            }
+
+#ifdef SEMINAIRE_X86_SIMD
+            if (Utilities::GetSIMDLevel() != Utilities::SIMD_SCALAR && (iNTerms % 4 == 0 || (iNTerms == 1 && iNCorners % 4 == 0)))
+            {
+                return ContractAVX2(dWeights[iCurrent], iOffsets[iCurrent], &dCoefficients_[0], iNCorners, iNTerms);
+            }
+#endif
+            return Contract(dWeights[iCurrent], iOffsets[iCurrent], &dCoefficients_[0], iNCorners, iNTerms);
+        }
+
+        InterExtrapolation1DSensitivities::InterExtrapolation1DSensitivities(const InterExtrapolation1D & sInterExtrapolation) :
+        sInterExtrapolation_(sInterExtrapolation),
+        eInterpolationType_(sInterExtrapolation.GetInterpolationType()),
+        iNValues_(sInterExtrapolation.GetVariables().size())
+        {
+            Utilities::require(iNValues_ > 0, "InterExtrapolation1DSensitivities : no pillar");
+            if (eInterpolationType_ != SPLINE_CUBIC)
+            {
+                return;
+            }
+            //  Column k of the matrix : response of the second derivatives to the value of the pillar k
+            dSecondDerivativeSensitivities_.resize(iNValues_ * iNValues_);
+            std::vector<double> dResponse(iNValues_);
+            for (std::size_t k = 0 ; k < iNValues_ ; ++k)
+            {
+                sInterExtrapolation_.SecondDerivativeResponse(k, Utilities::ArrayView<double>(&dResponse[0], iNValues_));
+                for (std::size_t i = 0 ; i < iNValues_ ; ++i)
+                {
+                    dSecondDerivativeSensitivities_[i * iNValues_ + k] = dResponse[i];
+                }
+            }
+        }
+
+        InterExtrapolation1DSensitivities::~InterExtrapolation1DSensitivities()
+        {}
+
+        void InterExtrapolation1DSensitivities::Sensitivities(double dVariable, Utilities::ArrayView<double> dSensitivities) const
+        {
+            int iHint = -1;
+            Sensitivities(dVariable, iHint, dSensitivities);
+        }
+
+        void InterExtrapolation1DSensitivities::Sensitivities(double dVariable, int & iHint, Utilities::ArrayView<double> dSensitivities) const
+        {
+            Utilities::require(dSensitivities.size() == iNValues_, "InterExtrapolation1DSensitivities : the sensitivities are not of the number of pillars");
+            //  Interp1D(dVariable) = w0 * y[iLow] + w1 * y[iHigh] + c0 * y2[iLow] + c1 * y2[iHigh] (as in InterExtrapolationnD)
+            int iLow = 0, iHigh = 0;
+            double dWeights[2], dCurvatures[2];
+            AxisWeights(sInterExtrapolation_, eInterpolationType_, dVariable, iHint, iLow, iHigh, dWeights, dCurvatures);
+            std::fill(dSensitivities.begin(), dSensitivities.end(), 0.0);
+            dSensitivities[iLow] += dWeights[0];
+            dSensitivities[iHigh] += dWeights[1];
+            if (dSecondDerivativeSensitivities_.empty() || iLow == iHigh)
+            {
+                return;
+            }
+            const double * dLowResponses = &dSecondDerivativeSensitivities_[iLow * iNValues_], * dHighResponses = &dSecondDerivativeSensitivities_[iHigh * iNValues_];
+            for (std::size_t k = 0 ; k < iNValues_ ; ++k)
             {
-                InterExtrapolation1D sInterp1D(iter->second, dVariables_.find(iter->first)->second, eInterpolationType_);
-                Result[iter->first] = sInterp1D.Interp1D(dValue.find(iter->first)->second);
+                dSensitivities[k] += dCurvatures[0] * dLowResponses[k] + dCurvatures[1] * dHighResponses[k];
             }
-            return Result;
         }
 
     }
-}
\ No newline at end of file
+}
@@ -11,6 +11,10 @@
 
 #include <vector>
 #include <map>
+#include "ArrayView.h"
+
+//  Maximum number of dimensions of an InterExtrapolationnD (a tensor cubic point reads 4^D coefficients)
+#define INTERPOLATIONNDMAXDIMENSIONS 5
 
 namespace Utilities
 {
@@ -33,9 +37,33 @@ namespace Utilities
             std::vector<double> dValues_;
             std::size_t iNValues_;
             
+            //  To call whenever the pillars or the values are changed : sorts the pillars (with their values) if needed, detects equally 
+            //  spaced pillars and computes the second derivatives of the spline cubic interpolation
+            void UpdateGrid();
+            
         private:
             //  Vector of second derivative values used for spline cubic interpolation
             std::vector<double> dSecondDerivativeValues_;
+            //  Slopes of the spline at the first and the last pillars (linear extrapolation outside the pillars)
+            double dLowerSlope_, dUpperSlope_;
+            
+            //  Equally spaced pillars : the interval of a point is computed in O(1) from dFirstVariable_ and dInverseStep_
+            bool bIsUniformGrid_;
+            double dFirstVariable_, dInverseStep_;
+            
+            //  Interpolation of dVariable in the interval iIndex found by Locate
+            double Evaluate(double dVariable, int iIndex) const;
+            //  Interpolation of iN points in the intervals iIndices found by Locate (SIMD kernels when available)
+            void Evaluate(const double * dVariables, const int * iIndices, double * dResults, std::size_t iN) const;
+            
+            //  Factorization of the tridiagonal system of the spline, which only depends on the pillars : sigmas, pivots and decomposed 
+            //  factors of the Numerical Recipes algorithm
+            std::vector<double> dSplineSigmas_, dSplinePivots_, dSplineFactors_;
+            
+            void ComputeSecondDerivatives();
+            //  Second derivatives y2 of the spline of the values y (first derivative dFirstSlope at the first pillar) with the factorization
+            void SolveSecondDerivatives(const double * y, double dFirstSlope, double * y2) const;
+            void ComputeSlopes();
             
         public:
             InterExtrapolation1D();
@@ -45,24 +73,133 @@ namespace Utilities
             virtual ~InterExtrapolation1D();
             
             double Interp1D(double dValue) const;
+            //  Same interpolation starting the search from the interval of the previous point (iHint, updated) : O(1) for monotone 
+            //  sequences of points, iHint = -1 to start
+            double Interp1D(double dValue, int & iHint) const;
+            //  Batched interpolation : dResults[i] = Interp1D(dVariables[i]) (dResults may be dVariables)
+            //  The points are located by a merge-walk along the pillars (O(1) per point when they are sorted), and the LIN, SPLINE_CUBIC 
+            //  and step interpolations are evaluated with AVX2 / AVX-512 kernels when the CPU supports them (same values as Interp1D)
+            void Interp1D(Utilities::ArrayView<const double> dVariables, Utilities::ArrayView<double> dResults) const;
+            
+            //  Adds dShift to the value of the pillar iPillar : the second derivatives of the spline are updated with the response of the 
+            //  spline system to the bump (O(n), the pillars are neither sorted nor factorized again)
+            void BumpValue(std::size_t iPillar, double dShift);
+            //  dResponse[i] = derivative of the second derivative of the spline at the pillar i with respect to the value of the pillar iPillar 
+            //  (the second derivatives are linear in the values, 0 if the interpolation is not SPLINE_CUBIC)
+            void SecondDerivativeResponse(std::size_t iPillar, Utilities::ArrayView<double> dResponse) const;
+            
+            //  Index of the last pillar lower or equal to dVariable (-1 if dVariable is below the first pillar) : O(1) if the pillars
+            //  are equally spaced, binary search otherwise
+            int Locate(double dVariable) const;
+            //  Same index walking forward from the interval iHint (a few pillars at most), the search above otherwise
+            int Locate(double dVariable, int iHint) const;
+            
+            bool IsUniformGrid() const
+            {
+                return bIsUniformGrid_;
+            }
+            
+            //  Pillars and values of the interpolator (no copy)
+            const std::vector<double> & GetVariables() const
+            {
+                return dVariables_;
+            }
+            
+            const std::vector<double> & GetValues() const
+            {
+                return dValues_;
+            }
+            
+            //  Second derivatives of the spline at the pillars (SPLINE_CUBIC only)
+            const std::vector<double> & GetSecondDerivatives() const
+            {
+                return dSecondDerivativeValues_;
+            }
+            
+            InterExtrapolationType GetInterpolationType() const
+            {
+                return eInterpolationType_;
+            }
         };
         
-        struct InterExtrapolationnD
+        //  Derivatives of the interpolated values with respect to the values of the pillars (bucketed sensitivities)
+        //  The interpolation is linear in the values with weights which only depend on the pillars : the responses of the spline to each 
+        //  pillar are computed once (about the cost of one more build of the curve) and stay valid when the values are bumped, so that the 
+        //  sensitivities of a point to all the pillars are read in O(1) per pillar
+        class InterExtrapolation1DSensitivities
         {
-        protected:
+        public:
+            explicit InterExtrapolation1DSensitivities(const InterExtrapolation1D & sInterExtrapolation);
+            virtual ~InterExtrapolation1DSensitivities();
+            
+            //  dSensitivities[k] = derivative of Interp1D(dVariable) with respect to the value of the pillar k
+            void Sensitivities(double dVariable, Utilities::ArrayView<double> dSensitivities) const;
+            //  Same sensitivities searching the interval from the one of the previous point (iHint, updated, -1 to start)
+            void Sensitivities(double dVariable, int & iHint, Utilities::ArrayView<double> dSensitivities) const;
+            
+            //  Pillar-sensitivity matrix of the spline : element [i * n + k] is the derivative of the second derivative at the pillar i 
+            //  with respect to the value of the pillar k (empty if the interpolation is not SPLINE_CUBIC)
+            const std::vector<double> & GetSecondDerivativeSensitivities() const
+            {
+                return dSecondDerivativeSensitivities_;
+            }
+            
+        private:
+            //  Copy of the interpolator (used to locate the points, its values are not used)
+            InterExtrapolation1D sInterExtrapolation_;
             InterExtrapolationType eInterpolationType_;
-            std::size_t iNDimensions_;
             std::size_t iNValues_;
-            std::map<std::size_t, std::vector<double> > dVariables_;
-            std::map<std::size_t, std::vector<double> > dValues_;
-            
+            std::vector<double> dSecondDerivativeSensitivities_;
+        };
+        
+        //  Interpolation on a grid of dimension D (tensor product of the 1D interpolations)
+        //  The values of the grid are stored in one contiguous row-major array (the last dimension varies fastest), with for SPLINE_CUBIC 
+        //  the 2^D - 1 cross second derivatives of each node (the 1D spline second derivatives applied along each subset of dimensions), 
+        //  so that a point is interpolated from the 2^D nodes around it (multilinear) or from their 4^D coefficients (tensor cubic)
+        //  Outside the grid, each dimension is extrapolated as in InterExtrapolation1D
+        class InterExtrapolationnD
+        {
         public:
             InterExtrapolationnD();
-            InterExtrapolationnD(const std::map<std::size_t, std::vector<double> > & dVariables,
-                                 const std::map<std::size_t, std::vector<double> > & dValues,
+            //  dAxes[d] : increasing pillars of the dimension d, dValues : values on the grid (the last dimension varies fastest)
+            InterExtrapolationnD(const std::vector<std::vector<double> > & dAxes,
+                                 const std::vector<double> & dValues,
                                  InterExtrapolationType eInterpolationType);
+            virtual ~InterExtrapolationnD();
+            
+            //  dPoint[d] : coordinate of the point in the dimension d
+            double InterpnD(const std::vector<double> & dPoint) const;
+            double InterpnD(Utilities::ArrayView<const double> dPoint) const;
+            //  Batched interpolation of the points dPoints[iPoint][d] : the interval of each dimension is searched from the one of the 
+            //  previous point (merge-walk on regular sweeps of the grid)
+            void InterpnD(Utilities::MatrixView<const double> dPoints, Utilities::ArrayView<double> dResults) const;
             
-            std::map<std::size_t, double> InterpnD(const std::map<size_t, double> & dValue);
+            std::size_t GetNbDimensions() const
+            {
+                return iNDimensions_;
+            }
+            
+            std::size_t GetNbValues() const
+            {
+                return iNValues_;
+            }
+            
+        protected:
+            InterExtrapolationType eInterpolationType_;
+            std::size_t iNDimensions_;
+            std::size_t iNValues_;
+            //  Pillars of each dimension (used to locate the points)
+            std::vector<InterExtrapolation1D> sAxes_;
+            //  Number of coefficients of a node : 1, or 2^D for SPLINE_CUBIC
+            std::size_t iNCoefficients_;
+            //  Distance between two consecutive nodes of each dimension in dCoefficients_
+            std::vector<std::size_t> iStrides_;
+            //  dCoefficients_[iNode * iNCoefficients_ + iSubset] : value of the node iNode differentiated twice along each dimension d of iSubset (bit d)
+            std::vector<double> dCoefficients_;
+            
+        private:
+            //  Interpolation of one point, iHints : intervals of the previous point in each dimension (updated)
+            double Evaluate(const double * dPoint, int * iHints) const;
         };
     }
 }
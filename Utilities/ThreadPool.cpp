@@ -0,0 +1,163 @@
+//
+//  ThreadPool.cpp
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#include <pthread.h>
+#include <unistd.h>
+#include <map>
+#include "ThreadPool.h"
+
+namespace Utilities {
+    
+    namespace {
+        
+        //  Shared pools, by number of threads, destroyed (and their workers joined) at the end of the program
+        class ThreadPools
+        {
+        public:
+            ~ThreadPools()
+            {
+                for (std::map<std::size_t, ThreadPool*>::iterator it = sPools_.begin() ; it != sPools_.end() ; ++it)
+                {
+                    delete it->second;
+                }
+            }
+            
+            std::map<std::size_t, ThreadPool*> sPools_;
+        };
+        
+        pthread_mutex_t sThreadPoolsMutex = PTHREAD_MUTEX_INITIALIZER;
+    }
+    
+    ThreadPool::ThreadPool(std::size_t iNThreads) : iNThreads_(iNThreads == 0 ? 1 : iNThreads), lGeneration_(0), pTask_(0), iNTasks_(0), iNRunningWorkers_(0), iNextTask_(0), iBusy_(0), bStop_(false)
+    {
+        pthread_mutex_init(&sMutex_, 0);
+        pthread_cond_init(&sWorkReady_, 0);
+        pthread_cond_init(&sWorkDone_, 0);
+        for (std::size_t iWorker = 1 ; iWorker < iNThreads_ ; ++iWorker)
+        {
+            pthread_t sThread;
+            if (pthread_create(&sThread, 0, &RunWorker, this) == 0)
+            {
+                sWorkers_.push_back(sThread);
+            }
+        }
+    }
+    
+    ThreadPool::~ThreadPool()
+    {
+        pthread_mutex_lock(&sMutex_);
+        bStop_ = true;
+        pthread_cond_broadcast(&sWorkReady_);
+        pthread_mutex_unlock(&sMutex_);
+        for (std::size_t iWorker = 0 ; iWorker < sWorkers_.size() ; ++iWorker)
+        {
+            pthread_join(sWorkers_[iWorker], 0);
+        }
+        pthread_cond_destroy(&sWorkDone_);
+        pthread_cond_destroy(&sWorkReady_);
+        pthread_mutex_destroy(&sMutex_);
+    }
+    
+    void * ThreadPool::RunWorker(void * pPool)
+    {
+        ThreadPool * pThreadPool = static_cast<ThreadPool*>(pPool);
+        unsigned long lGeneration = 0;
+        pthread_mutex_lock(&pThreadPool->sMutex_);
+        for (;;)
+        {
+            //  Wait for the next ParallelFor
+            while (!pThreadPool->bStop_ && pThreadPool->lGeneration_ == lGeneration)
+            {
+                pthread_cond_wait(&pThreadPool->sWorkReady_, &pThreadPool->sMutex_);
+            }
+            if (pThreadPool->bStop_)
+            {
+                break;
+            }
+            lGeneration = pThreadPool->lGeneration_;
+            pthread_mutex_unlock(&pThreadPool->sMutex_);
+            
+            pThreadPool->RunTasks();
+            
+            pthread_mutex_lock(&pThreadPool->sMutex_);
+            if (--pThreadPool->iNRunningWorkers_ == 0)
+            {
+                pthread_cond_signal(&pThreadPool->sWorkDone_);
+            }
+        }
+        pthread_mutex_unlock(&pThreadPool->sMutex_);
+        return 0;
+    }
+    
+    void ThreadPool::RunTasks()
+    {
+        for (;;)
+        {
+            std::size_t iTask = __sync_fetch_and_add(&iNextTask_, 1);
+            if (iTask >= iNTasks_)
+            {
+                break;
+            }
+            pTask_->Run(iTask);
+        }
+    }
+    
+    void ThreadPool::ParallelFor(std::size_t iNTasks, ParallelTask & sTask)
+    {
+        //  Pool already running a ParallelFor, no worker or a single task : everything in the calling thread
+        if (sWorkers_.empty() || iNTasks < 2 || __sync_lock_test_and_set(&iBusy_, 1))
+        {
+            for (std::size_t iTask = 0 ; iTask < iNTasks ; ++iTask)
+            {
+                sTask.Run(iTask);
+            }
+            return;
+        }
+        
+        pthread_mutex_lock(&sMutex_);
+        pTask_ = &sTask;
+        iNTasks_ = iNTasks;
+        iNextTask_ = 0;
+        iNRunningWorkers_ = sWorkers_.size();
+        ++lGeneration_;
+        pthread_cond_broadcast(&sWorkReady_);
+        pthread_mutex_unlock(&sMutex_);
+        
+        //  The calling thread works as well
+        RunTasks();
+        
+        pthread_mutex_lock(&sMutex_);
+        while (iNRunningWorkers_ > 0)
+        {
+            pthread_cond_wait(&sWorkDone_, &sMutex_);
+        }
+        pTask_ = 0;
+        pthread_mutex_unlock(&sMutex_);
+        __sync_lock_release(&iBusy_);
+    }
+    
+    std::size_t ThreadPool::GetNbCores()
+    {
+        long lNCores = sysconf(_SC_NPROCESSORS_ONLN);
+        return lNCores > 0 ? static_cast<std::size_t>(lNCores) : 1;
+    }
+    
+    ThreadPool & ThreadPool::GetThreadPool(std::size_t iNThreads)
+    {
+        static ThreadPools sThreadPools;
+        iNThreads = iNThreads == 0 ? 1 : iNThreads;
+        pthread_mutex_lock(&sThreadPoolsMutex);
+        ThreadPool *& pThreadPool = sThreadPools.sPools_[iNThreads];
+        if (!pThreadPool)
+        {
+            pThreadPool = new ThreadPool(iNThreads);
+        }
+        pthread_mutex_unlock(&sThreadPoolsMutex);
+        return *pThreadPool;
+    }
+}
@@ -0,0 +1,75 @@
+//
+//  ThreadPool.h
+//  Seminaire
+//
+//  Created by agent on 17/10/26.
+//  Copyright (c) 2026 __MyCompanyName__. All rights reserved.
+//
+
+#ifndef Seminaire_ThreadPool_h
+#define Seminaire_ThreadPool_h
+
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+
+namespace Utilities {
+    
+    //  A unit of work which can be run concurrently on independent task indices
+    class ParallelTask
+    {
+    public:
+        virtual ~ParallelTask()
+        {}
+        
+        //  Must only touch data owned by task iTask
+        virtual void Run(std::size_t iTask) = 0;
+    };
+    
+    //  Runs the tasks 0, ..., iNTasks - 1 of a ParallelTask on iNThreads threads (the calling thread included)
+    //  The iNThreads - 1 workers are created with the pool and wait for the next ParallelFor until the pool is destroyed
+    //  Tasks are handed out one by one so that the load is balanced whatever their duration
+    class ThreadPool
+    {
+    public:
+        ThreadPool(std::size_t iNThreads = 1);
+        virtual ~ThreadPool();
+        
+        //  A ParallelFor called while the pool is already running one (from a task for instance) runs its tasks in the calling thread
+        virtual void ParallelFor(std::size_t iNTasks, ParallelTask & sTask);
+        
+        std::size_t GetNbThreads() const
+        {
+            return iNThreads_;
+        }
+        
+        //  Number of cores available on the machine
+        static std::size_t GetNbCores();
+        
+        //  Pool of iNThreads threads shared by the whole program (created on the first call for this number of threads)
+        static ThreadPool & GetThreadPool(std::size_t iNThreads);
+        
+    private:
+        std::size_t iNThreads_;
+        std::vector<pthread_t> sWorkers_;
+        
+        //  Current ParallelFor : generation, task, next task index and number of workers still running it
+        pthread_mutex_t sMutex_;
+        pthread_cond_t sWorkReady_, sWorkDone_;
+        unsigned long lGeneration_;
+        ParallelTask * pTask_;
+        std::size_t iNTasks_, iNRunningWorkers_;
+        volatile std::size_t iNextTask_;
+        volatile int iBusy_;
+        bool bStop_;
+        
+        //  Not copyable
+        ThreadPool(const ThreadPool &);
+        ThreadPool & operator=(const ThreadPool &);
+        
+        static void * RunWorker(void * pPool);
+        void RunTasks();
+    };
+}
+
+#endif
@@ -18,12 +18,14 @@ namespace Utilities {
     template<class T>
     inline int FindInVector(const std::vector<T> & vect, T value, bool bSort = false)
     {
-        std::vector<T> copy = vect;
-        
         if (bSort)
         {
-            std::sort(copy.begin(), copy.end());
+            //  Only sort a copy when asked to
+            std::vector<T> sorted = vect;
+            std::sort(sorted.begin(), sorted.end());
+            return FindInVector(sorted, value, false);
         }
+        const std::vector<T> & copy = vect;
         for (std::size_t i = 0 ; i < copy.size() - 1 ; ++i)
         {
             if ((value >= copy[i]) && (value < copy[i + 1])) {
@@ -69,7 +71,7 @@ namespace Utilities {
         return PairOfVector;
     };
     
-    template<class T> bool IsFound(const std::vector<T> & vect, T & value, std::size_t * iWhere)
+    template<class T> bool IsFound(const std::vector<T> & vect, const T & value, std::size_t * iWhere)
     {
         //  Check if the value is in the vector
         for (std::size_t i = 0 ; i < vect.size(); ++i)